@@ -359,6 +359,10 @@ set(TVM_FFI_BACKTRACE_ON_SEGFAULT ON)
 # - /path/to/folder/containing/: Path to folder containing papi.pc.
 set(USE_PAPI OFF)
 
+# Whether to build the perf_event_open based performance counter collector.
+# It has no external dependencies and is only built on Linux.
+set(USE_PERF_EVENT ON)
+
 # Whether to use GoogleTest for C++ unit tests. When enabled, the generated
 # build file (e.g. Makefile) will have a target "cpptest".
 # Possible values:
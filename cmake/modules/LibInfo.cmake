@@ -100,6 +100,7 @@ function(add_lib_info src_file)
     TVM_INFO_USE_OPENCL_GTEST="${USE_OPENCL_GTEST}"
     TVM_INFO_USE_OPENMP="${USE_OPENMP}"
     TVM_INFO_USE_PAPI="${USE_PAPI}"
+    TVM_INFO_USE_PERF_EVENT="${USE_PERF_EVENT}"
     TVM_INFO_USE_RANDOM="${USE_RANDOM}"
     TVM_INFO_TVM_DEBUG_WITH_ABI_CHANGE="${TVM_DEBUG_WITH_ABI_CHANGE}"
     TVM_INFO_TVM_LOG_BEFORE_THROW="${TVM_LOG_BEFORE_THROW}"
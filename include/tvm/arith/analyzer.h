@@ -512,6 +512,13 @@ class TransitiveComparisonAnalyzer {
    */
   TVM_DLL void Bind(const Var& var, const Range& range, bool allow_override = false);
 
+  /*! \brief Get the range that a variable is bound to
+   *
+   * \param var The variable of interest.
+   * \return The bound range, or std::nullopt if the variable is not bound.
+   */
+  TVM_DLL Optional<Range> GetBinding(const Var& var) const;
+
   /*!
    * \brief Update the internal state to enter constraint.
    * \param constraint A constraint expression.
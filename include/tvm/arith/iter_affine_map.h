@@ -54,6 +54,8 @@
 #include <tvm/ir/expr.h>
 #include <tvm/tir/var.h>
 
+#include <vector>
+
 namespace tvm {
 namespace arith {
 
@@ -314,6 +316,30 @@ IterMapResult DetectIterMap(const Array<PrimExpr>& indices, const Map<Var, Range
                             const PrimExpr& predicate, IterMapLevel check_level,
                             arith::Analyzer* analyzer, bool simplify_trivial_iterators = true);
 
+/*!
+ * \brief Detect the iter maps of a batch of index tuples over the same input iterators and
+ * predicate, as DetectIterMap does for each of them.
+ *
+ * The parsing and normalization of the input iterators and the predicate constraints are
+ * shared by the whole batch, and the identical index tuples are only detected once.
+ *
+ * \param indices_batch The index tuples to detect pattern for.
+ * \param input_iters Map from variable to iterator's range.
+ * \param predicate The predicate constraints on the input iterators
+ * \param check_level The iter mapping checking level.
+ * \param analyzer Analyzer used to get context information.
+ * \param simplify_trivial_iterators If true, iterators with extent of
+ *           1 will be replaced with a constant value.
+ *
+ * \return The detected iteration results of the index tuples, in the same order.
+ * \sa DetectIterMap
+ */
+std::vector<IterMapResult> DetectIterMapBatch(const Array<Array<PrimExpr>>& indices_batch,
+                                              const Map<Var, Range>& input_iters,
+                                              const PrimExpr& predicate, IterMapLevel check_level,
+                                              arith::Analyzer* analyzer,
+                                              bool simplify_trivial_iterators = true);
+
 /*!
  * \brief Use IterVarMap detector to rewrite and simplify the indices
  *
@@ -29,6 +29,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -101,6 +102,12 @@ class NameSupplyNode : public Object {
 
   /*! \brief A map that is used to generate unique names. */
   std::unordered_map<std::string, int> name_map;
+
+  /*!
+   * \brief Guards name_map, so a NameSupply can be shared by passes that
+   *  process several functions concurrently.
+   */
+  std::mutex name_map_mutex;
 };
 
 /*!
@@ -65,6 +65,7 @@
 #include <tvm/ir/module.h>
 #include <tvm/support/with.h>
 
+#include <functional>
 #include <string>
 #include <utility>
 
@@ -556,6 +557,35 @@ TVM_DLL Pass CreateModulePass(std::function<IRModule(IRModule, PassContext)> pas
 TVM_DLL Pass ApplyPassToFunction(Pass pass, String func_name_regex,
                                  bool error_if_no_function_matches_regex = false);
 
+/*!
+ * \brief Get the number of threads that function-level passes may use to
+ *  process the functions of a module concurrently.
+ *
+ * Controlled by the "ir.num_function_pass_threads" config option.  The
+ * default of 1 processes the functions sequentially; 0 or a negative value
+ * uses one thread per hardware core.
+ *
+ * \param pass_ctx The pass context.
+ * \return The number of threads, at least 1.
+ */
+TVM_DLL int GetFunctionPassNumThreads(const PassContext& pass_ctx);
+
+/*!
+ * \brief Run `ftask(i)` for every i in [0, num_tasks) on up to `num_threads` threads.
+ *
+ * Worker threads see `pass_ctx` and the caller's current Target as current,
+ * without re-running the pass instruments.  If tasks throw, the exception of
+ * the task with the smallest index is rethrown after all tasks finished, so
+ * the reported error does not depend on scheduling.
+ *
+ * \param pass_ctx The pass context the tasks run under.
+ * \param num_threads The maximum number of threads to use.
+ * \param num_tasks The number of tasks.
+ * \param ftask The task, must be safe to run concurrently for different indices.
+ */
+TVM_DLL void RunFunctionPassTasks(const PassContext& pass_ctx, int num_threads, int num_tasks,
+                                  const std::function<void(int)>& ftask);
+
 /*!
  * \brief A special trace pass that prints the header and IR to LOG(INFO).
  * \param header The header to be attached to the output.
@@ -264,6 +264,18 @@ class DatabaseNode : public runtime::Object {
    */
   virtual Optional<IRModule> QueryIRModule(const IRModule& mod, const Target& target,
                                            const String& workload_name);
+  /*!
+   * \brief Query the best records of the tuned workloads nearest to the given workload, measured
+   * by the distance of their workload embeddings. Only the workloads with the same kind of anchor
+   * block are comparable, and their traces can be transferred to the given workload.
+   * \param mod The IRModule to be searched for.
+   * \param target The target to be searched for.
+   * \param top_k The maximum number of the nearest workloads.
+   * \return The best record of each nearest workload, from the nearest to the farthest. The
+   * workload equal to the given IRModule is excluded.
+   */
+  Array<TuningRecord> QueryNearestTuningRecords(const IRModule& mod, const Target& target,
+                                                int top_k);
   /*!
    * \brief Prune the database and dump it a given database.
    * \param destination The destination database to be dumped to.
@@ -487,6 +499,16 @@ class Database : public runtime::ObjectRef {
    */
   TVM_DLL static Database JSONDatabase(String path_workload, String path_tuning_record,
                                        bool allow_missing, String mod_eq_name = "structural");
+  /*!
+   * \brief Create a database shared by multiple local processes, which uses the same files as
+   * JSONDatabase and synchronizes the commits and the queries of the processes by file locks.
+   * \param path_workload The path to the workload table.
+   * \param path_tuning_record The path to the database table.
+   * \param num_shards The number of shards of the tuning records kept in memory.
+   * \param mod_eq_name A string to specify the module equality testing and hashing method.
+   */
+  TVM_DLL static Database SharedDatabase(String path_workload, String path_tuning_record,
+                                         int num_shards, String mod_eq_name = "structural");
   /*!
    * \brief A database composed of multiple databases, allowing users to guide IR rewriting using
    * combined knowledge of those databases. To each query, it returns the best record among all the
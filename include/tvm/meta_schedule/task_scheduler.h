@@ -272,10 +272,15 @@ class TaskScheduler : public runtime::ObjectRef {
    * \param logger The tuning task's logging function.
    * \param alpha The parameter alpha to control gradient computation.
    * \param window_size The parameter to control backward window size.
+   * \param plateau_rounds The number of rounds over which a task is checked for convergence, zero
+   * to disable the check.
+   * \param plateau_threshold The relative improvement of the best latency within
+   * `plateau_rounds` rounds, below which a task converges and stops.
    * \param seed The random seed.
    * \return The task scheduler created.
    */
   TVM_DLL static TaskScheduler GradientBased(ffi::Function logger, double alpha, int window_size,
+                                             int plateau_rounds, double plateau_threshold,
                                              support::LinearCongruentialEngine::TRandState seed);
   /*!
    * \brief Create a task scheduler with customized methods on the python-side.
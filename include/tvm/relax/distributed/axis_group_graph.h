@@ -397,6 +397,30 @@ class AxisGroupGraph {
     }
   }
 
+  /*!
+   * \brief Get the axes connected with the given axis. Without cut points, a sharding spec
+   * on any of them propagates to all the others.
+   *
+   * \param axis the specified axis
+   * \return the connected axes in breadth-first order, starting with the given axis
+   */
+  std::vector<Axis> GetAxisGroup(Axis axis) const {
+    std::vector<Axis> group{axis};
+    std::unordered_set<Axis, AxisHash> visited{axis};
+    for (size_t i = 0; i < group.size(); i++) {
+      auto it = graph_.find(group[i]);
+      if (it == graph_.end()) {
+        continue;
+      }
+      for (const auto& edge : it->second) {
+        if (visited.insert(edge.dst).second) {
+          group.push_back(edge.dst);
+        }
+      }
+    }
+    return group;
+  }
+
  private:
   void AddEdge(Axis src, Axis dst, EdgeType type) {
     if (!graph_.count(src)) {
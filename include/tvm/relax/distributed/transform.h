@@ -26,6 +26,7 @@
 
 #include <tvm/ir/transform.h>
 #include <tvm/relax/dataflow_pattern.h>
+#include <tvm/relax/distributed/global_info.h>
 #include <tvm/relax/expr.h>
 #include <tvm/relax/transform.h>
 #include <tvm/tir/function.h>
@@ -50,6 +51,19 @@ using tvm::transform::CreateModulePass;
  */
 TVM_DLL Pass PropagateSharding();
 
+/*!
+ * \brief Search the sharding of a function on a device mesh and annotate it with
+ * relax.dist.annotate_sharding, for PropagateSharding to consume.
+ *
+ * \param device_mesh The device mesh to shard the function on.
+ * \param memory_limit The memory available on each device in bytes, or -1 if unlimited.
+ * \param bandwidth The bandwidth of the collective communication in bytes per second.
+ * \param peak_flops The peak compute throughput of each device in flops per second.
+ * \return The Pass.
+ */
+TVM_DLL Pass AutoSharding(DeviceMesh device_mesh, int64_t memory_limit, double bandwidth,
+                          double peak_flops);
+
 /*!
  * \brief Lower global view TensorIR into local view.
  *
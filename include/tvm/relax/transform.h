@@ -506,6 +506,22 @@ class PatternCheckContext : public ObjectRef {
 TVM_DLL Pass Gradient(String func_name, Optional<Array<Var>> require_grads = std::nullopt,
                       int target_index = 0);
 
+/*!
+ * \brief Automatic checkpointing for the Gradient pass.
+ *
+ * The forward activations that the backward pass of Gradient uses are kept alive until the
+ * backward pass. This pass chooses the activations to recompute in the backward pass instead,
+ * preferring the ones with fewer recomputation FLOPs per byte, until the memory of the kept
+ * activations fits in the budget. The choice is expressed with start_checkpoint and
+ * end_checkpoint in the specified function, which Gradient then handles.
+ *
+ * \param func_name The name of the function to be differentiated later.
+ * \param memory_budget The budget in bytes of the activations kept for the backward pass.
+ * \param target_index The index of the differentiation target, the same as in Gradient.
+ * \return The Pass.
+ */
+TVM_DLL Pass AutoCheckpoint(String func_name, int64_t memory_budget, int target_index = 0);
+
 /*!
  * \brief Apply pattern matching to each function in the given module, and group matched
  * expressions into a new function. The end result is similar to FuseOps, but fusion is driven
@@ -547,6 +563,19 @@ TVM_DLL Pass MergeCompositeFunctions();
  */
 TVM_DLL Pass FuseTIR();
 
+/*!
+ * \brief Pack the independent small call_tir of each dataflow block into horizontally fused
+ * PrimFuncs, to reduce the number of kernel launches. The kernels packed together are of the
+ * same dependency level in the block, and each iteration of the outermost parallel loop of the
+ * fused PrimFunc runs one of them.
+ * \param max_num_elements The maximal number of output elements of a kernel to be packed.
+ * \param max_group_size The maximal number of kernels packed into one PrimFunc.
+ * \return The Pass.
+ * \note Only the unscheduled PrimFuncs with static shapes are packed, and the pass does nothing
+ * when the current target is not a CPU target.
+ */
+TVM_DLL Pass HorizontalFuseTIR(int64_t max_num_elements, int max_group_size);
+
 /*!
  * \brief Run codegen.
  * \param target_options pairs of target name and compilation options
@@ -603,6 +632,18 @@ TVM_DLL Pass AlterOpImpl(const Map<String, tir::PrimFunc>& op_impl_map,
  */
 TVM_DLL Pass ConvertLayout(Map<String, Array<String>> desired_layouts);
 
+/*!
+ * \brief Layout selection pass. For each call of the given operators, choose among the
+ * candidate layouts and the original layout so that the estimated time of the kernels and
+ * the inserted layout transforms is minimal over the dataflow block. The tuning records in
+ * the current MetaSchedule database are used for the kernel time when present.
+ * \param candidate_layouts The candidate layouts of each operator, each of which is in the
+ * same format as the desired layouts of ConvertLayout.
+ * \return The Pass.
+ * \note Operates only on dataflow blocks. ConvertToDataflow may need to be called first.
+ */
+TVM_DLL Pass SelectLayout(Map<String, Array<Array<String>>> candidate_layouts);
+
 /*!
  * \brief A pass that converts consecutive dataflow operations
  *   inside binding blocks into dataflow blocks.
@@ -0,0 +1,51 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \brief Performance counters for profiling via the Linux perf_event_open interface.
+ */
+#ifndef TVM_RUNTIME_CONTRIB_PERF_EVENT_H_
+#define TVM_RUNTIME_CONTRIB_PERF_EVENT_H_
+
+#include <tvm/ffi/container/array.h>
+#include <tvm/runtime/profiling.h>
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+/*! \brief Construct a metric collector that collects data from hardware
+ * performance counters using the Linux `perf_event_open` system call.
+ *
+ * Unlike the PAPI collector, this collector has no external dependencies. It
+ * only supports CPU devices.
+ *
+ * \param metrics The names of the counters to collect. Valid names are
+ * "cycles", "instructions", "ref-cycles", "cache-references", "cache-misses",
+ * "branch-instructions", "branch-misses", "stalled-cycles-frontend",
+ * "stalled-cycles-backend", "L1-dcache-loads", "L1-dcache-load-misses",
+ * "LLC-loads" and "LLC-load-misses". If empty, "cycles", "instructions",
+ * "cache-misses" and "branch-misses" are collected. Whenever both "cycles" and
+ * "instructions" are collected, the derived metric "IPC" is reported as well.
+ */
+TVM_DLL MetricCollector CreatePerfEventMetricCollector(Array<String> metrics);
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_CONTRIB_PERF_EVENT_H_
@@ -107,6 +107,18 @@ class TraceNode : public runtime::Object {
    */
   void ApplyToSchedule(Schedule sch, bool remove_postproc,
                        FTraceDecisionProvider decision_provider = nullptr) const;
+  /*!
+   * \brief Apply the instructions in `[begin, end)` of the trace to a traced TensorIR schedule,
+   * to which the instructions before `begin` have been applied, i.e. the first `begin`
+   * instructions of the schedule's trace correspond one by one to those of this trace
+   * \param sch The traced schedule to be applied onto
+   * \param begin The index of the first instruction to be applied
+   * \param end The index after the last instruction to be applied
+   * \note The random variables of this trace are mapped to those of the schedule through the
+   * outputs of the corresponding instructions, so that a replay can be resumed on a copy of a
+   * schedule that another trace with the same prefix has been applied to
+   */
+  void ApplyRangeToSchedule(Schedule sch, int begin, int end) const;
   /*!
    * \brief Serialize the trace as a JSON-style object
    * \param remove_postproc If postprocessing instructions are removed
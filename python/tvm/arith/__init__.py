@@ -24,13 +24,21 @@ from .int_set import (
     estimate_region_strict_bound,
     estimate_region_upper_bound,
 )
-from .analyzer import ModularSet, ConstIntBound, Analyzer, ProofStrength, Extension
+from .analyzer import (
+    ModularSet,
+    ConstIntBound,
+    Analyzer,
+    ProofStrength,
+    Extension,
+    SimplifyMemo,
+)
 from .bound import deduce_bound
 from .pattern import detect_linear_equation, detect_clip_bound, detect_common_subexpr
 from .int_solver import solve_linear_equations, solve_linear_inequalities
 from .iter_affine_map import IterMapExpr, IterMark, IterSplitExpr, IterSumExpr
 from .iter_affine_map import (
     detect_iter_map,
+    detect_iter_map_batch,
     iter_map_simplify,
     normalize_iter_map_to_expr,
     normalize_to_iter_sum,
@@ -75,6 +75,46 @@ class ConstIntBound(Object):
         self.__init_handle_by_constructor__(_ffi_api.ConstIntBound, min_value, max_value)
 
 
+@tvm.ffi.register_object("arith.SimplifyMemo")
+class SimplifyMemo(Object):
+    """A bounded memo of the simplification results, shared by all the analyzers created
+    under a PassContext with the config ``"arith.simplify_memo"``.
+
+    An entry is keyed by the expression together with the constraints entered and the known
+    information of the variables involved, so that a result is only reused under the same
+    context.
+
+    Parameters
+    ----------
+    max_size : int
+        The maximum number of entries, beyond which the oldest entries are evicted.
+
+    Examples
+    --------
+    .. code-block:: python
+
+        memo = tvm.arith.SimplifyMemo()
+        with tvm.transform.PassContext(config={"arith.simplify_memo": memo}):
+            mod = tvm.tir.transform.Simplify()(mod)
+        print(memo.hit_rate, memo.saved_seconds)
+    """
+
+    def __init__(self, max_size: int = 65536):
+        self.__init_handle_by_constructor__(_ffi_api.SimplifyMemo, max_size)
+
+    @property
+    def hit_rate(self) -> float:
+        """The fraction of the lookups that found the result."""
+        return self.num_hits / self.num_lookups if self.num_lookups else 0.0
+
+    def clear(self) -> None:
+        """Remove all the entries and reset the statistics."""
+        _ffi_api.SimplifyMemoClear(self)
+
+    def __len__(self) -> int:
+        return _ffi_api.SimplifyMemoSize(self)
+
+
 class ConstraintScope:
     """Constraint scope.
 
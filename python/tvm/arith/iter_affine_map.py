@@ -156,6 +156,52 @@ def detect_iter_map(
     )
 
 
+def detect_iter_map_batch(
+    indices_batch,
+    input_iters,
+    predicate=True,
+    check_level=IterMapLevel.Surjective,
+    simplify_trivial_iterators=True,
+):
+    """Detect the iter maps of a batch of index tuples over the same input iters, as
+    detect_iter_map does for each of them. The normalization of the input iters and the
+    predicate is shared by the whole batch, and identical index tuples are detected once.
+
+    Parameters
+    ----------
+    indices_batch : List[List[PrimExpr]]
+        The index tuples
+
+    input_iters : Map[Var, Range]
+        The domain of each input iterators.
+
+    predicate : PrimExpr
+        The predicate constraints on the input iterators
+
+    check_level : Union[str, IterMapLevel]
+        Checking level of iteration mapping
+
+    simplify_trivial_iterators: bool
+        If true, iterators with extent of 1 will be replaced with a
+        constant value.
+
+    Returns
+    -------
+    results : List[IterMapResult]
+        The iter map matching results of the index tuples, in the same order.
+
+    """
+    if isinstance(check_level, str):
+        check_level = IterMapLevel.from_str(check_level)
+    elif check_level is None:
+        check_level = IterMapLevel.NoCheck
+    return list(
+        _ffi_api.DetectIterMapBatch(
+            indices_batch, input_iters, predicate, check_level, simplify_trivial_iterators
+        )
+    )
+
+
 def normalize_to_iter_sum(index, input_iters):
     """Normalize expr to iter sum.
 
@@ -74,6 +74,7 @@ def compile(  # pylint: disable=redefined-builtin
     *,
     relax_pipeline: Optional[Union[tvm.transform.Pass, Callable, str]] = "default",
     tir_pipeline: Optional[Union[tvm.transform.Pass, Callable, str]] = "default",
+    build_cache: Optional["tvm.relax.FunctionBuildCache"] = None,
 ) -> Executable:
     """
     Compile an IRModule to a runtime executable.
@@ -93,6 +94,9 @@ def compile(  # pylint: disable=redefined-builtin
         Only used if the module contains Relax functions.
     tir_pipeline : Optional[Union[tvm.transform.Pass, Callable, str]]
         The compilation pipeline to use for TIR functions.
+    build_cache : Optional[tvm.relax.FunctionBuildCache]
+        The cache of the compiled TIR functions to reuse across the compilations.
+        Only used if the module contains Relax functions.
 
     Returns
     -------
@@ -106,6 +110,7 @@ def compile(  # pylint: disable=redefined-builtin
             target,
             relax_pipeline=relax_pipeline,
             tir_pipeline=tir_pipeline,
+            build_cache=build_cache,
         )
     lib = tvm.tir.build(mod, target, pipeline=tir_pipeline)
     return Executable(lib)
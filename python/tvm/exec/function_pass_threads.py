@@ -0,0 +1,104 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A script to measure the time of lowering a module with many PrimFuncs through the default TIR
+pipeline, for each value of the "ir.num_function_pass_threads" config option"""
+import argparse
+import time
+
+import numpy as np
+
+import tvm
+from tvm import te, tir
+
+
+def _parse_args() -> argparse.Namespace:
+    def _parse_list_int(source: str):
+        return [int(i) for i in source.split(",")]
+
+    parser = argparse.ArgumentParser(
+        prog="Function pass threads testing",
+        description="""Example:
+    python -m tvm.exec.function_pass_threads --num_funcs 256 --threads "1,2,4,8"
+""",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+    )
+    parser.add_argument(
+        "--num_funcs",
+        type=int,
+        default=256,
+        help="The number of PrimFuncs in the module",
+    )
+    parser.add_argument(
+        "--threads",
+        type=_parse_list_int,
+        default=[1, 2, 4, 8],
+        help="The values of ir.num_function_pass_threads to measure, the speedup is relative "
+        "to the first one, and 0 uses one thread per core",
+    )
+    parser.add_argument(
+        "--target",
+        type=str,
+        default="llvm",
+        help="The target to lower the module for",
+    )
+    parser.add_argument(
+        "--repeat",
+        type=int,
+        default=3,
+        help="The number of lowerings to measure for each value",
+    )
+    return parser.parse_args()
+
+
+def _make_module(num_funcs: int) -> tvm.IRModule:
+    funcs = {}
+    for i in range(num_funcs):
+        n = 16 + 8 * (i % 16)
+        a = te.placeholder((n, n), name="A")
+        b = te.placeholder((n, n), name="B")
+        k = te.reduce_axis((0, n), name="k")
+        c = te.compute((n, n), lambda x, y: te.sum(a[x, k] * b[k, y], axis=k), name="C")
+        d = te.compute((n, n), lambda x, y: te.max(c[x, y], tvm.tir.const(0, "float32")), name="D")
+        name = f"func_{i}"
+        funcs[name] = te.create_prim_func([a, b, d]).with_attr("global_symbol", name)
+    return tvm.IRModule(funcs)
+
+
+def main():
+    """Entry point"""
+    args = _parse_args()
+    mod = _make_module(args.num_funcs)
+    pipeline = tir.get_tir_pipeline("default")
+    print(f"num_funcs: {args.num_funcs}, target: {args.target}")
+    baseline = None
+    for num_threads in args.threads:
+        config = {"ir.num_function_pass_threads": num_threads}
+        costs = []
+        for _ in range(args.repeat):
+            with tvm.target.Target(args.target), tvm.transform.PassContext(config=config):
+                tic = time.perf_counter()
+                pipeline(mod)
+                costs.append(time.perf_counter() - tic)
+        cost = float(np.median(costs))
+        if baseline is None:
+            baseline = cost
+        speedup = baseline / cost
+        print(f"threads: {num_threads:3d}, time: {cost * 1000:10.2f} ms, speedup: {speedup:6.2f}x")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,141 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A script to measure the bandwidth of copying arrays to an RPC server over loopback, with a
+simulated network latency, for each window of the pipelined copy"""
+import argparse
+import queue
+import socket
+import threading
+import time
+
+import numpy as np
+
+import tvm
+from tvm import rpc
+
+
+def _parse_args() -> argparse.Namespace:
+    def _parse_list_int(source: str):
+        return [int(i) for i in source.split(",")]
+
+    parser = argparse.ArgumentParser(
+        prog="RPC copy bandwidth testing",
+        description="""Example:
+    python -m tvm.exec.rpc_copy_bandwidth --latency_ms 20 --nbytes 67108864 \\
+        --block_bytes 4194304 --window "1,2,4,8,16"
+""",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+    )
+    parser.add_argument(
+        "--latency_ms",
+        type=float,
+        default=20.0,
+        help="The simulated one-way latency of the link in milliseconds",
+    )
+    parser.add_argument(
+        "--nbytes",
+        type=int,
+        default=64 << 20,
+        help="The number of bytes to copy",
+    )
+    parser.add_argument(
+        "--block_bytes",
+        type=int,
+        default=4 << 20,
+        help="The number of bytes per block of the pipelined copy",
+    )
+    parser.add_argument(
+        "--window",
+        type=_parse_list_int,
+        default=[1, 2, 4, 8, 16],
+        help="The windows of the pipelined copy to measure, 1 disables pipelining",
+    )
+    parser.add_argument(
+        "--repeat",
+        type=int,
+        default=3,
+        help="The number of copies to measure for each window",
+    )
+    return parser.parse_args()
+
+
+class _LatencyProxy:
+    """A TCP proxy on loopback, which delays the data forwarded in each direction"""
+
+    def __init__(self, server_port: int, latency_sec: float):
+        self.server_port = server_port
+        self.latency_sec = latency_sec
+        self.listener = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self.listener.bind(("127.0.0.1", 0))
+        self.listener.listen(1)
+        self.port = self.listener.getsockname()[1]
+        threading.Thread(target=self._accept, daemon=True).start()
+
+    def _accept(self):
+        while True:
+            client, _ = self.listener.accept()
+            server = socket.create_connection(("127.0.0.1", self.server_port))
+            for src, dst in [(client, server), (server, client)]:
+                chunks: queue.Queue = queue.Queue()
+                threading.Thread(target=self._recv, args=(src, chunks), daemon=True).start()
+                threading.Thread(target=self._send, args=(dst, chunks), daemon=True).start()
+
+    def _recv(self, src: socket.socket, chunks: queue.Queue):
+        while True:
+            data = src.recv(1 << 20)
+            chunks.put((time.perf_counter() + self.latency_sec, data))
+            if not data:
+                return
+
+    @staticmethod
+    def _send(dst: socket.socket, chunks: queue.Queue):
+        while True:
+            deadline, data = chunks.get()
+            delay = deadline - time.perf_counter()
+            if delay > 0:
+                time.sleep(delay)
+            if not data:
+                dst.close()
+                return
+            dst.sendall(data)
+
+
+def main():
+    """Entry point"""
+    args = _parse_args()
+    server = rpc.Server(host="127.0.0.1")
+    proxy = _LatencyProxy(server.port, args.latency_ms / 1000.0)
+    remote = rpc.connect("127.0.0.1", proxy.port)
+    dev = remote.cpu(0)
+    a_np = np.random.uniform(size=(args.nbytes // 4,)).astype("float32")
+    a = tvm.nd.empty(a_np.shape, "float32", dev)
+    print(f"latency: {args.latency_ms} ms, nbytes: {args.nbytes}, block: {args.block_bytes}")
+    for window in args.window:
+        remote.set_copy_pipeline(args.block_bytes, window)
+        costs = []
+        for _ in range(args.repeat):
+            tic = time.perf_counter()
+            a.copyfrom(a_np)
+            costs.append(time.perf_counter() - tic)
+        cost = float(np.median(costs))
+        bandwidth = args.nbytes / cost / 1e6
+        print(f"window: {window:3d}, time: {cost * 1000:10.2f} ms, MB/s: {bandwidth:10.2f}")
+    np.testing.assert_equal(a.numpy(), a_np)
+
+
+if __name__ == "__main__":
+    main()
@@ -15,7 +15,7 @@
 # specific language governing permissions and limitations
 # under the License.
 """TuningRecord database"""
-from typing import Any, Callable, List, Optional, Union
+from typing import Any, Callable, Dict, List, Optional, Union
 
 # isort: off
 from typing_extensions import Literal
@@ -141,6 +141,18 @@ class TuningRecord(Object):
         """
         return _json_de_tvm(_ffi_api.TuningRecordAsJSON(self))  # type: ignore # pylint: disable=no-member
 
+    def run_secs_statistics(self) -> Dict[str, float]:
+        """Get the statistics of the running time samples of the tuning record.
+
+        Returns
+        -------
+        statistics : Dict[str, float]
+            The number of samples "count", the "median", the 10th and 90th percentiles "p10" and
+            "p90", and the sample "variance" of the running time in seconds.
+        """
+        stats = _ffi_api.TuningRecordRunSecsStatistics(self)  # type: ignore # pylint: disable=no-member
+        return {str(key): float(value.value) for key, value in stats.items()}
+
     @staticmethod
     def from_json(json_obj: Any, workload: Workload) -> "TuningRecord":
         """Create a tuning record from a json object.
@@ -164,7 +176,7 @@ class TuningRecord(Object):
 class Database(Object):
     """The abstract database interface."""
 
-    DatabaseType = Union["Database", Literal["json", "memory"]]
+    DatabaseType = Union["Database", Literal["json", "memory", "shared"]]
 
     def has_workload(self, mod: IRModule) -> bool:
         """Check if the database has the given workload.
@@ -313,6 +325,34 @@ class Database(Object):
         """
         return _ffi_api.DatabaseQueryIRModule(self, mod, target, workload_name)  # type: ignore # pylint: disable=no-member
 
+    def query_nearest_tuning_records(
+        self,
+        mod: IRModule,
+        target: Target,
+        top_k: int,
+    ) -> List[TuningRecord]:
+        """Query the best records of the tuned workloads nearest to the given workload, measured by
+        the distance of their workload embeddings. Only the workloads with the same kind of anchor
+        block are comparable, and their traces can be transferred to the given workload with
+        `tvm.meta_schedule.trace_apply.schedule_using_anchor_trace`.
+
+        Parameters
+        ----------
+        mod : IRModule
+            The IRModule to be searched for.
+        target : Target
+            The target to be searched for.
+        top_k : int
+            The maximum number of the nearest workloads.
+
+        Returns
+        -------
+        records : List[TuningRecord]
+            The best record of each nearest workload, from the nearest to the farthest, excluding
+            the workload equal to the given IRModule.
+        """
+        return _ffi_api.DatabaseQueryNearestTuningRecords(self, mod, target, top_k)  # type: ignore # pylint: disable=no-member
+
     def dump_pruned(self, destination: "Database") -> None:
         """Dump the pruned database to files of JSONDatabase format.
 
@@ -381,6 +421,7 @@ class Database(Object):
             Literal[
                 "json",
                 "memory",
+                "shared",
                 "union",
                 "ordered_union",
             ],
@@ -393,10 +434,10 @@ class Database(Object):
 
         Parameters
         ----------
-        kind : str = "json" | "memory" | "union" | "ordered_union" | Callable[[tvm.tir.Schedule],
-        bool]
+        kind : str = "json" | "memory" | "shared" | "union" | "ordered_union" |
+        Callable[[tvm.tir.Schedule], bool]
             The kind of the database to be created. The following kinds are supported:
-            "json", "memory", "union", "ordered_union", and a custom schedule function.
+            "json", "memory", "shared", "union", "ordered_union", and a custom schedule function.
 
         Returns
         -------
@@ -408,6 +449,7 @@ class Database(Object):
             MemoryDatabase,
             OrderedUnionDatabase,
             ScheduleFnDatabase,
+            SharedDatabase,
             UnionDatabase,
         )
 
@@ -417,6 +459,8 @@ class Database(Object):
             return JSONDatabase(*args, **kwargs)
         if kind == "memory":
             return MemoryDatabase(*args, **kwargs)  # type: ignore
+        if kind == "shared":
+            return SharedDatabase(*args, **kwargs)  # type: ignore
         if kind == "union":
             return UnionDatabase(*args, **kwargs)  # type: ignore
         if kind == "ordered_union":
@@ -16,6 +16,7 @@
 # under the License.
 """Meta schedule integration with high-level IR"""
 from typing import TYPE_CHECKING, Dict, List, Optional, Tuple, Union
+import time
 import warnings
 
 # isort: off
@@ -34,7 +35,7 @@ from .builder import Builder
 from .cost_model import CostModel
 from .database import Database
 from .extracted_task import ExtractedTask
-from .logging import get_loggers_from_work_dir
+from .logging import get_logger, get_loggers_from_work_dir
 from .measure_callback import MeasureCallback
 from .runner import Runner
 from .search_strategy import SearchStrategy
@@ -245,6 +246,18 @@ def tune_relax(
                 if op_name in task.task_name:
                     selected_tasks.append(task)
 
+    num_funcs = sum(len(task.dispatched) for task in selected_tasks)
+    num_grouped = num_funcs - len(selected_tasks)
+    get_logger(__name__).info(
+        "Extracted %d tasks from %d distinct functions with the %s equality. "
+        "%d functions are grouped into other tasks and are not tuned separately; "
+        "tuning them separately would add at most %d trials.",
+        len(selected_tasks),
+        num_funcs,
+        module_equality,
+        num_grouped,
+        num_grouped * (max_trials_per_task or max_trials_global),
+    )
     tasks, task_weights = extracted_tasks_to_tune_contexts(
         extracted_tasks=selected_tasks,
         work_dir=work_dir,
@@ -252,7 +265,8 @@ def tune_relax(
         strategy=strategy,
         seed=seed,
     )
-    return tune_tasks(
+    tuning_start = time.perf_counter()
+    tuned_database = tune_tasks(
         tasks=tasks,
         task_weights=task_weights,
         work_dir=work_dir,
@@ -267,6 +281,13 @@ def tune_relax(
         task_scheduler=task_scheduler,
         module_equality=module_equality,
     )
+    if tasks:
+        get_logger(__name__).info(
+            "Tuned %d tasks in %.2f seconds on average per task.",
+            len(tasks),
+            (time.perf_counter() - tuning_start) / len(tasks),
+        )
+    return tuned_database
 
 
 @register_func("tvm.meta_schedule.tune_relax")
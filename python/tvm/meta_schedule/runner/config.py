@@ -41,6 +41,14 @@ class EvaluatorConfig(NamedTuple):
         increase the number of runs to the given time (in ms) to reduce the measurement error.
     enable_cpu_cache_flush: bool
         Whether to flush the cache on CPU.
+    max_repeat: int
+        The maximum number of costs to measure adaptively. If it is larger than the number of
+        costs of the first measurement, the measurement is repeated until the 95% confidence
+        interval of the mean cost is within `ci_tolerance` relative to the median cost, or
+        `max_repeat` costs are measured. Zero disables the adaptive measurement.
+    ci_tolerance: float
+        The relative half-width of the 95% confidence interval of the mean cost, under which the
+        adaptive measurement stops.
 
     Note
     ----
@@ -52,6 +60,8 @@ class EvaluatorConfig(NamedTuple):
     repeat: int = 1
     min_repeat_ms: int = 100
     enable_cpu_cache_flush: bool = False
+    max_repeat: int = 0
+    ci_tolerance: float = 0.05
 
     @staticmethod
     def _normalized(config: Optional["EvaluatorConfig"]) -> "EvaluatorConfig":
@@ -62,7 +72,13 @@ class EvaluatorConfig(NamedTuple):
             repeat=config.repeat,
             min_repeat_ms=config.min_repeat_ms,
             enable_cpu_cache_flush=config.enable_cpu_cache_flush,
+            max_repeat=config.max_repeat,
+            ci_tolerance=config.ci_tolerance,
         )
+        if config.max_repeat < 0:
+            raise ValueError(f"EvaluatorConfig.max_repeat is negative: {config.max_repeat}")
+        if config.ci_tolerance <= 0:
+            raise ValueError(f"EvaluatorConfig.ci_tolerance is not positive: {config.ci_tolerance}")
         return config
 
 
@@ -16,6 +16,8 @@
 # under the License.
 """Runner utility functions"""
 import itertools
+import math
+import statistics
 from typing import Any, Callable, Dict, List
 
 from ...runtime import Device, Module, ndarray
@@ -117,4 +119,23 @@ def run_evaluator_common(
         profile_result = evaluator(*args)
         repeated_costs.append(profile_result.results)
     costs = [float(cost) for cost in itertools.chain.from_iterable(repeated_costs)]
+    # Keep measuring on the arguments in turn until the confidence interval is tight enough
+    i = 0
+    while len(costs) < evaluator_config.max_repeat and not _is_ci_tight(
+        costs, evaluator_config.ci_tolerance
+    ):
+        args = repeated_args[i % len(repeated_args)]
+        i += 1
+        device.sync()
+        profile_result = evaluator(*args)
+        costs.extend(float(cost) for cost in profile_result.results)
     return costs
+
+
+def _is_ci_tight(costs: List[float], ci_tolerance: float) -> bool:
+    """Check if the 95% confidence interval of the mean cost is within the tolerance relative to
+    the median cost."""
+    if len(costs) < 2:
+        return False
+    half_width = 1.96 * statistics.stdev(costs) / math.sqrt(len(costs))
+    return half_width <= ci_tolerance * statistics.median(costs)
@@ -45,6 +45,9 @@ class EvolutionarySearch(SearchStrategy):
         The maximum number to retry mutation.
     eps_greedy : float
         The ratio of greedy selected samples in the final picks.
+    num_transfer_workloads : int
+        The maximum number of the tuned workloads similar to a workload not tuned yet, whose best
+        schedules are transferred to the initial population. Zero disables the transfer.
     """
 
     population_size: int
@@ -54,6 +57,7 @@ class EvolutionarySearch(SearchStrategy):
     genetic_mutate_prob: float
     genetic_max_fail_count: int
     eps_greedy: float
+    num_transfer_workloads: int
 
     def __init__(
         self,
@@ -66,6 +70,7 @@ class EvolutionarySearch(SearchStrategy):
         genetic_mutate_prob: float = 0.85,
         genetic_max_fail_count: int = 10,
         eps_greedy: float = 0.05,
+        num_transfer_workloads: int = 0,
     ) -> None:
         """Constructor"""
         self.__init_handle_by_constructor__(
@@ -78,4 +83,5 @@ class EvolutionarySearch(SearchStrategy):
             genetic_mutate_prob,
             genetic_max_fail_count,
             eps_greedy,
+            num_transfer_workloads,
         )
@@ -33,6 +33,8 @@ class GradientBased(TaskScheduler):
         *,
         alpha: float = 0.2,
         window_size: int = 3,
+        plateau_rounds: int = 0,
+        plateau_threshold: float = 0.01,
         seed: int = -1,
     ) -> None:
         """Constructor.
@@ -43,6 +45,12 @@ class GradientBased(TaskScheduler):
             The parameter alpha in gradient computation.
         window_size : int = 3
             The parameter to control backward window size in gradient computation.
+        plateau_rounds : int = 0
+            The number of rounds over which a task is checked for convergence. A converged task
+            stops early, and its remaining trials go to the other tasks. Zero disables the check.
+        plateau_threshold : float = 0.01
+            The relative improvement of the best latency within `plateau_rounds` rounds, below
+            which a task converges.
         seed : int = -1
             The random seed.
         """
@@ -51,5 +59,7 @@ class GradientBased(TaskScheduler):
             get_logging_func(logger),
             alpha,
             window_size,
+            plateau_rounds,
+            plateau_threshold,
             seed,
         )
@@ -0,0 +1,100 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A microbenchmark of forking schedules, alone and in the design space generation of the
+default schedule rules, which forks a schedule for every branch of every rule.
+
+Example:
+    python -m tvm.meta_schedule.testing.bench_schedule_fork --workload C2D --target llvm
+"""
+import argparse
+import time
+
+import tvm
+from tvm import meta_schedule as ms
+from tvm import tir
+from tvm.meta_schedule.testing.te_workload import create_te_workload
+
+
+def _parse_args():
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--workload",
+        type=str,
+        default="C2D",
+        help="The name of the workload in tvm.meta_schedule.testing.te_workload.",
+    )
+    parser.add_argument(
+        "--target",
+        type=str,
+        default="llvm -num-cores=4",
+        help="The target to generate the design spaces for.",
+    )
+    parser.add_argument(
+        "--num_copies",
+        type=int,
+        default=10000,
+        help="The number of copies of a schedule to time.",
+    )
+    parser.add_argument(
+        "--repeat",
+        type=int,
+        default=10,
+        help="The number of design space generations to time.",
+    )
+    return parser.parse_args()
+
+
+def _time_us(func, number: int) -> float:
+    tic = time.perf_counter()
+    for _ in range(number):
+        func()
+    return (time.perf_counter() - tic) / number * 1e6
+
+
+def main():
+    args = _parse_args()
+    mod = tvm.IRModule({"main": create_te_workload(args.workload, 0)})
+    target = tvm.target.Target(args.target)
+    sch = tir.Schedule(mod)
+    block = sch.get_child_blocks(sch.get_block("root"))[-1]
+
+    def copy_dropped():
+        sch.copy()
+
+    def copy_touched():
+        sch.copy().get_loops(block)
+
+    print(f"Schedule.copy, dropped:  {_time_us(copy_dropped, args.num_copies):10.2f} us")
+    print(f"Schedule.copy, accessed: {_time_us(copy_touched, args.num_copies):10.2f} us")
+
+    context = ms.TuneContext(
+        mod=mod,
+        target=target,
+        space_generator="post-order-apply",
+        task_name=args.workload,
+    )
+    num_spaces = len(context.generate_design_space())
+
+    def generate():
+        context.generate_design_space()
+
+    cost_ms = _time_us(generate, args.repeat) / 1000
+    print(f"Design space generation: {cost_ms:10.2f} ms for {num_spaces} design spaces")
+
+
+if __name__ == "__main__":
+    main()
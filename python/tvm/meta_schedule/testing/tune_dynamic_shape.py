@@ -0,0 +1,173 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-docstring
+"""Tune a kernel with a dynamic sequence length on shape buckets, and benchmark the latency of the
+dispatched schedules against the untuned kernel across a sweep of the sequence length."""
+import argparse
+import logging
+
+import numpy as np
+
+import tvm
+from tvm import meta_schedule as ms
+from tvm import te
+from tvm.support import describe
+
+
+def _parse_args():
+    args = argparse.ArgumentParser()
+    args.add_argument(
+        "--target",
+        type=str,
+        required=True,
+    )
+    args.add_argument(
+        "--num-trials",
+        type=int,
+        required=True,
+    )
+    args.add_argument(
+        "--work-dir",
+        type=str,
+        required=True,
+    )
+    args.add_argument(
+        "--hidden",
+        type=int,
+        default=1024,
+    )
+    args.add_argument(
+        "--min-seq-len",
+        type=int,
+        default=1,
+    )
+    args.add_argument(
+        "--max-seq-len",
+        type=int,
+        default=2048,
+    )
+    args.add_argument(
+        "--sweep",
+        type=int,
+        nargs="+",
+        help="example: 1 7 100 1000 3000",
+        default=None,
+    )
+    args.add_argument(
+        "--number",
+        type=int,
+        default=3,
+    )
+    args.add_argument(
+        "--repeat",
+        type=int,
+        default=1,
+    )
+    args.add_argument(
+        "--min-repeat-ms",
+        type=int,
+        default=100,
+    )
+    parsed = args.parse_args()
+    parsed.target = tvm.target.Target(parsed.target)
+    if parsed.sweep is None:
+        parsed.sweep = [
+            parsed.min_seq_len,
+            *ms.tir_integration.shape_buckets(parsed.min_seq_len, parsed.max_seq_len),
+            parsed.max_seq_len * 2,
+        ]
+        parsed.sweep = sorted(set(parsed.sweep + [b + b // 2 + 1 for b in parsed.sweep]))
+    return parsed
+
+
+logging.basicConfig(
+    format="%(asctime)s.%(msecs)03d %(levelname)s %(message)s", datefmt="%Y-%m-%d %H:%M:%S"
+)
+logging.getLogger("tvm.meta_schedule").setLevel(logging.DEBUG)
+ARGS = _parse_args()
+
+
+def _dense(hidden: int) -> tvm.tir.PrimFunc:
+    seq_len = te.var("seq_len", "int64")
+    data = te.placeholder((seq_len, hidden), name="data")
+    weight = te.placeholder((hidden, hidden), name="weight")
+    k = te.reduce_axis((0, hidden), name="k")
+    out = te.compute(
+        (seq_len, hidden),
+        lambda i, j: te.sum(data[i, k] * weight[j, k], axis=k),
+        name="dense",
+    )
+    return te.create_prim_func([data, weight, out])
+
+
+def _latency_ms(lib: tvm.runtime.Module, dev: tvm.runtime.Device, seq_len: int) -> float:
+    args = [
+        tvm.nd.array(np.random.uniform(size=(seq_len, ARGS.hidden)).astype("float32"), dev),
+        tvm.nd.array(np.random.uniform(size=(ARGS.hidden, ARGS.hidden)).astype("float32"), dev),
+        tvm.nd.array(np.zeros((seq_len, ARGS.hidden), dtype="float32"), dev),
+    ]
+    evaluator = lib.time_evaluator(
+        lib.entry_name,
+        dev,
+        number=ARGS.number,
+        repeat=ARGS.repeat,
+        min_repeat_ms=ARGS.min_repeat_ms,
+    )
+    return float(np.median(evaluator(*args).results)) * 1000.0
+
+
+def main():
+    describe()
+    func = _dense(ARGS.hidden)
+    buckets = ms.tir_integration.shape_buckets(ARGS.min_seq_len, ARGS.max_seq_len)
+    print(f"Buckets: {buckets}")
+    with ms.Profiler() as profiler:
+        database = ms.tir_integration.tune_tir_buckets(
+            func,
+            "seq_len",
+            buckets,
+            target=ARGS.target,
+            work_dir=ARGS.work_dir,
+            max_trials_global=ARGS.num_trials,
+            num_trials_per_iter=64,
+            runner=ms.runner.LocalRunner(
+                evaluator_config=ms.runner.EvaluatorConfig(
+                    number=ARGS.number,
+                    repeat=ARGS.repeat,
+                    min_repeat_ms=ARGS.min_repeat_ms,
+                ),
+            ),
+        )
+    print("Tuning Time:")
+    print(profiler.table())
+
+    dispatched = ms.tir_integration.compile_tir_buckets(
+        database, func, "seq_len", buckets, ARGS.target
+    )
+    dev = tvm.device(ARGS.target.kind.name, 0)
+    libs = {"untuned": tvm.compile(func, target=ARGS.target)}
+    libs["dispatched"] = tvm.compile(dispatched, target=ARGS.target)
+    print(f"{'seq_len':>8} {'bucket':>8} {'untuned (ms)':>14} {'tuned (ms)':>12} {'speedup':>8}")
+    for seq_len in ARGS.sweep:
+        bucket = next((b for b in buckets if b >= seq_len), buckets[-1])
+        untuned = _latency_ms(libs["untuned"], dev, seq_len)
+        tuned = _latency_ms(libs["dispatched"], dev, seq_len)
+        print(f"{seq_len:>8} {bucket:>8} {untuned:>14.4f} {tuned:>12.4f} {untuned / tuned:>8.2f}")
+
+
+if __name__ == "__main__":
+    main()
@@ -22,6 +22,7 @@ from typing_extensions import Literal
 
 # isort: on
 from tvm import ir, tir
+from tvm.error import TVMError
 from tvm.ffi import register_func
 from tvm.target import Target
 from tvm.tir.expr import IntImm
@@ -29,7 +30,7 @@ from tvm.tir.expr import IntImm
 from .builder import Builder
 from .cost_model import CostModel
 from .database import Database
-from .logging import get_loggers_from_work_dir
+from .logging import get_logger, get_loggers_from_work_dir
 from .measure_callback import MeasureCallback
 from .runner import Runner
 from .search_strategy import SearchStrategy
@@ -269,3 +270,172 @@ def compile_tir(
     if not isinstance(target, Target):
         target = Target(target)
     return database.query_schedule(mod, target, workload_name="main")
+
+
+def shape_buckets(lower: int, upper: int) -> List[int]:
+    """The default shape buckets of a symbolic variable, which are the powers of two covering the
+    range [lower, upper].
+
+    Parameters
+    ----------
+    lower : int
+        The lower bound of the variable.
+    upper : int
+        The upper bound of the variable.
+
+    Returns
+    -------
+    buckets : List[int]
+        The sorted bucket values, the last of which is not smaller than `upper`.
+    """
+    if not 1 <= lower <= upper:
+        raise ValueError(f"Invalid range of the variable: [{lower}, {upper}]")
+    buckets = [1]
+    while buckets[-1] < upper:
+        buckets.append(buckets[-1] * 2)
+    return [b for b in buckets if b >= lower]
+
+
+def _get_shape_var(func: tir.PrimFunc, var: Union[str, tir.Var]) -> tir.Var:
+    """Find the symbolic variable in the buffer shapes of the function"""
+    for buffer in func.buffer_map.values():
+        for dim in buffer.shape:
+            for shape_var in tir.analysis.undefined_vars(dim):
+                if shape_var.same_as(var) or shape_var.name == var:
+                    return shape_var
+    raise ValueError(f"The variable {var} is not found in the buffer shapes of the function")
+
+
+def _specialize_bucket(func: tir.PrimFunc, var: tir.Var, value: int) -> tir.PrimFunc:
+    """Specialize the function on a value of the symbolic variable"""
+    for param in func.params:
+        buffer = func.buffer_map.get(param, None)
+        if buffer is None:
+            continue
+        shape_vars = [v for dim in buffer.shape for v in tir.analysis.undefined_vars(dim)]
+        if not any(v.same_as(var) for v in shape_vars):
+            continue
+        shape = [
+            tir.stmt_functor.substitute(dim, {var: IntImm(var.dtype, value)})
+            for dim in buffer.shape
+        ]
+        return func.specialize({param: tir.decl_buffer(shape, buffer.dtype, buffer.name)})
+    raise ValueError(f"The variable {var} is not found in the buffer shapes of the function")
+
+
+def tune_tir_buckets(
+    mod: Union[ir.IRModule, tir.PrimFunc],
+    var: Union[str, tir.Var],
+    buckets: List[int],
+    target: Union[str, Target],
+    work_dir: str,
+    max_trials_global: int,
+    **kwargs,
+) -> Database:
+    """Tune a TIR function with a symbolic shape variable, e.g. the sequence length, on a set of
+    representative shape buckets. Each bucket is a task specialized on the value of the variable,
+    and the task scheduler distributes the trials among the buckets with the guidance of the cost
+    model. Use `compile_tir_buckets` to generate the function dispatching on the variable.
+
+    Parameters
+    ----------
+    mod : Union[ir.IRModule, tir.PrimFunc]
+        The TIR function to tune.
+    var : Union[str, tir.Var]
+        The symbolic variable, or its name, in the buffer shapes of the function.
+    buckets : List[int]
+        The values of the variable to tune, see `shape_buckets` for the default ones.
+    target : Union[str, Target]
+        The target to tune for.
+    work_dir : str
+        The working directory.
+    max_trials_global : int
+        The maximum number of trials to run globally.
+    **kwargs
+        The other arguments of `tune_tir`.
+
+    Returns
+    -------
+    database : Database
+        The database with all tuning records
+    """
+    func = _normalize_mod(mod)["main"]
+    var = _get_shape_var(func, var)
+    bucket_funcs = {
+        f"{var.name}_{value}": _specialize_bucket(func, var, value)
+        for value in sorted(set(buckets))
+    }
+    return tune_tir(ir.IRModule(bucket_funcs), target, work_dir, max_trials_global, **kwargs)
+
+
+def compile_tir_buckets(
+    database: Database,
+    mod: Union[ir.IRModule, tir.PrimFunc],
+    var: Union[str, tir.Var],
+    buckets: List[int],
+    target: Union[str, Target],
+) -> tir.PrimFunc:
+    """Generate a function that dispatches on a symbolic shape variable to the schedules tuned by
+    `tune_tir_buckets`.
+
+    The schedule tuned for a bucket is applied to the original function, keeping its tile sizes
+    with the outermost tiles inferred from the variable, so that it is valid for any value of the
+    variable. The value `v` runs the schedule of the smallest bucket not smaller than `v`, and the
+    values beyond the largest bucket run the schedule of the largest bucket. A bucket without a
+    tuning record, or whose schedule cannot be applied to the original function, falls back to the
+    original function body.
+
+    Parameters
+    ----------
+    database : Database
+        The database of tuning records.
+    mod : Union[ir.IRModule, tir.PrimFunc]
+        The TIR function with the symbolic variable.
+    var : Union[str, tir.Var]
+        The symbolic variable, or its name, in the buffer shapes of the function.
+    buckets : List[int]
+        The values of the variable tuned.
+    target : Union[str, Target]
+        The target tuned for.
+
+    Returns
+    -------
+    func : tir.PrimFunc
+        The function dispatching on the variable.
+    """
+    if not isinstance(target, Target):
+        target = Target(target)
+    mod = _normalize_mod(mod)
+    func = mod["main"]
+    var = _get_shape_var(func, var)
+    bodies = []
+    for value in sorted(set(buckets)):
+        bucket_mod = _normalize_mod(_specialize_bucket(func, var, value))
+        record = database.query_tuning_record(bucket_mod, target, workload_name="main")
+        body = None
+        if record is not None:
+            sch = tir.Schedule(mod)
+            try:
+                record.trace.apply_to_schedule(sch, remove_postproc=False)
+                scheduled = sch.mod["main"]
+                if all(scheduled.buffer_map[p].same_as(b) for p, b in func.buffer_map.items()):
+                    body = scheduled.body
+            except (TVMError, ValueError) as error:
+                # ScheduleError is a TVMError; failed checks in the sampling surface as ValueError
+                get_logger(__name__).warning(
+                    "Falling back to the original function for the bucket %s=%d, because its "
+                    "schedule cannot be applied to the original function: %s",
+                    var.name,
+                    value,
+                    error,
+                )
+        bodies.append((value, body))
+    largest = bodies[-1][1]
+    stmt = largest if largest is not None else func.body
+    for value, body in reversed(bodies[:-1]):
+        stmt = tir.IfThenElse(var <= value, body if body is not None else func.body, stmt)
+    # The branches may share the variables and the buffers of the original function body
+    result = tir.transform.ConvertSSA()(ir.IRModule({"main": func.with_body(stmt)}))["main"]
+    if all(body is not None for _, body in bodies):
+        result = result.with_attr("tir.is_scheduled", True)
+    return result
@@ -17,14 +17,17 @@
 """The core tuning API"""
 from typing import List, Optional
 
-from .builder import Builder
+from tvm.tir import Schedule
+
+from .builder import Builder, BuilderInput
 from .cost_model import CostModel
-from .database import Database
+from .database import Database, TuningRecord
 from .measure_callback import MeasureCallback
-from .runner import Runner
+from .runner import Runner, RunnerInput
 from .task_scheduler import TaskScheduler
 from .tune_context import TuneContext
 from .post_optimization import PostOpt
+from .utils import remove_build_dir
 
 
 def tune_tasks(
@@ -43,6 +46,7 @@ def tune_tasks(
     task_scheduler: TaskScheduler.TaskSchedulerType = "gradient",
     module_equality: str = "structural",
     post_optimization: Optional[bool] = False,
+    num_head_to_head: int = 0,
 ) -> Database:
     """Tune a list of tasks. Using a task scheduler.
 
@@ -85,6 +89,10 @@ def tune_tasks(
                 tir/analysis/analysis.py.
     post_optimization : Optional[Bool]
         Generate post-optimization using Droplet Search as exploitation space.
+    num_head_to_head : int
+        The number of the best records of each task, among which the ones within the measurement
+        noise of the best record are measured again head-to-head after tuning. Zero disables the
+        head-to-head measurement.
 
     Returns
     -------
@@ -107,7 +115,7 @@ def tune_tasks(
         builder = Builder.create(builder, max_workers=num_cores)
     if not isinstance(runner, Runner):
         runner = Runner.create(runner, max_workers=num_cores)
-    if database == "json":
+    if database in ("json", "shared"):
         database = Database.create(database, work_dir=work_dir, module_equality=module_equality)
     elif not isinstance(database, Database):
         database = Database.create(database, module_equality=module_equality)
@@ -131,7 +139,78 @@ def tune_tasks(
         database=database,
         cost_model=cost_model,
     )
+    if num_head_to_head > 0:
+        for task in tasks:
+            _measure_head_to_head(task, builder, runner, database, num_head_to_head)
     if post_optimization:
         post_opt = PostOpt(work_dir, tasks[0].target)
         post_opt.run()
     return database
+
+
+def _measure_head_to_head(
+    task: TuneContext,
+    builder: Builder,
+    runner: Runner,
+    database: Database,
+    top_k: int,
+    num_rounds: int = 3,
+) -> None:
+    """Measure the best records of a task again, whose 10th percentile running time is within the
+    90th percentile of the best record. The contenders are measured in turn for several rounds, so
+    that they see the same noise of the machine, and the new measurements are committed to the
+    database, where they are pooled with the previous ones of the same schedule.
+
+    Parameters
+    ----------
+    task : TuneContext
+        The tuned task.
+    builder : Builder
+        The builder.
+    runner : Runner
+        The runner.
+    database : Database
+        The database.
+    top_k : int
+        The number of the best records to consider.
+    num_rounds : int
+        The number of rounds to measure the contenders.
+    """
+    if not database.has_workload(task.mod):
+        return
+    workload = database.commit_workload(task.mod)
+    records = database.get_top_k(workload, top_k)
+    if len(records) < 2:
+        return
+    best_p90 = records[0].run_secs_statistics()["p90"]
+    contenders = [r for r in records if r.run_secs_statistics()["p10"] <= best_p90]
+    if len(contenders) < 2:
+        return
+    mods = []
+    for record in contenders:
+        sch = Schedule(workload.mod)
+        record.trace.apply_to_schedule(sch, remove_postproc=False)
+        mods.append(sch.mod)
+    builder_results = builder.build([BuilderInput(mod, task.target) for mod in mods])
+    measured = [
+        (record, RunnerInput(result.artifact_path, task.target.kind.name, record.args_info))
+        for record, result in zip(contenders, builder_results)
+        if result.error_msg is None
+    ]
+    for _ in range(num_rounds):
+        for record, runner_input in measured:
+            runner_result = runner.run([runner_input])[0].result()
+            if runner_result.error_msg is not None:
+                continue
+            database.commit_tuning_record(
+                TuningRecord(
+                    record.trace,
+                    workload=workload,
+                    run_secs=runner_result.run_secs,
+                    target=task.target,
+                    args_info=record.args_info,
+                )
+            )
+    for result in builder_results:
+        if result.error_msg is None:
+            remove_build_dir(result.artifact_path)
@@ -114,6 +114,6 @@ from . import frontend
 from . import utils
 
 # VM
-from .vm_build import build, VMExecutable
+from .vm_build import build, FunctionBuildCache, VMExecutable
 
 from .binding_rewrite import DataflowBlockRewrite
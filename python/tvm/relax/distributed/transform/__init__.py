@@ -17,6 +17,7 @@
 """Relax distributed-related transformations. """
 
 from .transform import (
+    AutoSharding,
     PropagateSharding,
     LowerGlobalViewToLocalView,
     LegalizeRedistribute,
@@ -32,6 +32,43 @@ def PropagateSharding() -> tvm.ir.transform.Pass:
     return _ffi_api.PropagateSharding()  # type: ignore
 
 
+def AutoSharding(
+    device_mesh: "tvm.relax.distributed.DeviceMesh",
+    memory_limit: int = -1,
+    bandwidth: float = 1e11,
+    peak_flops: float = 1e13,
+) -> tvm.ir.transform.Pass:
+    """Search the sharding of the functions without sharding annotations, and annotate them
+    with R.dist.annotate_sharding for PropagateSharding to consume.
+
+    Each device mesh dimension shards at most one group of tensor axes that propagation keeps
+    consistent. The plan minimizes the estimated compute time plus the allreduce time of
+    sharded reduction axes, among the plans that fit in the per-device memory.
+
+    Parameters
+    ----------
+    device_mesh : tvm.relax.distributed.DeviceMesh
+        The device mesh to shard the functions on.
+
+    memory_limit : int
+        The memory available on each device in bytes, or -1 if unlimited.
+
+    bandwidth : float
+        The bandwidth of the collective communication in bytes per second.
+
+    peak_flops : float
+        The peak compute throughput of each device in flops per second.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered pass
+    """
+    return _ffi_api.AutoSharding(  # type: ignore
+        device_mesh, memory_limit, bandwidth, peak_flops
+    )
+
+
 def LowerGlobalViewToLocalView() -> tvm.ir.transform.Pass:
     """Lower global view TIR to local view
 
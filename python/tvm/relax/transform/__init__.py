@@ -23,6 +23,7 @@ from .transform import (
     AnnotateTIROpPattern,
     AttachAttrLayoutFreeBuffers,
     AttachGlobalSymbol,
+    AutoCheckpoint,
     BindParams,
     BindSymbolicVars,
     BundleModelParams,
@@ -42,12 +43,14 @@ from .transform import (
     ExpandTupleArguments,
     FewShotTuning,
     FoldConstant,
+    FoldConstantClearCache,
     FunctionPass,
     FuseOps,
     FuseOpsByPattern,
     FuseTIR,
     FusionPattern,
     Gradient,
+    HorizontalFuseTIR,
     InlinePrivateFunctions,
     KillAfterLastUse,
     LambdaLift,
@@ -73,6 +76,7 @@ from .transform import (
     RewriteCUDAGraph,
     RewriteDataflowReshape,
     RunCodegen,
+    SelectLayout,
     SplitCallTIRByPattern,
     SplitLayoutRewritePreproc,
     StaticPlanBlockMemory,
@@ -96,6 +100,7 @@ from .lower_gpu_ipc_alloc_storage import LowerGPUIPCAllocStorage
 from .optimize_layout_transform import OptimizeLayoutTransform
 from .fold_batch_norm_to_conv2d_for_inference import FoldBatchnormToConv2D
 from .remove_redundant_reshape import RemoveRedundantReshape
+from .weight_only_quantize import WeightOnlyQuantize
 
 # Import to register the legalization functions.
 from . import legalize_ops
@@ -225,6 +225,42 @@ def Gradient(
     return _ffi_api.Gradient(func_name, require_grads, target_index)  # type: ignore
 
 
+def AutoCheckpoint(
+    func_name: str, memory_budget: int, target_index: int = 0
+) -> tvm.ir.transform.Pass:
+    """Automatic checkpointing for :py:func:`Gradient`.
+
+    Gradient keeps every forward activation used by the backward pass alive until its use.
+    This pass chooses a set of such activations to be recomputed in the backward pass
+    instead, so that the memory of the activations that are kept fits in `memory_budget`.
+    The activations with fewer recomputation FLOPs per byte are dropped first. The choice
+    is expressed with ``R.grad.start_checkpoint`` and ``R.grad.end_checkpoint`` in the
+    function, in the same way as :py:func:`tvm.relax.testing.nn.checkpoint`, so this pass
+    should be applied right before Gradient. Functions that already contain checkpoints are
+    left as is.
+
+    As the dropped activations die after their forward uses, and are recomputed right
+    before their backward uses, StaticPlanBlockMemory can reuse their storage in between.
+
+    Parameters
+    ----------
+    func_name : str
+        The name of the function to be differentiated.
+
+    memory_budget : int
+        The budget in bytes of the forward activations kept for the backward pass.
+
+    target_index : int
+        The index of the differentiation target, the same as in :py:func:`Gradient`.
+
+    Returns
+    -------
+    ret : tvm.ir.transform.Pass
+        The Pass.
+    """
+    return _ffi_api.AutoCheckpoint(func_name, memory_budget, target_index)  # type: ignore
+
+
 def ToNonDataflow() -> tvm.ir.transform.Pass:
     """Transform all dataflow structure to non-dataflow version.
 
@@ -728,6 +764,15 @@ def FoldConstant() -> tvm.ir.transform.Pass:
 
     Note: ConvertToDataflow may need to be called first to provide dataflow blocks.
 
+    The PrimFuncs built to evaluate constants are cached for the whole process,
+    keyed by the PrimFunc and the PassContext config, see
+    :py:func:`FoldConstantClearCache`. The PassContext option
+    ``"relax.fold_constant_build_cache_size"`` bounds the number of cached
+    builds (256 by default), evicting the least recently used ones. With the
+    PassContext option ``"relax.fold_constant_batch_build"``, all PrimFuncs
+    that may be folded in a function are collected first and built together
+    as a single module.
+
     Returns
     -------
     ret: tvm.ir.transform.Pass
@@ -735,6 +780,11 @@ def FoldConstant() -> tvm.ir.transform.Pass:
     return _ffi_api.FoldConstant()  # type: ignore
 
 
+def FoldConstantClearCache() -> None:
+    """Clear the process-wide cache of PrimFuncs built by FoldConstant."""
+    _ffi_api.FoldConstantClearCache()  # type: ignore
+
+
 def ExpandTupleArguments() -> tvm.ir.transform.Pass:
     """Expand tuple arguments to internal functions
 
@@ -795,6 +845,11 @@ def FuseOps(fuse_opt_level=-1) -> tvm.ir.transform.Pass:
 
     Note: ConvertToDataflow may need to be called first to provide dataflow blocks.
 
+    With the pass config "relax.FuseOps.cost_model" set, a fusion allowed by the op patterns is
+    only applied when the fused kernel is estimated to be no slower than the separate kernels.
+    The estimate uses the FLOPs and memory traffic of the kernels, calibrated by the records of
+    the current MetaSchedule database for the current target.
+
     Parameters
     ----------
     fuse_opt_level : int
@@ -820,6 +875,39 @@ def FuseTIR() -> tvm.ir.transform.Pass:
     return _ffi_api.FuseTIR()  # type: ignore
 
 
+def HorizontalFuseTIR(
+    max_num_elements: int = 16384, max_group_size: int = 16
+) -> tvm.ir.transform.Pass:
+    """Pack the independent small call_tir of each dataflow block into horizontally fused
+    PrimFuncs, to reduce the number of kernel launches.
+
+    The packed kernels are of the same dependency level in the dataflow block, so none of them
+    depends on another. The fused PrimFunc takes the inputs of all the kernels followed by their
+    outputs, and dispatches each iteration of its outermost parallel loop to one of the kernels.
+    The call of the fused PrimFunc returns a tuple of all the outputs. The reduction of the
+    number of kernels is reported in the log.
+
+    The pass is intended to run after FuseTIR and before the kernels are scheduled. Only the
+    PrimFuncs with static shapes and without parallel, vectorized or thread-bound loops are
+    packed, and the pass does nothing when the current target is not a CPU target. The
+    original PrimFuncs are left in the module, to be removed by DeadCodeElimination.
+
+    Parameters
+    ----------
+    max_num_elements : int
+        The maximal number of output elements of a kernel to be packed.
+
+    max_group_size : int
+        The maximal number of kernels packed into one PrimFunc.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered pass for horizontal fusion.
+    """
+    return _ffi_api.HorizontalFuseTIR(max_num_elements, max_group_size)  # type: ignore
+
+
 @tvm.ffi.register_object("relax.transform.PatternCheckContext")
 class PatternCheckContext(Object):
     """
@@ -1381,6 +1469,33 @@ def ConvertLayout(desired_layouts: Dict[str, List[str]]) -> tvm.ir.transform.Pas
     return _ffi_api.ConvertLayout(desired_layouts)  # type: ignore
 
 
+def SelectLayout(candidate_layouts: Dict[str, List[List[str]]]) -> tvm.ir.transform.Pass:
+    """Cost-guided layout selection pass.
+
+    For each call of the given operators, the pass chooses among the candidate layouts and
+    the original layout, so that the estimated time of the kernels plus the inserted layout
+    transforms is minimal over the dataflow block. The chosen layouts are then applied in
+    the same way as :py:func:`ConvertLayout`.
+
+    The time of a kernel is taken from the tuning records of the current MetaSchedule
+    database when the database and the target are in scope and a record exists. Otherwise
+    it is estimated from the FLOPs and the memory traffic of the kernel.
+
+    Parameters
+    ----------
+    candidate_layouts : Dict[str, List[List[str]]]
+        The candidate layouts of each operator, each in the same format as the desired
+        layouts of :py:func:`ConvertLayout`. For example,
+        ``{"relax.nn.conv2d": [["NHWC", "OHWI"], ["NCHW16c", "OIHW16o"]]}``.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered pass for layout selection.
+    """
+    return _ffi_api.SelectLayout(candidate_layouts)  # type: ignore
+
+
 def DeadCodeElimination(entry_functions: Optional[List[str]] = None) -> tvm.ir.transform.Pass:
     """Remove dead code in the IRModule.
     Currently it removes:
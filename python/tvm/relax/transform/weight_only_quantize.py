@@ -0,0 +1,271 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A compiler pass that quantizes the weights of matmul into grouped int4/int8 storage.
+Note that
+1. Please put the pass before LegalizeOps pass.
+2. The weights are the constants, and the parameters after the first `num_input` parameters
+   of the functions with the "num_input" attribute.
+3. The weights are encoded by TIR functions in the graph. Run FoldConstant to encode the
+   constant weights at compile time, and LiftTransformParams to move the encoding of the
+   parameters into the parameter transformation function.
+4. The decode is a separate block in front of the matmul, to be inlined by the dlight GEMV
+   rules (e.g. `dlight.cpu.GEMV`) into a decode-GEMV kernel.
+"""
+from typing import Dict, Optional, Set, Tuple
+
+import tvm
+from tvm import IRModule, relax, te, tir
+from tvm.relax.expr_functor import PyExprMutator, mutator
+
+
+@tvm.transform.module_pass(opt_level=0, name="WeightOnlyQuantize")
+class WeightOnlyQuantize:  # pylint: disable=too-few-public-methods
+    """Rewrite the matmul against a 2-D weight into a decode-matmul against the weight
+    quantized symmetrically in groups along the reduction axis. The quantized weight of shape
+    (N, K) is packed into "uint32" of shape (N, K * bits / 32), with one scale of the weight
+    dtype per group of shape (N, K / group_size).
+
+    Parameters
+    ----------
+    bits : int
+        The number of bits of each quantized value, 4 or 8.
+
+    group_size : int
+        The number of consecutive values along the reduction axis sharing a scale. It must
+        be a multiple of 32 / bits.
+    """
+
+    def __init__(self, bits: int = 4, group_size: int = 32):
+        if bits not in (4, 8):
+            raise ValueError(f"WeightOnlyQuantize supports 4 or 8 bits, but got {bits}")
+        if group_size <= 0 or group_size % (32 // bits) != 0:
+            raise ValueError(
+                f"The group size must be a positive multiple of {32 // bits}, "
+                f"but got {group_size}"
+            )
+        self.bits = bits
+        self.group_size = group_size
+
+    def transform_module(self, mod: IRModule, _ctx: tvm.transform.PassContext) -> IRModule:
+        """IRModule-level transformation"""
+        quantizer = _WeightQuantizer(mod, self.bits, self.group_size)
+        for g_var, func in mod.functions_items():
+            if isinstance(func, relax.Function):
+                num_input = func.attrs.get("num_input", None) if func.attrs else None
+                quantizer.weight_params = (
+                    set(func.params[int(num_input) :]) if num_input is not None else set()
+                )
+                func = quantizer.visit_expr(func)
+                quantizer.builder_.update_func(g_var, func)
+        return quantizer.builder_.get()
+
+
+# pylint: disable=missing-docstring,invalid-name
+
+
+def _weight_accessor(weight: te.Tensor, transposed: bool):
+    """Return (N, K, accessor by (n, k)) of the weight of shape (K, N), or (N, K) if transposed."""
+    if transposed:
+        n, k = weight.shape
+        return n, k, lambda i, j: weight[i, j]
+    k, n = weight.shape
+    return n, k, lambda i, j: weight[j, i]
+
+
+def _compute_scale(weight: te.Tensor, bits: int, group_size: int, transposed: bool):
+    """Compute the scales of shape (N, K / group_size)."""
+    n, k, w = _weight_accessor(weight, transposed)
+    dtype = weight.dtype
+    max_int = (1 << (bits - 1)) - 1
+    r = te.reduce_axis((0, group_size), name="r")
+    max_abs_value = te.compute(
+        (n, k // group_size),
+        lambda i, j: te.max(te.abs(w(i, j * group_size + r)), axis=r),
+        name="max_abs_value",
+    )
+    return te.compute(
+        (n, k // group_size),
+        lambda i, j: tir.Select(
+            max_abs_value[i, j] > tir.const(0, dtype),
+            max_abs_value[i, j] / tir.const(max_int, dtype),
+            tir.const(1, dtype),
+        ),
+        name="scale",
+    )
+
+
+def _encode(weight: te.Tensor, scale: te.Tensor, bits: int, group_size: int, transposed: bool):
+    """Quantize the weight into the packed values of shape (N, K * bits / 32)."""
+    n, k, w = _weight_accessor(weight, transposed)
+    dtype = weight.dtype
+    num_elem_per_storage = 32 // bits
+    max_int = (1 << (bits - 1)) - 1
+    scaled = te.compute(
+        (n, k),
+        lambda i, j: (
+            tir.min(
+                tir.max(
+                    tir.round(w(i, j) / scale[i, j // group_size]),
+                    tir.const(-max_int - 1, dtype),
+                ),
+                tir.const(max_int, dtype),
+            )
+            + tir.const(max_int + 1, dtype)
+        ).astype("uint32"),
+        name="scaled",
+    )
+    r = te.reduce_axis((0, num_elem_per_storage), name="r")
+    return te.compute(
+        (n, k // num_elem_per_storage),
+        lambda i, j: te.sum(
+            scaled[i, j * num_elem_per_storage + r] << (r * bits).astype("uint32"), axis=r
+        ),
+        name="packed",
+    )
+
+
+def _decode_matmul(
+    x: te.Tensor, packed: te.Tensor, scale: te.Tensor, bits: int, group_size: int, out_dtype: str
+):
+    """Compute matmul(x, W^T) where W of shape (N, K) is decoded from the packed values."""
+    num_elem_per_storage = 32 // bits
+    max_int = (1 << (bits - 1)) - 1
+    mask = tir.const((1 << bits) - 1, "uint32")
+    n, k = packed.shape[0], packed.shape[1] * num_elem_per_storage
+
+    def decode(i, j):
+        shift = ((j % num_elem_per_storage) * bits).astype("uint32")
+        value = (packed[i, j // num_elem_per_storage] >> shift) & mask
+        return (value.astype(scale.dtype) - tir.const(max_int + 1, scale.dtype)) * scale[
+            i, j // group_size
+        ]
+
+    decoded = te.compute((n, k), decode, name="decode")
+    r = te.reduce_axis((0, k), name="k")
+    return te.compute(
+        (*x.shape[:-1], n),
+        lambda *idx: te.sum(
+            x(*idx[:-1], r).astype(out_dtype) * decoded[idx[-1], r].astype(out_dtype), axis=r
+        ),
+        name="NT_matmul",
+    )
+
+
+@mutator
+class _WeightQuantizer(PyExprMutator):  # pylint: disable=abstract-method
+    def __init__(self, mod: IRModule, bits: int, group_size: int):
+        super().__init__(mod)
+        self.bits = bits
+        self.group_size = group_size
+        self.weight_params: Set[relax.Var] = set()
+        # The scale and packed values emitted in the current binding block, per weight and
+        # whether it is transposed, so that a weight used by several matmuls is encoded once.
+        self._encoded: Dict[Tuple[relax.Expr, bool], Tuple[relax.Var, relax.Var]] = {}
+
+    def visit_binding_block_(self, block: relax.BindingBlock) -> relax.BindingBlock:
+        self._encoded = {}
+        return super().visit_binding_block_(block)
+
+    def visit_dataflow_block_(self, block: relax.DataflowBlock) -> relax.BindingBlock:
+        self._encoded = {}
+        return super().visit_dataflow_block_(block)
+
+    def _get_weight(self, expr: relax.Expr) -> Optional[relax.Expr]:
+        if isinstance(expr, relax.Constant) or (
+            isinstance(expr, relax.Var) and expr in self.weight_params
+        ):
+            return expr
+        return None
+
+    def _match_weight(self, expr: relax.Expr):
+        """Return the weight and whether it is transposed, i.e. of shape (N, K)."""
+        if isinstance(expr, relax.Var):
+            bound = self.lookup_binding(expr)
+            if (
+                isinstance(bound, relax.Call)
+                and bound.op == tvm.ir.Op.get("relax.permute_dims")
+                and bound.attrs.axes is None
+            ):
+                weight = self._get_weight(bound.args[0])
+                if weight is not None:
+                    return weight, True
+        weight = self._get_weight(expr)
+        return weight, False
+
+    def visit_call_(  # pylint: disable=arguments-renamed
+        self,
+        call: relax.Call,
+    ) -> relax.Expr:
+        call = super().visit_call_(call)
+        if call.op != tvm.ir.Op.get("relax.matmul"):
+            return call
+        x = call.args[0]
+        weight, transposed = self._match_weight(call.args[1])
+        if weight is None:
+            return call
+        weight_sinfo = weight.struct_info
+        out_sinfo = call.struct_info
+        if (
+            weight_sinfo.ndim != 2
+            or x.struct_info.ndim < 1
+            or not isinstance(weight_sinfo.shape, relax.ShapeExpr)
+            or not any(weight_sinfo.dtype.startswith(t) for t in ("float", "bfloat"))
+            or not isinstance(out_sinfo, relax.TensorStructInfo)
+        ):
+            return call
+        k = weight_sinfo.shape.values[1 if transposed else 0]
+        if not isinstance(k, tir.IntImm) or k.value % self.group_size != 0:
+            return call
+
+        scale, packed = self._encode_weight(weight, transposed)
+        return self.builder_.call_te(
+            lambda x, packed, scale: _decode_matmul(
+                x, packed, scale, self.bits, self.group_size, out_sinfo.dtype
+            ),
+            x,
+            packed,
+            scale,
+            primfunc_name_hint=f"decode_int{self.bits}_NT_matmul",
+        )
+
+    def _encode_weight(self, weight: relax.Expr, transposed: bool) -> Tuple[relax.Var, relax.Var]:
+        """Emit the scale and the packed values of the weight, or reuse the ones emitted for
+        another matmul in the same binding block."""
+        key = (weight, transposed)
+        if key in self._encoded:
+            return self._encoded[key]
+        # The scale and the packed values are separate calls, so that both of them can be
+        # folded by FoldConstant, which only folds the call_tir with a single output.
+        scale = self.builder_.emit(
+            self.builder_.call_te(
+                lambda w: _compute_scale(w, self.bits, self.group_size, transposed),
+                weight,
+                primfunc_name_hint="compute_scale",
+            ),
+            name_hint="scale",
+        )
+        packed = self.builder_.emit(
+            self.builder_.call_te(
+                lambda w, s: _encode(w, s, self.bits, self.group_size, transposed),
+                weight,
+                scale,
+                primfunc_name_hint=f"encode_int{self.bits}",
+            ),
+            name_hint="packed",
+        )
+        self._encoded[key] = (scale, packed)
+        return scale, packed
@@ -22,7 +22,7 @@ import tvm
 from tvm import relax
 from tvm.ir.module import IRModule
 from tvm.tir.function import PrimFunc
-from tvm.runtime import Executable
+from tvm.runtime import Executable, Object
 
 from . import _ffi_api
 
@@ -49,6 +49,85 @@ class VMExecutable(Executable):
         return self._as_python()
 
 
+@tvm.ffi.register_object("relax.FunctionBuildCache")
+class FunctionBuildCache(Object):
+    """A cache of the compiled TIR functions across the builds of relax modules.
+
+    When a cache is passed to ``tvm.compile`` or ``relax.build``, the TIR functions of the
+    module are lowered and compiled one by one, and each compiled function is stored in the
+    cache. The later builds only compile the functions not found in the cache, and link all the
+    compiled functions into the VM executable. Therefore, the TIR lowering and the codegen of
+    a rebuild after changing a few functions of a large model take time proportional to the
+    change, while the relax pipeline still runs over the whole module.
+
+    A function is found in the cache if the target and the TIR pipeline of the build are the
+    same, the current PassContext has the same opt_level, required and disabled passes and
+    "tir." config options, and the module of the function, with the attributes of the TIR
+    module, is structurally equal to a cached one. The comparison includes the data of the
+    constants, so that a function whose constants changed is compiled again. The cache is
+    skipped when the TIR pipeline is not given by name, when the "tir." config options cannot
+    be compared, e.g. with passes added through "tir.add_lower_pass", when the functions call
+    each other, or when a system library is built.
+    """
+
+    def __init__(self) -> None:
+        self.__init_handle_by_constructor__(_ffi_api.FunctionBuildCache)  # type: ignore
+
+    def __len__(self) -> int:
+        return _ffi_api.FunctionBuildCacheSize(self)  # type: ignore
+
+    def clear(self) -> None:
+        """Remove all the compiled functions and reset the statistics."""
+        _ffi_api.FunctionBuildCacheClear(self)  # type: ignore
+
+    def build(
+        self,
+        tir_mod: tvm.IRModule,
+        target: Optional[tvm.target.Target],
+        tir_pipeline: Optional[Union[str, tvm.transform.Pass]],
+    ) -> Optional[List[tvm.runtime.Module]]:
+        """Build the TIR module into one compiled module per function, reusing the cached ones.
+
+        Parameters
+        ----------
+        tir_mod : IRModule
+            The TIR module to be built.
+
+        target : Optional[tvm.target.Target]
+            The target of the build.
+
+        tir_pipeline : Optional[Union[str, tvm.transform.Pass]]
+            The TIR compilation pipeline.
+
+        Returns
+        -------
+        libs : Optional[List[tvm.runtime.Module]]
+            The compiled module of each function, or None if the cache is not applicable.
+        """
+        if tir_pipeline is not None and not isinstance(tir_pipeline, str):
+            return None
+        if tir_mod.get_attr("system_lib_prefix") is not None:
+            return None
+        func_mods = _ffi_api.SplitTIRModule(tir_mod)  # type: ignore
+        if func_mods is None:
+            return None
+        if target is None:
+            target_pipeline = f"{tir_pipeline}"
+        else:
+            target_pipeline = f"{target}|{target.host}|{tir_pipeline}"
+        build_key = _ffi_api.FunctionBuildCacheMakeKey(target_pipeline)  # type: ignore
+        if build_key is None:
+            return None
+        libs = []
+        for func_mod in func_mods:
+            lib = _ffi_api.FunctionBuildCacheLookup(self, build_key, func_mod)  # type: ignore
+            if lib is None:
+                lib = tvm.tir.build(func_mod, target=target, pipeline=tir_pipeline)
+                _ffi_api.FunctionBuildCacheInsert(self, build_key, func_mod, lib)  # type: ignore
+            libs.append(lib)
+        return libs
+
+
 def _vmcodegen(
     builder: "relax.ExecBuilder",
     mod: tvm.IRModule,
@@ -108,6 +187,7 @@ def _vmlink(
     params: Optional[Dict[str, list]] = None,
     *,
     system_lib: Optional[bool] = None,
+    build_cache: Optional[FunctionBuildCache] = None,
 ):
     """
     Internal codegen function to make executable.
@@ -135,6 +215,9 @@ def _vmlink(
     params: Optional[Dict[str, list]]
         Extra parameter mappings.
 
+    build_cache: Optional[FunctionBuildCache]
+        The cache of the compiled TIR functions to reuse.
+
     Returns
     -------
     ex: tvm.relax.Executable
@@ -149,14 +232,21 @@ def _vmlink(
     lib = None
     relax_ext_libs = []
     tir_ext_libs = []
-    if tir_mod is not None and len(tir_mod.get_global_vars()) > 0:
-        tir_mod = _auto_attach_system_lib_prefix(tir_mod, target, system_lib)
-        lib = tvm.tir.build(tir_mod, target=target, pipeline=tir_pipeline)
     for ext_mod in ext_libs:
         if ext_mod.is_device_module:
             tir_ext_libs.append(ext_mod)
         else:
             relax_ext_libs.append(ext_mod)
+    if tir_mod is not None and len(tir_mod.get_global_vars()) > 0:
+        tir_mod = _auto_attach_system_lib_prefix(tir_mod, target, system_lib)
+        func_libs = None
+        if build_cache is not None and len(tir_ext_libs) == 0:
+            func_libs = build_cache.build(tir_mod, target, tir_pipeline)
+        if func_libs is not None:
+            # The compiled functions are imported by the executable, where the VM finds them.
+            relax_ext_libs.extend(func_libs)
+        else:
+            lib = tvm.tir.build(tir_mod, target=target, pipeline=tir_pipeline)
     if lib is not None:
         for mod in tir_ext_libs:
             lib.import_module(mod)
@@ -175,6 +265,7 @@ def build(
     exec_mode: str = "bytecode",
     *,
     system_lib: Optional[bool] = None,
+    build_cache: Optional[FunctionBuildCache] = None,
 ) -> Executable:
     """
     Build an IRModule to VM executable.
@@ -211,6 +302,10 @@ def build(
         auto registers generated functions to the system.
         By default auto detects based on the target.
 
+    build_cache: Optional[FunctionBuildCache]
+        The cache of the compiled TIR functions. When given, only the TIR functions not found
+        in the cache are lowered and compiled, and the compiled functions are added to it.
+
     Returns
     -------
     ex: tvm.relax.Executable
@@ -264,6 +359,7 @@ def build(
         ext_libs=ext_libs,
         params=params,
         system_lib=system_lib,
+        build_cache=build_cache,
     )
 
 
@@ -92,6 +92,23 @@ class RPCSession(object):
         dev._rpc_sess = self
         return dev
 
+    def set_copy_pipeline(self, block_bytes=1 << 22, window=4):
+        """Enable pipelined bulk transfer when copying arrays to the remote.
+
+        Large copies are split into blocks and up to ``window`` blocks are kept
+        in flight instead of waiting for one round trip per block. This helps
+        on high latency links, e.g. when uploading weights to a remote board.
+
+        Parameters
+        ----------
+        block_bytes : int
+            The maximum number of bytes per block.
+
+        window : int
+            The maximum number of blocks in flight. 1 disables pipelining.
+        """
+        _ffi_api.SessSetCopyPipeline(self._sess, block_bytes, window)
+
     def upload(self, data, target=None):
         """Upload file to remote runtime temp folder
 
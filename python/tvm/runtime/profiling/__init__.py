@@ -292,3 +292,30 @@ if _ffi.get_global_func("runtime.profiling.PAPIMetricCollector", allow_missing=T
             for dev, names in metric_names.items():
                 wrapped[DeviceWrapper(dev)] = names
             self.__init_handle_by_constructor__(_ffi_api.PAPIMetricCollector, wrapped)
+
+
+# We only enable this class when TVM is build with perf_event support
+if (
+    _ffi.get_global_func("runtime.profiling.PerfEventMetricCollector", allow_missing=True)
+    is not None
+):
+
+    @_ffi.register_object("runtime.profiling.PerfEventMetricCollector")
+    class PerfEventMetricCollector(MetricCollector):
+        """Collects CPU hardware performance counters using the Linux
+        ``perf_event_open`` interface. Does not require PAPI.
+        """
+
+        def __init__(self, metric_names: Optional[Sequence[str]] = None):
+            """
+            Parameters
+            ----------
+            metric_names : Optional[Sequence[str]]
+                Counters to collect, e.g. ``"cycles"``, ``"instructions"``,
+                ``"cache-misses"``, ``"branch-misses"``, ``"LLC-load-misses"``.
+                Defaults to cycles, instructions, cache misses and branch misses.
+                ``"IPC"`` is reported whenever cycles and instructions are
+                both collected.
+            """
+            metric_names = [] if metric_names is None else list(metric_names)
+            self.__init_handle_by_constructor__(_ffi_api.PerfEventMetricCollector, metric_names)
@@ -176,6 +176,29 @@ class Trace(Object):
             decision_provider,
         )
 
+    def apply_range_to_schedule(self, sch: "Schedule", begin: int, end: int) -> None:
+        """Apply the instructions in `[begin, end)` of the trace to a traced TensorIR schedule,
+        to which the instructions before `begin` have been applied. The first `begin`
+        instructions of the schedule's trace should correspond one by one to those of this trace,
+        so that the replay can be resumed on a copy of a schedule that another trace with the
+        same prefix has been applied to.
+
+        Parameters
+        ----------
+        sch : Schedule
+            The traced schedule to be applied onto
+        begin : int
+            The index of the first instruction to be applied
+        end : int
+            The index after the last instruction to be applied
+        """
+        _ffi_api.TraceApplyRangeToSchedule(  # type: ignore # pylint: disable=no-member
+            self,
+            sch,
+            begin,
+            end,
+        )
+
     def as_json(self, remove_postproc: bool = False) -> JSON_TYPE:
         """Serialize the trace as a JSON-style object
 
@@ -1437,7 +1437,9 @@ PrimExpr CanonicalSimplifier::Impl::VisitExpr_(const LTNode* op) {
 }
 
 PrimExpr CanonicalSimplifier::operator()(const PrimExpr& expr) {
-  return impl_->CanonicalSimplify(expr);
+  return impl_->MemoizedSimplify(expr, /*kind=*/1, [this](const PrimExpr& expr) {
+    return impl_->CanonicalSimplify(expr);
+  });
 }
 
 void CanonicalSimplifier::Update(const Var& var, const PrimExpr& info, bool override) {
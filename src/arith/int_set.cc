@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "constraint_extract.h"
 #include "interval_set.h"
@@ -1161,11 +1162,19 @@ Array<IntSet> EstimateRegionUpperBound(const Array<Range>& region, const Map<Var
   }
   Array<IntSet> result;
   result.reserve(region.size());
-  // try estimate each dimension independently
+  // try estimate each dimension independently, where the detection over the same domain and
+  // predicate is batched
+  Array<Array<PrimExpr>> indices_batch;
+  indices_batch.reserve(region.size());
   for (const Range& range : region) {
-    auto res = DetectIterMap(
-        /*indices=*/{range->min}, /*input_iters=*/var_dom,
-        /*predicate=*/predicate, /*check_level=*/IterMapLevel::Surjective, analyzer);
+    indices_batch.push_back({range->min});
+  }
+  std::vector<IterMapResult> iter_map_results = DetectIterMapBatch(
+      /*indices_batch=*/indices_batch, /*input_iters=*/var_dom,
+      /*predicate=*/predicate, /*check_level=*/IterMapLevel::Surjective, analyzer);
+  for (size_t i = 0; i < region.size(); ++i) {
+    const Range& range = region[i];
+    const IterMapResult& res = iter_map_results[i];
     if (!res->indices.empty()) {
       ICHECK_EQ(res->indices.size(), 1U);
       IterSumExpr sum_expr = res->indices[0];
@@ -29,7 +29,10 @@
 #include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <optional>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "../support/utils.h"
 #include "const_fold.h"
@@ -191,7 +194,7 @@ class IterMapRewriter : public ExprMutator {
                            Array<String>* errors)
       : analyzer_(analyzer),
         check_level_(check_level),
-        errors_(*errors),
+        errors_(errors),
         padding_predicate_(const_false()) {
     for (auto kv : input_iters) {
       const Var& var = kv.first;
@@ -214,6 +217,8 @@ class IterMapRewriter : public ExprMutator {
 
   PrimExpr padding_predicate() const { return padding_predicate_; }
   bool requires_padding() const { return requires_padding_; }
+  // Redirect the error messages, e.g. of a copy of the rewriter
+  void SetErrors(Array<String>* errors) { errors_ = errors; }
 
   IterSumExpr Rewrite(const PrimExpr& expr) {
     return NormalizeToIterWithOffset(ToIterSumExpr(DirectMutate(expr)));
@@ -384,7 +389,7 @@ class IterMapRewriter : public ExprMutator {
   class ErrorLogger {
    public:
     explicit ErrorLogger(IterMapRewriter* rewriter) : rewriter(rewriter) {}
-    ~ErrorLogger() { rewriter->errors_.push_back(os.str()); }
+    ~ErrorLogger() { rewriter->errors_->push_back(os.str()); }
 
     template <typename T>
     ErrorLogger& operator<<(T&& t) {
@@ -447,7 +452,7 @@ class IterMapRewriter : public ExprMutator {
   // Iter map check level
   IterMapLevel check_level_;
   // Error messages for each unresolved expression.
-  Array<String>& errors_;
+  Array<String>* errors_;
   // The var map
   std::unordered_map<Var, PrimExpr> var_map_;
   // input iter marks
@@ -1437,24 +1442,28 @@ bool IterRangeSanityCheck(const Map<Var, Range>& iter_ranges) {
   return true;
 }
 
-IterMapResult DetectIterMap(const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
-                            const PrimExpr& predicate, IterMapLevel check_level,
-                            arith::Analyzer* analyzer, bool simplify_trivial_iterators) {
-  IterMapResult result;
-
-  // Overall detection algorithm is divided into two steps:
-  // - Step0: IterMapRewriter rewrites the expression to use IterMapExpr patterns.
-  // - Step1: IterIndependenceChecker checks if the iterator are independent.
+/*!
+ * \brief Create the rewriter of DetectIterMap for the input iterators and the predicate, with
+ * the constraints of the predicate rewritten.
+ * \param errors The array to record the errors, which is also used by the rewriter.
+ * \return The rewriter, or std::nullopt with the errors recorded on failure.
+ */
+std::optional<IterMapRewriter> CreateIterMapRewriter(const Map<Var, Range>& input_iters,
+                                                     const PrimExpr& predicate,
+                                                     IterMapLevel check_level,
+                                                     arith::Analyzer* analyzer,
+                                                     bool simplify_trivial_iterators,
+                                                     Array<String>* errors) {
   if (!IterRangeSanityCheck(input_iters)) {
-    result->errors.push_back("Invalid iterators.  Iterators may not be expressions of each other.");
-    return result;
+    errors->push_back("Invalid iterators.  Iterators may not be expressions of each other.");
+    return std::nullopt;
   }
   Map<Var, Range> constrained_input_iters = input_iters;
   std::vector<IterConstraint> constraints;
   if (!is_one(predicate) &&
       !MatchBoundConstraints(predicate, &constrained_input_iters, &constraints)) {
-    result->errors.push_back("Could not parse predicate as constraints on the input iterators.");
-    return result;
+    errors->push_back("Could not parse predicate as constraints on the input iterators.");
+    return std::nullopt;
   }
   // We have to make sure when we visit an iterator, all the constraints related with its successors
   // in the iter var graph has been visited, where the expression of this iterator will contain the
@@ -1467,21 +1476,30 @@ IterMapResult DetectIterMap(const Array<PrimExpr>& indices, const Map<Var, Range
       constraints.begin(), constraints.end(),
       [](const IterConstraint& a, const IterConstraint& b) { return a.expr_size < b.expr_size; });
 
-  IterMapRewriter rewriter(analyzer, constrained_input_iters, check_level,
-                           simplify_trivial_iterators, &result->errors);
+  std::optional<IterMapRewriter> rewriter;
+  rewriter.emplace(analyzer, constrained_input_iters, check_level, simplify_trivial_iterators,
+                   errors);
   // Step0.0: rewrite constraints in the order from size-small ones to size-big ones
   for (const IterConstraint& constraint : constraints) {
-    auto res = rewriter.RewriteIterConstraint(constraint.iter, constraint.lower_bound,
-                                              constraint.upper_bound);
-    if (result->errors.size() > 0) {
-      return result;
+    auto res = rewriter->RewriteIterConstraint(constraint.iter, constraint.lower_bound,
+                                               constraint.upper_bound);
+    if (errors->size() > 0) {
+      return std::nullopt;
     }
   }
-  if (!rewriter.CheckConstraints()) {
-    result->errors.push_back("Invalid constraints.");
-    return result;
+  if (!rewriter->CheckConstraints()) {
+    errors->push_back("Invalid constraints.");
+    return std::nullopt;
   }
+  return rewriter;
+}
 
+/*!
+ * \brief Detect the iter map of the indices with the rewriter created by CreateIterMapRewriter.
+ * \param result The result to be filled, whose errors are recorded by the rewriter.
+ */
+void DetectIterMapWithRewriter(const Array<PrimExpr>& indices, IterMapLevel check_level,
+                               IterMapRewriter* rewriter, IterMapResult* result) {
   // Step0.1: Rewrite indicies and determine required padding,
   // if there is no padding, it should be the final result.
   Array<IterSumExpr> rewrite_indices;
@@ -1489,49 +1507,107 @@ IterMapResult DetectIterMap(const Array<PrimExpr>& indices, const Map<Var, Range
   bool allow_padding = check_level != IterMapLevel::Bijective;
   if (allow_padding) {
     for (PrimExpr value : indices) {
-      rewrite_indices.push_back(rewriter.RewriteAndUpdatePadding(value));
-      if (result->errors.size() > 0) {
-        return result;
+      rewrite_indices.push_back(rewriter->RewriteAndUpdatePadding(value));
+      if ((*result)->errors.size() > 0) {
+        return;
       }
     }
   }
 
   // Step0.2: Rewrite indices in the second round.
-  if (!allow_padding || rewriter.requires_padding()) {
+  if (!allow_padding || rewriter->requires_padding()) {
     rewrite_indices.clear();
     for (PrimExpr value : indices) {
-      rewrite_indices.push_back(rewriter.Rewrite(value));
-      if (result->errors.size() > 0) {
-        return result;
+      rewrite_indices.push_back(rewriter->Rewrite(value));
+      if ((*result)->errors.size() > 0) {
+        return;
       }
     }
   }
-  result->padding_predicate = rewriter.padding_predicate();
+  (*result)->padding_predicate = rewriter->padding_predicate();
   //
 
   // Step1: IterIndependenceChecker checks if the iterator are independent.
-  if (!rewriter.CheckMapping(rewrite_indices, check_level)) {
+  if (!rewriter->CheckMapping(rewrite_indices, check_level)) {
     if (check_level == IterMapLevel::Bijective) {
-      result->errors.push_back("Index mapping does not form a bijective transform.");
+      (*result)->errors.push_back("Index mapping does not form a bijective transform.");
     } else {
-      result->errors.push_back("Mapped indices are not independent.");
+      (*result)->errors.push_back("Mapped indices are not independent.");
     }
-    return result;
+    return;
+  }
+  (*result)->indices = rewrite_indices;
+}
+
+IterMapResult DetectIterMap(const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
+                            const PrimExpr& predicate, IterMapLevel check_level,
+                            arith::Analyzer* analyzer, bool simplify_trivial_iterators) {
+  IterMapResult result;
+
+  // Overall detection algorithm is divided into two steps:
+  // - Step0: IterMapRewriter rewrites the expression to use IterMapExpr patterns.
+  // - Step1: IterIndependenceChecker checks if the iterator are independent.
+  std::optional<IterMapRewriter> rewriter =
+      CreateIterMapRewriter(input_iters, predicate, check_level, analyzer,
+                            simplify_trivial_iterators, &result->errors);
+  if (rewriter.has_value()) {
+    DetectIterMapWithRewriter(indices, check_level, &rewriter.value(), &result);
   }
-  result->indices = rewrite_indices;
   return result;
 }
 
+std::vector<IterMapResult> DetectIterMapBatch(const Array<Array<PrimExpr>>& indices_batch,
+                                              const Map<Var, Range>& input_iters,
+                                              const PrimExpr& predicate, IterMapLevel check_level,
+                                              arith::Analyzer* analyzer,
+                                              bool simplify_trivial_iterators) {
+  Array<String> errors;
+  // The rewriter with the input iterators and the constraints of the predicate normalized, which
+  // is copied for each index tuple, as the padding of the iterators depends on the indices.
+  std::optional<IterMapRewriter> base_rewriter = CreateIterMapRewriter(
+      input_iters, predicate, check_level, analyzer, simplify_trivial_iterators, &errors);
+  std::unordered_map<Array<PrimExpr>, IterMapResult, StructuralHash, StructuralEqual> detected;
+  std::vector<IterMapResult> results;
+  results.reserve(indices_batch.size());
+  for (const Array<PrimExpr>& indices : indices_batch) {
+    auto it = detected.find(indices);
+    if (it != detected.end()) {
+      results.push_back(it->second);
+      continue;
+    }
+    IterMapResult result;
+    if (base_rewriter.has_value()) {
+      IterMapRewriter rewriter = base_rewriter.value();
+      rewriter.SetErrors(&result->errors);
+      DetectIterMapWithRewriter(indices, check_level, &rewriter, &result);
+    } else {
+      result->errors = errors;
+    }
+    detected.emplace(indices, result);
+    results.push_back(result);
+  }
+  return results;
+}
+
 TVM_FFI_STATIC_INIT_BLOCK({
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def(
-      "arith.DetectIterMap",
-      [](const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
-         const PrimExpr& input_pred, int check_level, bool simplify_trivial_iterators) {
-        arith::Analyzer ana;
-        return DetectIterMap(indices, input_iters, input_pred, IterMapLevel(check_level), &ana,
-                             simplify_trivial_iterators);
-      });
+  refl::GlobalDef()
+      .def("arith.DetectIterMap",
+           [](const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
+              const PrimExpr& input_pred, int check_level, bool simplify_trivial_iterators) {
+             arith::Analyzer ana;
+             return DetectIterMap(indices, input_iters, input_pred, IterMapLevel(check_level),
+                                  &ana, simplify_trivial_iterators);
+           })
+      .def("arith.DetectIterMapBatch",
+           [](const Array<Array<PrimExpr>>& indices_batch, const Map<Var, Range>& input_iters,
+              const PrimExpr& input_pred, int check_level, bool simplify_trivial_iterators) {
+             arith::Analyzer ana;
+             std::vector<IterMapResult> results =
+                 DetectIterMapBatch(indices_batch, input_iters, input_pred,
+                                    IterMapLevel(check_level), &ana, simplify_trivial_iterators);
+             return Array<ObjectRef>(results.begin(), results.end());
+           });
 });
 
 IterSumExpr NormalizeToIterSum(PrimExpr index, const Map<Var, Range>& input_iters,
@@ -30,6 +30,7 @@
 
 #include <algorithm>
 #include <tuple>
+#include <unordered_set>
 #include <utility>
 
 #include "../target/datatype/registry.h"
@@ -521,14 +522,84 @@ std::function<void()> RewriteSimplifier::Impl::EnterConstraint(const PrimExpr& c
     }
   }
   stats_.constraints_entered++;
+  entered_constraints_.push_back(constraint);
   size_t new_literal_size = literal_constraints_.size();
-  auto frecover = [old_literal_size, new_literal_size, this]() {
+  size_t new_entered_size = entered_constraints_.size();
+  auto frecover = [old_literal_size, new_literal_size, new_entered_size, this]() {
     ICHECK_EQ(literal_constraints_.size(), new_literal_size);
+    ICHECK_EQ(entered_constraints_.size(), new_entered_size);
     literal_constraints_.resize(old_literal_size);
+    entered_constraints_.pop_back();
   };
   return frecover;
 }
 
+Optional<ObjectRef> RewriteSimplifier::Impl::GetMemoKey(const PrimExpr& expr, int kind) const {
+  // Leaves are cheaper to simplify than to look up
+  if (expr->IsInstance<IntImmNode>() || expr->IsInstance<FloatImmNode>() ||
+      expr->IsInstance<VarNode>() || expr->IsInstance<StringImmNode>()) {
+    return std::nullopt;
+  }
+  std::vector<Var> vars;
+  std::unordered_set<const VarNode*> visited;
+  bool memoizable = true;
+  auto fcollect = [&](const ObjectRef& obj) {
+    if (const auto* var = obj.as<VarNode>()) {
+      if (visited.insert(var).second) {
+        vars.push_back(GetRef<Var>(var));
+      }
+    } else if (obj->IsInstance<LetNode>()) {
+      // The simplification of let binds the variable in the analyzer as a side effect
+      memoizable = false;
+    } else if (const auto* call = obj.as<CallNode>()) {
+      // The simplification of vscale depends on the current target
+      if (call->op.same_as(builtin::vscale())) {
+        memoizable = false;
+      }
+    }
+  };
+  PostOrderVisit(expr, fcollect);
+  if (!memoizable) {
+    return std::nullopt;
+  }
+  const Impl* rewriter = analyzer_->rewrite_simplify.impl_;
+  Array<PrimExpr> constraints(rewriter->entered_constraints_.begin(),
+                              rewriter->entered_constraints_.end());
+  for (const PrimExpr& constraint : constraints) {
+    PostOrderVisit(constraint, fcollect);
+  }
+  // The known information of the variables, as well as the variables they are bound to
+  Array<Any> var_info;
+  for (size_t i = 0; i < vars.size(); ++i) {
+    Var var = vars[i];
+    ConstIntBound bound = analyzer_->const_int_bound(var);
+    ModularSet modular = analyzer_->modular_set(var);
+    Optional<PrimExpr> value;
+    if (auto it = var_map_.find(var); it != var_map_.end()) {
+      value = it->second;
+      PostOrderVisit(it->second, fcollect);
+    }
+    Optional<Range> range = analyzer_->transitive_comparisons.GetBinding(var);
+    if (range.defined()) {
+      PostOrderVisit(range.value()->min, fcollect);
+      PostOrderVisit(range.value()->extent, fcollect);
+    }
+    var_info.push_back(var);
+    var_info.push_back(bound->min_value);
+    var_info.push_back(bound->max_value);
+    var_info.push_back(modular->coeff);
+    var_info.push_back(modular->base);
+    var_info.push_back(value);
+    var_info.push_back(range);
+  }
+  if (!memoizable) {
+    return std::nullopt;
+  }
+  return Array<Any>{kind, static_cast<int64_t>(enabled_extensions_),
+                    static_cast<int64_t>(rewriter->enabled_extensions_), expr, constraints,
+                    var_info};
+}
+
 void RewriteSimplifier::Impl::SetEnabledExtensions(Extension flags) { enabled_extensions_ = flags; }
 
 RewriteSimplifier::Extension RewriteSimplifier::Impl::GetEnabledExtensions() const {
@@ -2395,15 +2466,17 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const LetNode* op) {
 }
 
 PrimExpr RewriteSimplifier::operator()(const PrimExpr& expr) {
-  // Run simplification in post order
-  PrimExpr res = expr;
-  int max_iter = 2;
-  for (int i = 0; i < max_iter; ++i) {
-    PrimExpr new_expr = impl_->operator()(res);
-    if (new_expr.same_as(res)) return res;
-    res = new_expr;
-  }
-  return res;
+  return impl_->MemoizedSimplify(expr, /*kind=*/0, [this](const PrimExpr& expr) {
+    // Run simplification in post order
+    PrimExpr res = expr;
+    int max_iter = 2;
+    for (int i = 0; i < max_iter; ++i) {
+      PrimExpr new_expr = impl_->operator()(res);
+      if (new_expr.same_as(res)) return res;
+      res = new_expr;
+    }
+    return res;
+  });
 }
 
 void RewriteSimplifier::Update(const Var& var, const PrimExpr& info, bool allow_override) {
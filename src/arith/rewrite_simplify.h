@@ -29,12 +29,14 @@
 #include <tvm/tir/op.h>
 
 #include <algorithm>
+#include <chrono>
 #include <unordered_map>
 #include <vector>
 
 #include "const_fold.h"
 #include "ir_mutator_with_analyzer.h"
 #include "pattern_match.h"
+#include "simplify_memo.h"
 
 namespace tvm {
 namespace arith {
@@ -87,7 +89,8 @@ class RewriteSimplifier::Impl : public IRMutatorWithAnalyzer {
  public:
   using IRMutatorWithAnalyzer::VisitExpr_;
 
-  explicit Impl(Analyzer* parent) : IRMutatorWithAnalyzer(parent) {}
+  explicit Impl(Analyzer* parent)
+      : IRMutatorWithAnalyzer(parent), memo_(SimplifyMemo::Current()) {}
 
   PrimExpr VisitExpr(const PrimExpr& e) override;
 
@@ -134,6 +137,36 @@ class RewriteSimplifier::Impl : public IRMutatorWithAnalyzer {
 
   void SetMaximumRewriteSteps(int64_t maximum) { maximum_rewrite_steps_ = maximum; }
 
+  /*!
+   * \brief Simplify an expression with the simplification memo, if it is enabled.
+   * \param expr The expression to be simplified.
+   * \param kind The kind of the simplifier, which is part of the memo key.
+   * \param fsimplify The function that simplifies the expression without the memo.
+   * \return The simplified expression.
+   */
+  template <typename FSimplify>
+  PrimExpr MemoizedSimplify(const PrimExpr& expr, int kind, FSimplify fsimplify) {
+    if (!memo_.defined()) {
+      return fsimplify(expr);
+    }
+    using Clock = std::chrono::steady_clock;
+    auto seconds_since = [](Clock::time_point start) {
+      return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+    Clock::time_point start = Clock::now();
+    Optional<ObjectRef> key = GetMemoKey(expr, kind);
+    if (!key.defined()) {
+      return fsimplify(expr);
+    }
+    if (Optional<PrimExpr> result = memo_.value()->Lookup(key.value(), seconds_since(start))) {
+      return result.value();
+    }
+    start = Clock::now();
+    PrimExpr result = fsimplify(expr);
+    memo_.value()->Insert(key.value(), result, seconds_since(start));
+    return result;
+  }
+
  protected:
   int64_t maximum_rewrite_steps_{0};
   RewriteSimplifierStatsNode stats_;
@@ -154,6 +187,12 @@ class RewriteSimplifier::Impl : public IRMutatorWithAnalyzer {
 
   std::vector<PrimExpr> literal_constraints_;
 
+  // The constraints entered, as the context of the simplification memo
+  std::vector<PrimExpr> entered_constraints_;
+
+  // The simplification memo shared across analyzers, if enabled
+  Optional<SimplifyMemo> memo_;
+
   // Optionally enabled extensions
   Extension enabled_extensions_{kNone};
 
@@ -195,6 +234,15 @@ class RewriteSimplifier::Impl : public IRMutatorWithAnalyzer {
    */
   Optional<PrimExpr> TryMatchLiteralConstraint(const PrimExpr& expr) const;
 
+  /*!
+   * \brief Build the key of the simplification memo, which includes the expression and the
+   * context that the simplified result may depend on.
+   * \param expr The expression to be simplified.
+   * \param kind The kind of the simplifier.
+   * \return The key, or std::nullopt if the result should not be memoized.
+   */
+  Optional<ObjectRef> GetMemoKey(const PrimExpr& expr, int kind) const;
+
   /*! \brief Rewrite rules for Less Than comparisons
    *
    * These are separate from the VisitExpr_(const LTNode*) method, as
@@ -0,0 +1,104 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file simplify_memo.cc
+ * \brief The memo of simplification results shared across analyzers.
+ */
+#include "simplify_memo.h"
+
+#include <tvm/ir/transform.h>
+#include <tvm/node/repr_printer.h>
+
+namespace tvm {
+namespace arith {
+
+TVM_FFI_STATIC_INIT_BLOCK({ SimplifyMemoNode::RegisterReflection(); });
+
+TVM_REGISTER_PASS_CONFIG_OPTION("arith.simplify_memo", SimplifyMemo);
+
+Optional<PrimExpr> SimplifyMemoNode::Lookup(const ObjectRef& key, double overhead_seconds) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++num_lookups;
+  this->overhead_seconds += overhead_seconds;
+  auto it = table_.find(key);
+  if (it == table_.end()) {
+    return std::nullopt;
+  }
+  ++num_hits;
+  saved_seconds += it->second.seconds;
+  return it->second.result;
+}
+
+void SimplifyMemoNode::Insert(const ObjectRef& key, const PrimExpr& result, double seconds) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!table_.emplace(key, Entry{result, seconds}).second) {
+    // Inserted by another analyzer simplifying the same expression concurrently
+    return;
+  }
+  order_.push_back(key);
+  while (static_cast<int64_t>(order_.size()) > max_size) {
+    table_.erase(order_.front());
+    order_.pop_front();
+  }
+}
+
+int64_t SimplifyMemoNode::Size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return table_.size();
+}
+
+void SimplifyMemoNode::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  table_.clear();
+  order_.clear();
+  num_lookups = 0;
+  num_hits = 0;
+  saved_seconds = 0.0;
+  overhead_seconds = 0.0;
+}
+
+SimplifyMemo::SimplifyMemo(int64_t max_size) {
+  ICHECK_GT(max_size, 0) << "ValueError: The size of the simplification memo must be positive";
+  data_ = make_object<SimplifyMemoNode>(max_size);
+}
+
+Optional<SimplifyMemo> SimplifyMemo::Current() {
+  return transform::PassContext::Current()->GetConfig<SimplifyMemo>("arith.simplify_memo");
+}
+
+TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
+    .set_dispatch<SimplifyMemoNode>([](const ObjectRef& node, ReprPrinter* p) {
+      auto* ptr = node.as<SimplifyMemoNode>();
+      p->stream << "SimplifyMemo(max_size = " << ptr->max_size
+                << ", num_lookups = " << ptr->num_lookups << ", num_hits = " << ptr->num_hits
+                << ", saved_seconds = " << ptr->saved_seconds
+                << ", overhead_seconds = " << ptr->overhead_seconds << ")";
+    });
+
+TVM_FFI_STATIC_INIT_BLOCK({
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("arith.SimplifyMemo", [](int64_t max_size) { return SimplifyMemo(max_size); })
+      .def("arith.SimplifyMemoSize", [](SimplifyMemo memo) { return memo->Size(); })
+      .def("arith.SimplifyMemoClear", [](SimplifyMemo memo) { memo->Clear(); });
+});
+
+}  // namespace arith
+}  // namespace tvm
@@ -0,0 +1,126 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file simplify_memo.h
+ * \brief The memo of simplification results shared across analyzers.
+ */
+#ifndef TVM_ARITH_SIMPLIFY_MEMO_H_
+#define TVM_ARITH_SIMPLIFY_MEMO_H_
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
+#include <tvm/tir/expr.h>
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace tvm {
+namespace arith {
+
+/*!
+ * \brief A bounded memo of the results of RewriteSimplifier and CanonicalSimplifier.
+ *
+ * The memo is opt-in, and is shared by all the analyzers created under a PassContext with the
+ * "arith.simplify_memo" config. An entry is keyed structurally by the expression together with
+ * everything the result may depend on: the kind of the simplifier, the enabled extensions, the
+ * constraints entered, and the known information of the variables involved. The variables are
+ * compared by identity, so that a result is only reused for the same variables under the same
+ * context.
+ */
+class SimplifyMemoNode : public Object {
+ public:
+  /*! \brief The maximum number of entries, beyond which the oldest entries are evicted. */
+  int64_t max_size;
+  /*! \brief The number of lookups. */
+  int64_t num_lookups = 0;
+  /*! \brief The number of lookups that found the result. */
+  int64_t num_hits = 0;
+  /*! \brief The simplification time recorded for the results found by the lookups. */
+  double saved_seconds = 0.0;
+  /*! \brief The time spent on building the keys, looking up and inserting. */
+  double overhead_seconds = 0.0;
+
+  explicit SimplifyMemoNode(int64_t max_size) : max_size(max_size) {}
+
+  /*!
+   * \brief Look up the result of a simplification.
+   * \param key The key of the simplification.
+   * \param overhead_seconds The time spent on building the key.
+   * \return The simplified expression if it is in the memo.
+   */
+  Optional<PrimExpr> Lookup(const ObjectRef& key, double overhead_seconds);
+  /*!
+   * \brief Insert the result of a simplification.
+   * \param key The key of the simplification.
+   * \param result The simplified expression.
+   * \param seconds The time spent on the simplification.
+   */
+  void Insert(const ObjectRef& key, const PrimExpr& result, double seconds);
+  /*! \brief The number of entries. */
+  int64_t Size();
+  /*! \brief Remove all the entries and reset the statistics. */
+  void Clear();
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<SimplifyMemoNode>()
+        .def_ro("max_size", &SimplifyMemoNode::max_size)
+        .def_ro("num_lookups", &SimplifyMemoNode::num_lookups)
+        .def_ro("num_hits", &SimplifyMemoNode::num_hits)
+        .def_ro("saved_seconds", &SimplifyMemoNode::saved_seconds)
+        .def_ro("overhead_seconds", &SimplifyMemoNode::overhead_seconds);
+  }
+
+  static constexpr const char* _type_key = "arith.SimplifyMemo";
+  TVM_DECLARE_FINAL_OBJECT_INFO(SimplifyMemoNode, Object);
+
+ private:
+  struct Entry {
+    /*! \brief The simplified expression. */
+    PrimExpr result;
+    /*! \brief The time spent on the simplification. */
+    double seconds;
+  };
+  /*! \brief The mutex guarding the entries and the statistics. */
+  std::mutex mutex_;
+  /*! \brief The entries. */
+  std::unordered_map<ObjectRef, Entry, StructuralHash, StructuralEqual> table_;
+  /*! \brief The keys of the entries in the order of insertion. */
+  std::deque<ObjectRef> order_;
+};
+
+class SimplifyMemo : public ObjectRef {
+ public:
+  /*!
+   * \brief Create a simplification memo.
+   * \param max_size The maximum number of entries.
+   */
+  explicit SimplifyMemo(int64_t max_size);
+  /*! \brief The memo configured in the current PassContext, if any. */
+  static Optional<SimplifyMemo> Current();
+
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(SimplifyMemo, ObjectRef, SimplifyMemoNode);
+};
+
+}  // namespace arith
+}  // namespace tvm
+#endif  // TVM_ARITH_SIMPLIFY_MEMO_H_
@@ -82,6 +82,13 @@ class TransitiveComparisonAnalyzer::Impl {
    */
   std::function<void()> EnterConstraint(const PrimExpr& expr);
 
+  /*! \brief Get the range that a variable is bound to
+   *
+   * \param var The variable of interest.
+   * \return The bound range, or std::nullopt if the variable is not bound.
+   */
+  Optional<Range> GetBinding(const tir::Var& var) const { return prev_bindings_.Get(var); }
+
  private:
   /* \brief Internal representation of a PrimExpr
    *
@@ -540,6 +547,10 @@ void TransitiveComparisonAnalyzer::Bind(const Var& var, const Range& range, bool
   impl_->Bind(var, range, allow_override);
 }
 
+Optional<Range> TransitiveComparisonAnalyzer::GetBinding(const Var& var) const {
+  return impl_->GetBinding(var);
+}
+
 std::function<void()> TransitiveComparisonAnalyzer::EnterConstraint(const PrimExpr& constraint) {
   return impl_->EnterConstraint(constraint);
 }
@@ -40,6 +40,7 @@ String NameSupplyNode::ReserveName(const String& name, bool add_prefix) {
   if (add_prefix) {
     final_name = add_prefix_to_name(name);
   }
+  std::lock_guard<std::mutex> lock(name_map_mutex);
   name_map[final_name] = 0;
   return final_name;
 }
@@ -59,6 +60,7 @@ bool NameSupplyNode::ContainsName(const String& name, bool add_prefix) {
     unique_name = add_prefix_to_name(name);
   }
 
+  std::lock_guard<std::mutex> lock(name_map_mutex);
   return name_map.count(unique_name);
 }
 
@@ -76,6 +78,7 @@ std::string NameSupplyNode::GetUniqueName(std::string name, bool add_underscore)
   for (size_t i = 0; i < name.size(); ++i) {
     if (name[i] == '.') name[i] = '_';
   }
+  std::lock_guard<std::mutex> lock(name_map_mutex);
   auto it = name_map.find(name);
   if (it != name_map.end()) {
     auto new_name = name;
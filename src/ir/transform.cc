@@ -30,10 +30,16 @@
 #include <tvm/node/structural_hash.h>
 #include <tvm/relax/expr.h>
 #include <tvm/runtime/device_api.h>
+#include <tvm/support/parallel_for.h>
+#include <tvm/target/target.h>
 
+#include <algorithm>
 #include <chrono>
+#include <exception>
 #include <iomanip>
+#include <optional>
 #include <stack>
+#include <thread>
 #include <unordered_set>
 
 #include "../runtime/regex.h"
@@ -46,6 +52,7 @@ using tvm::ffi::Any;
 using tvm::ffi::PackedArgs;
 
 TVM_REGISTER_PASS_CONFIG_OPTION("testing.immutable_module", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("ir.num_function_pass_threads", Integer);
 
 struct PassContextThreadLocalEntry {
   /*! \brief The default pass context. */
@@ -85,6 +92,58 @@ PassContext PassContext::Current() {
   }
 }
 
+int GetFunctionPassNumThreads(const PassContext& pass_ctx) {
+  int64_t num_threads =
+      pass_ctx->GetConfig<Integer>("ir.num_function_pass_threads", Integer(1)).value()->value;
+  if (num_threads <= 0) {
+    num_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  return static_cast<int>(num_threads);
+}
+
+void RunFunctionPassTasks(const PassContext& pass_ctx, int num_threads, int num_tasks,
+                          const std::function<void(int)>& ftask) {
+  num_threads = std::min(num_threads, num_tasks);
+  if (num_threads <= 1) {
+    for (int i = 0; i < num_tasks; ++i) {
+      ftask(i);
+    }
+    return;
+  }
+  Optional<Target> target = Target::Current(/*allow_not_defined=*/true);
+  std::vector<std::exception_ptr> errors(num_tasks);
+  support::parallel_for_dynamic(0, num_tasks, num_threads, [&](int thread_id, int task_id) {
+    try {
+      if (thread_id == 0) {
+        // Worker 0 runs on the calling thread, which already has the context.
+        ftask(task_id);
+        return;
+      }
+      // Make the pass context current for this worker, without the
+      // instrument callbacks of PassContext::EnterWithScope.
+      std::stack<PassContext>& context_stack =
+          RelayPassContextThreadLocalStore::Get()->context_stack;
+      context_stack.push(pass_ctx);
+      struct PopOnExit {
+        std::stack<PassContext>* stack;
+        ~PopOnExit() { stack->pop(); }
+      } pop_on_exit{&context_stack};
+      std::optional<With<Target>> target_scope;
+      if (target.defined()) {
+        target_scope.emplace(target.value());
+      }
+      ftask(task_id);
+    } catch (...) {
+      errors[task_id] = std::current_exception();
+    }
+  });
+  for (const std::exception_ptr& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
 // linearly scan the pass array to match pass_name
 bool PassArrayContains(const Array<String>& pass_array, const std::string& pass_name) {
   for (auto x : pass_array) {
@@ -18,6 +18,9 @@
  */
 #include <tvm/ffi/reflection/registry.h>
 
+#include <cmath>
+
+#include "../feature_extractor/per_store_feature.h"
 #include "../module_equality.h"
 #include "../utils.h"
 
@@ -121,8 +124,8 @@ bool TuningRecordNode::IsValid() const {
   }
   if (run_secs.defined()) {
     for (const auto& run_sec : run_secs.value()) {
-      // kMaxMeanTime(1e10) is used as a stub for undefined measurement times.
-      if (run_sec.defined() && run_sec->value != SortTuningRecordByMeanRunSecs::kMaxMeanTime) {
+      // kMaxRunTime(1e10) is used as a stub for undefined measurement times.
+      if (run_sec.defined() && run_sec->value != RunSecsStatistics::kMaxRunTime) {
         return true;
       }
     }
@@ -176,17 +179,76 @@ TuningRecord TuningRecord::FromJSON(const ObjectRef& json_obj, const Workload& w
 DatabaseNode::DatabaseNode(String mod_eq_name) { mod_eq_ = ModuleEquality::Create(mod_eq_name); }
 DatabaseNode::~DatabaseNode() = default;
 
+/*!
+ * \brief A cheap signature of a trace, from the kinds of its instructions and its decisions.
+ * Equal traces have equal signatures, so only the traces whose signatures collide need a full
+ * comparison.
+ */
+static uint64_t TraceSignature(const tir::Trace& trace) {
+  uint64_t signature = trace->insts.size();
+  for (const tir::Instruction& inst : trace->insts) {
+    signature = support::HashCombine(signature, StructuralHash()(std::string(inst->kind->name)));
+    signature = support::HashCombine(signature, StructuralHash()(trace->GetDecision(inst)));
+  }
+  return signature;
+}
+
 Optional<TuningRecord> DatabaseNode::QueryTuningRecord(const IRModule& mod, const Target& target,
                                                        const String& workload_name) {
   if (!this->HasWorkload(mod)) {
     return std::nullopt;
   }
-  Array<TuningRecord> records = this->GetTopK(this->CommitWorkload(mod), 1);
+  // The same schedule may be measured several times, e.g. when it is re-measured head-to-head
+  // against the candidates within the noise of it. The samples of the same trace among the best
+  // records are pooled, so that the pick is made on the median of all of its measurements.
+  static constexpr int kNumPooledRecords = 32;
+  Array<TuningRecord> records = this->GetTopK(this->CommitWorkload(mod), kNumPooledRecords);
   if (records.empty()) {
     return std::nullopt;
   }
-  ICHECK_EQ(records.size(), 1);
-  return records[0];
+  // The traces are only serialized to be compared when their signatures collide, which is rare
+  // unless the same trace was measured several times.
+  std::vector<uint64_t> signatures;
+  std::unordered_map<uint64_t, int> signature_counts;
+  for (const TuningRecord& record : records) {
+    signatures.push_back(TraceSignature(record->trace));
+    ++signature_counts[signatures.back()];
+  }
+  std::vector<std::string> keys;
+  std::unordered_map<std::string, std::vector<TuningRecord>> groups;
+  for (size_t i = 0; i < records.size(); ++i) {
+    const TuningRecord& record = records[i];
+    std::string key = signature_counts.at(signatures[i]) == 1
+                          ? std::to_string(signatures[i])
+                          : JSONDumps(record->trace->AsJSON(/*remove_postproc=*/false));
+    std::vector<TuningRecord>& group = groups[key];
+    if (group.empty()) {
+      keys.push_back(key);
+    }
+    group.push_back(record);
+  }
+  Optional<TuningRecord> best = std::nullopt;
+  double best_median = RunSecsStatistics::kMaxRunTime;
+  for (const std::string& key : keys) {
+    const std::vector<TuningRecord>& group = groups.at(key);
+    TuningRecord pooled = group[0];
+    if (group.size() > 1) {
+      Array<FloatImm> run_secs;
+      for (const TuningRecord& record : group) {
+        for (const FloatImm& run_sec : record->run_secs.value_or({})) {
+          run_secs.push_back(run_sec);
+        }
+      }
+      pooled = TuningRecord(pooled->trace, pooled->workload, run_secs, pooled->target,
+                            pooled->args_info);
+    }
+    double median = RunSecsStatistics(pooled->run_secs.value_or({})).median;
+    if (!best.defined() || median < best_median) {
+      best = pooled;
+      best_median = median;
+    }
+  }
+  return best;
 }
 
 Optional<tir::Schedule> DatabaseNode::QuerySchedule(const IRModule& mod, const Target& target,
@@ -212,6 +274,45 @@ Optional<IRModule> DatabaseNode::QueryIRModule(const IRModule& mod, const Target
   }
 }
 
+Array<TuningRecord> DatabaseNode::QueryNearestTuningRecords(const IRModule& mod,
+                                                            const Target& target, int top_k) {
+  CHECK_GE(top_k, 0) << "ValueError: top_k must be non-negative";
+  std::unordered_map<Workload, TuningRecord, ObjectPtrHash, ObjectPtrEqual> workload2record;
+  for (const TuningRecord& record : this->GetAllTuningRecords()) {
+    if (!record->IsValid() || !record->target.defined() ||
+        record->target.value()->kind->name != target->kind->name) {
+      continue;
+    }
+    auto it = workload2record.find(record->workload);
+    if (it == workload2record.end()) {
+      workload2record.insert({record->workload, record});
+    } else if (SortTuningRecordByRunSecs()(record, it->second)) {
+      it->second = record;
+    }
+  }
+  std::vector<double> embedding = ExtractWorkloadEmbedding(mod);
+  std::vector<std::pair<double, TuningRecord>> candidates;
+  for (const auto& kv : workload2record) {
+    const IRModule& workload_mod = kv.first->mod;
+    double distance = WorkloadEmbeddingDistance(embedding, ExtractWorkloadEmbedding(workload_mod));
+    if (std::isinf(distance) || GetModuleEquality().Equal(mod, workload_mod)) {
+      continue;
+    }
+    candidates.emplace_back(distance, kv.second);
+  }
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const std::pair<double, TuningRecord>& a,
+                      const std::pair<double, TuningRecord>& b) { return a.first < b.first; });
+  Array<TuningRecord> results;
+  for (const auto& kv : candidates) {
+    if (static_cast<int>(results.size()) == top_k) {
+      break;
+    }
+    results.push_back(kv.second);
+  }
+  return results;
+}
+
 void DatabaseNode::DumpPruned(Database destination) {
   std::unordered_map<Workload, TuningRecord, ObjectPtrHash, ObjectPtrEqual> workload2record;
   for (const TuningRecord& record : this->GetAllTuningRecords()) {
@@ -219,7 +320,7 @@ void DatabaseNode::DumpPruned(Database destination) {
       auto it = workload2record.find(record->workload);
       if (it == workload2record.end()) {
         workload2record.insert({record->workload, record});
-      } else if (SortTuningRecordByMeanRunSecs()(record, it->second)) {
+      } else if (SortTuningRecordByRunSecs()(record, it->second)) {
         it->second = record;
       }
     }
@@ -300,6 +401,15 @@ TVM_FFI_STATIC_INIT_BLOCK({
       .def_method("meta_schedule.TuningRecordAsMeasureCandidate",
                   &TuningRecordNode::AsMeasureCandidate)
       .def_method("meta_schedule.TuningRecordAsJSON", &TuningRecordNode::AsJSON)
+      .def("meta_schedule.TuningRecordRunSecsStatistics",
+           [](TuningRecord record) -> Map<String, FloatImm> {
+             RunSecsStatistics stats(record->run_secs.value_or({}));
+             return {{"count", FloatImm(DataType::Float(64), stats.count)},
+                     {"median", FloatImm(DataType::Float(64), stats.median)},
+                     {"p10", FloatImm(DataType::Float(64), stats.p10)},
+                     {"p90", FloatImm(DataType::Float(64), stats.p90)},
+                     {"variance", FloatImm(DataType::Float(64), stats.variance)}};
+           })
       .def("meta_schedule.TuningRecordFromJSON", TuningRecord::FromJSON)
       .def_method("meta_schedule.DatabaseEnterWithScope", &Database::EnterWithScope)
       .def_method("meta_schedule.DatabaseExitWithScope", &Database::ExitWithScope)
@@ -313,6 +423,8 @@ TVM_FFI_STATIC_INIT_BLOCK({
       .def_method("meta_schedule.DatabaseQueryTuningRecord", &DatabaseNode::QueryTuningRecord)
       .def_method("meta_schedule.DatabaseQuerySchedule", &DatabaseNode::QuerySchedule)
       .def_method("meta_schedule.DatabaseQueryIRModule", &DatabaseNode::QueryIRModule)
+      .def_method("meta_schedule.DatabaseQueryNearestTuningRecords",
+                  &DatabaseNode::QueryNearestTuningRecords)
       .def_method("meta_schedule.DatabaseDumpPruned", &DatabaseNode::DumpPruned)
       .def("meta_schedule.DatabasePyDatabase", Database::PyDatabase);
 });
@@ -81,7 +81,7 @@ class JSONDatabaseNode : public DatabaseNode {
   /*! \brief All the workloads in the database */
   std::unordered_map<Workload, int, WorkloadHash, WorkloadEqual> workloads2idx_;
   /*! \brief All the tuning records in the database */
-  std::multiset<TuningRecord, SortTuningRecordByMeanRunSecs> tuning_records_;
+  TuningRecordsByRunSecs tuning_records_;
 
   static void RegisterReflection() {
     namespace refl = tvm::ffi::reflection;
@@ -113,7 +113,7 @@ class JSONDatabaseNode : public DatabaseNode {
   }
 
   void CommitTuningRecord(const TuningRecord& record) {
-    this->tuning_records_.insert(record);
+    this->tuning_records_.emplace(MedianRunSecs(record), record);
     JSONFileAppendLine(this->path_tuning_record,
                        JSONDumps(Array<Any>{
                            /*workload_index=*/Integer(this->workloads2idx_.at(record->workload)),
@@ -128,7 +128,7 @@ class JSONDatabaseNode : public DatabaseNode {
     }
     Array<TuningRecord> results;
     results.reserve(top_k);
-    for (const TuningRecord& record : this->tuning_records_) {
+    for (const auto& [median, record] : this->tuning_records_) {
       auto run_secs = record->run_secs;
       if (!record->IsValid()) {
         continue;
@@ -147,7 +147,7 @@ class JSONDatabaseNode : public DatabaseNode {
   Array<TuningRecord> GetAllTuningRecords() {
     Array<TuningRecord> results;
     results.reserve(Size());
-    for (const TuningRecord& record : this->tuning_records_) {
+    for (const auto& [median, record] : this->tuning_records_) {
       results.push_back(record);
     }
     return results;
@@ -207,7 +207,7 @@ Database Database::JSONDatabase(String path_workload, String path_tuning_record,
           }
         });
     for (const TuningRecord& record : records) {
-      n->tuning_records_.insert(record);
+      n->tuning_records_.emplace(MedianRunSecs(record), record);
     }
   }
   n->path_workload = path_workload;
@@ -80,7 +80,7 @@ class MemoryDatabaseNode : public DatabaseNode {
         results.emplace_back(record);
       }
     }
-    std::stable_sort(results.begin(), results.end(), SortTuningRecordByMeanRunSecs());
+    SortTuningRecordsByRunSecs(&results);
     if (results.size() > static_cast<size_t>(top_k)) {
       return {results.begin(), results.begin() + top_k};
     } else {
@@ -0,0 +1,412 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <tvm/ffi/reflection/registry.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+#include "../module_equality.h"
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief An append-only file of json lines shared by multiple processes. The lines are appended
+ * with a single write under an exclusive file lock, and read incrementally from the offset read
+ * so far under a shared file lock.
+ */
+class SharedJSONFile {
+ public:
+  explicit SharedJSONFile(const std::string& path) : path_(path) {
+#ifdef _WIN32
+    LOG(FATAL) << "SharedDatabase is not supported on Windows";
+#else
+    fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    CHECK_GE(fd_, 0) << "ValueError: Cannot open the file: " << path << ", " << strerror(errno);
+#endif
+  }
+
+  ~SharedJSONFile() {
+#ifndef _WIN32
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+#endif
+  }
+
+  SharedJSONFile(const SharedJSONFile&) = delete;
+  SharedJSONFile& operator=(const SharedJSONFile&) = delete;
+
+  /*! \brief The file lock held in a scope. */
+  class Lock {
+   public:
+    Lock(SharedJSONFile* file, bool exclusive) : file_(file) {
+#ifndef _WIN32
+      int ret;
+      do {
+        ret = flock(file_->fd_, exclusive ? LOCK_EX : LOCK_SH);
+      } while (ret != 0 && errno == EINTR);
+      CHECK_EQ(ret, 0) << "ValueError: Cannot lock the file: " << file_->path_ << ", "
+                       << strerror(errno);
+#endif
+    }
+
+    ~Lock() {
+#ifndef _WIN32
+      flock(file_->fd_, LOCK_UN);
+#endif
+    }
+
+   private:
+    SharedJSONFile* file_;
+  };
+
+  /*!
+   * \brief Append a line to the file. The caller must hold the exclusive lock.
+   * \param line The line to append.
+   */
+  void AppendLine(const std::string& line) {
+#ifndef _WIN32
+    std::string data = line + "\n";
+    const char* ptr = data.data();
+    size_t remaining = data.size();
+    while (remaining > 0) {
+      ssize_t n = write(fd_, ptr, remaining);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      CHECK_GT(n, 0) << "ValueError: Cannot write to the file: " << path_ << ", "
+                     << strerror(errno);
+      ptr += n;
+      remaining -= n;
+    }
+#endif
+  }
+
+  /*!
+   * \brief Read the complete lines appended since the last read. The caller must hold a lock.
+   * \return The lines read.
+   */
+  std::vector<std::string> ReadNewLines() {
+    std::vector<std::string> lines;
+#ifndef _WIN32
+    std::string data;
+    char buffer[1 << 16];
+    for (;;) {
+      ssize_t n = pread(fd_, buffer, sizeof(buffer), offset_ + data.size());
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      CHECK_GE(n, 0) << "ValueError: Cannot read the file: " << path_ << ", " << strerror(errno);
+      if (n == 0) {
+        break;
+      }
+      data.append(buffer, n);
+    }
+    size_t begin = 0;
+    for (size_t end; (end = data.find('\n', begin)) != std::string::npos; begin = end + 1) {
+      if (end > begin) {
+        lines.emplace_back(data, begin, end - begin);
+      }
+    }
+    // An incomplete line is left to the next read
+    offset_ += begin;
+#endif
+    return lines;
+  }
+
+ private:
+  /*! \brief The path to the file. */
+  std::string path_;
+  /*! \brief The file descriptor. */
+  int fd_ = -1;
+  /*! \brief The offset up to which the file is read. */
+  int64_t offset_ = 0;
+};
+
+/*!
+ * \brief A database shared by multiple local processes, e.g. the parallel tuning jobs on a host.
+ *
+ * The workloads and the tuning records are stored in the same two files as JSONDatabase, which
+ * all the processes append to under file locks, so that the index of a workload is its line
+ * number in the workload file for every process. Each process keeps the records in memory,
+ * sharded by the workload so that concurrent commits and queries of different workloads do not
+ * contend, and catches up with the records appended by the other processes before each query.
+ */
+class SharedDatabaseNode : public DatabaseNode {
+ public:
+  explicit SharedDatabaseNode(String path_workload, String path_tuning_record, int num_shards,
+                              String mod_eq_name)
+      : DatabaseNode(mod_eq_name),
+        path_workload(path_workload),
+        path_tuning_record(path_tuning_record),
+        num_shards(num_shards),
+        workload_file_(path_workload),
+        record_file_(path_tuning_record),
+        workloads2idx_(/*bucket_count*/ 0, WorkloadHash(), WorkloadEqual(GetModuleEquality())) {
+    shards_.reserve(num_shards);
+    for (int i = 0; i < num_shards; ++i) {
+      shards_.push_back(std::make_unique<Shard>());
+    }
+  }
+
+  /*! \brief The path to the workload table */
+  String path_workload;
+  /*! \brief The path to the tuning record table */
+  String path_tuning_record;
+  /*! \brief The number of shards of the tuning records in memory */
+  int num_shards;
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<SharedDatabaseNode>()
+        .def_ro("path_workload", &SharedDatabaseNode::path_workload)
+        .def_ro("path_tuning_record", &SharedDatabaseNode::path_tuning_record)
+        .def_ro("num_shards", &SharedDatabaseNode::num_shards);
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.SharedDatabase";
+  TVM_DECLARE_FINAL_OBJECT_INFO(SharedDatabaseNode, DatabaseNode);
+
+ public:
+  bool HasWorkload(const IRModule& mod) {
+    std::lock_guard<std::mutex> lock(workload_mutex_);
+    SharedJSONFile::Lock file_lock(&workload_file_, /*exclusive=*/false);
+    SyncWorkloads();
+    return workloads2idx_.count(Workload(mod, GetModuleEquality().Hash(mod)));
+  }
+
+  Workload CommitWorkload(const IRModule& mod) {
+    Workload workload(mod, GetModuleEquality().Hash(mod));
+    std::lock_guard<std::mutex> lock(workload_mutex_);
+    {
+      SharedJSONFile::Lock file_lock(&workload_file_, /*exclusive=*/false);
+      SyncWorkloads();
+      auto it = workloads2idx_.find(workload);
+      if (it != workloads2idx_.end()) {
+        return it->first;
+      }
+    }
+    // Check again under the exclusive lock, in case another process appended the workload
+    SharedJSONFile::Lock file_lock(&workload_file_, /*exclusive=*/true);
+    SyncWorkloads();
+    auto it = workloads2idx_.find(workload);
+    if (it == workloads2idx_.end()) {
+      workload_file_.AppendLine(JSONDumps(workload->AsJSON()));
+      SyncWorkloads();
+      it = workloads2idx_.find(workload);
+      ICHECK(it != workloads2idx_.end());
+    }
+    return it->first;
+  }
+
+  void CommitTuningRecord(const TuningRecord& record) {
+    int workload_index = GetWorkloadIndex(record->workload);
+    CHECK_GE(workload_index, 0) << "ValueError: The workload of the tuning record is not committed";
+    std::string line = JSONDumps(Array<Any>{
+        /*workload_index=*/Integer(workload_index),
+        /*tuning_record=*/record->AsJSON()  //
+    });
+    {
+      std::lock_guard<std::mutex> lock(record_mutex_);
+      SharedJSONFile::Lock file_lock(&record_file_, /*exclusive=*/true);
+      record_file_.AppendLine(line);
+      // The record is read back together with the records appended by the other processes
+      SyncRecords();
+    }
+  }
+
+  Array<TuningRecord> GetTopK(const Workload& workload, int top_k) {
+    CHECK_GE(top_k, 0) << "ValueError: top_k must be non-negative";
+    if (top_k == 0) {
+      return {};
+    }
+    Sync();
+    int workload_index = GetWorkloadIndex(workload);
+    if (workload_index < 0) {
+      return {};
+    }
+    Shard* shard = shards_[workload_index % num_shards].get();
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    auto it = shard->records.find(workload_index);
+    if (it == shard->records.end()) {
+      return {};
+    }
+    Array<TuningRecord> results;
+    for (const auto& [median, record] : it->second) {
+      if (!record->IsValid()) {
+        continue;
+      }
+      results.push_back(record);
+      if (results.size() == static_cast<size_t>(top_k)) {
+        break;
+      }
+    }
+    return results;
+  }
+
+  Array<TuningRecord> GetAllTuningRecords() {
+    Sync();
+    std::vector<TuningRecord> results;
+    for (const std::unique_ptr<Shard>& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      for (const auto& [workload_index, records] : shard->records) {
+        for (const auto& [median, record] : records) {
+          results.push_back(record);
+        }
+      }
+    }
+    SortTuningRecordsByRunSecs(&results);
+    return Array<TuningRecord>(results.begin(), results.end());
+  }
+
+  int64_t Size() {
+    Sync();
+    int64_t size = 0;
+    for (const std::unique_ptr<Shard>& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      size += shard->size;
+    }
+    return size;
+  }
+
+  /*! \brief Catch up with the workloads and the records appended by the other processes. */
+  void Sync() {
+    std::lock_guard<std::mutex> lock(record_mutex_);
+    SharedJSONFile::Lock file_lock(&record_file_, /*exclusive=*/false);
+    SyncRecords();
+  }
+
+ private:
+  /*! \brief A shard of the tuning records. */
+  struct Shard {
+    /*! \brief The mutex guarding the shard. */
+    std::mutex mutex;
+    /*! \brief The records of each workload index, sorted by the running time. */
+    std::unordered_map<int, TuningRecordsByRunSecs> records;
+    /*! \brief The number of records in the shard. */
+    int64_t size = 0;
+  };
+
+  /*!
+   * \brief Get the index of a workload.
+   * \param workload The workload.
+   * \return The index, or -1 if the workload is not in the database.
+   */
+  int GetWorkloadIndex(const Workload& workload) {
+    std::lock_guard<std::mutex> lock(workload_mutex_);
+    auto it = workloads2idx_.find(workload);
+    if (it == workloads2idx_.end()) {
+      SharedJSONFile::Lock file_lock(&workload_file_, /*exclusive=*/false);
+      SyncWorkloads();
+      it = workloads2idx_.find(workload);
+    }
+    return it == workloads2idx_.end() ? -1 : it->second;
+  }
+
+  /*! \brief Read the new workloads. The caller must hold the workload mutex and file lock. */
+  void SyncWorkloads() {
+    for (const std::string& line : workload_file_.ReadNewLines()) {
+      Workload workload = Workload::FromJSON(JSONLoads(line).cast<ObjectRef>());
+      auto recalc_hash = GetModuleEquality().Hash(workload->mod);
+      if (recalc_hash != workload->shash) {
+        ObjectPtr<WorkloadNode> wkl = make_object<WorkloadNode>(*workload.get());
+        wkl->shash = recalc_hash;
+        workload = Workload(wkl);
+      }
+      workloads2idx_.emplace(workload, workloads_.size());
+      workloads_.push_back(workload);
+    }
+  }
+
+  /*! \brief Read the new records. The caller must hold the record mutex and file lock. */
+  void SyncRecords() {
+    std::vector<std::string> lines = record_file_.ReadNewLines();
+    if (lines.empty()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(workload_mutex_);
+    for (const std::string& line : lines) {
+      Array<Any> arr = JSONLoads(line).cast<Array<Any>>();
+      ICHECK_EQ(arr.size(), 2);
+      int workload_index = arr[0].cast<IntImm>()->value;
+      if (static_cast<size_t>(workload_index) >= workloads_.size()) {
+        // The workload is appended by another process before the record
+        SharedJSONFile::Lock file_lock(&workload_file_, /*exclusive=*/false);
+        SyncWorkloads();
+      }
+      ICHECK(workload_index >= 0 && static_cast<size_t>(workload_index) < workloads_.size())
+          << "ValueError: Invalid workload index " << workload_index << " in the file "
+          << path_tuning_record;
+      TuningRecord record =
+          TuningRecord::FromJSON(arr[1].cast<ObjectRef>(), workloads_[workload_index]);
+      Shard* shard = shards_[workload_index % num_shards].get();
+      std::lock_guard<std::mutex> shard_lock(shard->mutex);
+      shard->records[workload_index].emplace(MedianRunSecs(record), record);
+      ++shard->size;
+    }
+  }
+
+  /*! \brief The shared workload file. */
+  SharedJSONFile workload_file_;
+  /*! \brief The shared tuning record file. */
+  SharedJSONFile record_file_;
+  /*! \brief The mutex guarding the workloads and the reads of the workload file. */
+  std::mutex workload_mutex_;
+  /*! \brief The mutex guarding the reads of the tuning record file. */
+  std::mutex record_mutex_;
+  /*! \brief The index of each workload, i.e. its line number in the workload file. */
+  std::unordered_map<Workload, int, WorkloadHash, WorkloadEqual> workloads2idx_;
+  /*! \brief The workloads in the order of the workload file. */
+  std::vector<Workload> workloads_;
+  /*! \brief The shards of the tuning records, by the workload index. */
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+Database Database::SharedDatabase(String path_workload, String path_tuning_record,
+                                  int num_shards, String mod_eq_name) {
+  CHECK_GT(num_shards, 0) << "ValueError: num_shards must be positive";
+  ObjectPtr<SharedDatabaseNode> n =
+      make_object<SharedDatabaseNode>(path_workload, path_tuning_record, num_shards, mod_eq_name);
+  n->Sync();
+  return Database(n);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK({ SharedDatabaseNode::RegisterReflection(); });
+
+TVM_FFI_STATIC_INIT_BLOCK({
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("meta_schedule.DatabaseSharedDatabase", Database::SharedDatabase)
+      .def_method("meta_schedule.SharedDatabaseSync", &SharedDatabaseNode::Sync);
+});
+
+}  // namespace meta_schedule
+}  // namespace tvm
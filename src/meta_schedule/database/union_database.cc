@@ -45,7 +45,7 @@ class UnionDatabaseNode : public DatabaseNode {
         results.push_back(record.value());
       }
     }
-    std::stable_sort(results.begin(), results.end(), SortTuningRecordByMeanRunSecs());
+    SortTuningRecordsByRunSecs(&results);
     return results.empty() ? Optional<TuningRecord>(std::nullopt) : results[0];
   }
 
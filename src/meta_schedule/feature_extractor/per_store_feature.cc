@@ -17,6 +17,7 @@
  * under the License.
  */
 #include <tvm/ffi/reflection/registry.h>
+#include <tvm/tir/analysis.h>
 #include <tvm/tir/transform.h>
 
 #include <cmath>
@@ -28,6 +29,7 @@
 #include <vector>
 
 #include "../utils.h"
+#include "./per_store_feature.h"
 
 namespace tvm {
 namespace tir {
@@ -1446,6 +1448,45 @@ FeatureExtractor FeatureExtractor::PerStoreFeature(int buffers_per_store,
   return FeatureExtractor(n);
 }
 
+std::vector<double> ExtractWorkloadEmbedding(const IRModule& mod) {
+  std::vector<double> embedding = tir::group6::WorkloadEmbeddingExtractor::Extract(mod);
+  const tir::BlockNode* anchor_block = tir::FindAnchorBlock(mod);
+  if (anchor_block == nullptr) {
+    embedding.push_back(0.0);
+    embedding.push_back(0.0);
+    return embedding;
+  }
+  int64_t num_spatial = 0;
+  int64_t num_reduction = 0;
+  std::vector<double> extents;
+  for (const tir::IterVar& iter_var : anchor_block->iter_vars) {
+    if (iter_var->iter_type == tir::IterVarType::kDataPar) {
+      ++num_spatial;
+    } else {
+      ++num_reduction;
+    }
+    const auto* extent = iter_var->dom->extent.as<IntImmNode>();
+    extents.push_back(extent != nullptr ? tir::slog(extent->value) : -1.0);
+  }
+  embedding.push_back(num_spatial);
+  embedding.push_back(num_reduction);
+  embedding.insert(embedding.end(), extents.begin(), extents.end());
+  return embedding;
+}
+
+double WorkloadEmbeddingDistance(const std::vector<double>& a, const std::vector<double>& b) {
+  // The kind of the workload and the number of iterators of each type must match
+  constexpr int64_t kNumKindDims = tir::group6::Feature::kCount + 2;
+  if (a.size() != b.size() || !std::equal(a.begin(), a.begin() + kNumKindDims, b.begin())) {
+    return std::numeric_limits<double>::infinity();
+  }
+  double sum = 0.0;
+  for (size_t i = kNumKindDims; i < a.size(); ++i) {
+    sum += (a[i] - b[i]) * (a[i] - b[i]);
+  }
+  return std::sqrt(sum);
+}
+
 TVM_FFI_STATIC_INIT_BLOCK({ PerStoreFeatureNode::RegisterReflection(); });
 
 TVM_FFI_STATIC_INIT_BLOCK({
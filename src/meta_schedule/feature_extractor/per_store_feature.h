@@ -0,0 +1,50 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef TVM_META_SCHEDULE_FEATURE_EXTRACTOR_PER_STORE_FEATURE_H_
+#define TVM_META_SCHEDULE_FEATURE_EXTRACTOR_PER_STORE_FEATURE_H_
+
+#include <tvm/ir/module.h>
+
+#include <vector>
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief Extract the embedding of a workload, used to find the tuned workloads similar to it.
+ * The embedding consists of the workload embedding of PerStoreFeature, the number of spatial
+ * and reduction iterators of the anchor block, and the log-scaled extent of each of them.
+ * \param mod The workload.
+ * \return The embedding of the workload.
+ */
+std::vector<double> ExtractWorkloadEmbedding(const IRModule& mod);
+
+/*!
+ * \brief The distance between the embeddings of two workloads.
+ * \param a The embedding of a workload.
+ * \param b The embedding of the other workload.
+ * \return The euclidean distance of the log-scaled extents, or infinity if the workloads are not
+ * comparable, i.e. they differ in the kind of the workload or in the number of iterators.
+ */
+double WorkloadEmbeddingDistance(const std::vector<double>& a, const std::vector<double>& b);
+
+}  // namespace meta_schedule
+}  // namespace tvm
+
+#endif  // TVM_META_SCHEDULE_FEATURE_EXTRACTOR_PER_STORE_FEATURE_H_
@@ -20,6 +20,7 @@
 #include <tvm/ffi/reflection/registry.h>
 
 #include "../module_equality.h"
+#include "../trace_apply.h"
 #include "../utils.h"
 
 #define TVM_META_SCHEDULE_CHECK_PROB_RANGE(p, name)                               \
@@ -248,6 +249,8 @@ class EvolutionarySearchNode : public SearchStrategyNode {
  public:
   /*! \brief The state of the search strategy. */
   struct State {
+    /*! \brief The maximal number of schedules in the trace prefix cache. */
+    static constexpr int kMaxTracePrefixCacheSize = 256;
     /*! \brief The search strategy itself */
     EvolutionarySearchNode* self;
     /*! \brief The number of total trials. */
@@ -275,6 +278,17 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     CostModel cost_model_{nullptr};
     /*! \brief The token registered for the given workload in database. */
     Workload token_{nullptr};
+    /*!
+     * \brief The schedules with trace prefixes applied, from which the replay of the mutated
+     * traces resumes.
+     */
+    TracePrefixCache prefix_cache_{kMaxTracePrefixCacheSize};
+    /*! \brief The traces transferred from the tuned workloads similar to the given workload. */
+    std::vector<tir::Trace> transferred_traces_;
+    /*! \brief The schedules picked from the transferred traces. */
+    IRModuleSet transferred_workloads_;
+    /*! \brief The running time in milliseconds of each trial, and whether it is transferred. */
+    std::vector<std::pair<double, bool>> trial_run_ms_;
 
     explicit State(EvolutionarySearchNode* self, int max_trials, int num_trials_per_iter,
                    Array<Schedule> design_space_schedules, Database database, CostModel cost_model)
@@ -284,7 +298,8 @@ class EvolutionarySearchNode : public SearchStrategyNode {
           st(0),
           ed(num_trials_per_iter),
           num_empty_iters(0),
-          measured_workloads_(database->GetModuleEquality()) {
+          measured_workloads_(database->GetModuleEquality()),
+          transferred_workloads_(database->GetModuleEquality()) {
       design_spaces.reserve(design_space_schedules.size());
       for (const Schedule& space : design_space_schedules) {
         design_spaces.push_back(space->trace().value()->Simplified(true));
@@ -299,8 +314,21 @@ class EvolutionarySearchNode : public SearchStrategyNode {
       this->database_ = database;
       this->cost_model_ = cost_model;
       this->token_ = database->CommitWorkload(mod);
+      if (self->num_transfer_workloads > 0 && ctx->target.defined() &&
+          database->GetTopK(this->token_, 1).empty()) {
+        TransferFromSimilarWorkloads(mod);
+      }
     }
 
+    /*!
+     * \brief Transfer the best schedules of the tuned workloads similar to the given workload.
+     * They seed the initial population together with the best schedules in the database.
+     * \param mod The workload to be tuned.
+     */
+    inline void TransferFromSimilarWorkloads(const IRModule& mod);
+    /*! \brief Log how the transferred schedules compare to the schedules found by the search. */
+    inline void SummarizeTransfer() const;
+
     /*!
      * \brief Pick up best candidates from database.
      * \param num The number of traces to produce.
@@ -379,6 +407,12 @@ class EvolutionarySearchNode : public SearchStrategyNode {
   /*** Configuration: pick states for measurement ***/
   /*! \brief The ratio of measurements to use randomly sampled states. */
   double eps_greedy;
+  /*** Configuration: transfer from similar workloads ***/
+  /*!
+   * \brief The maximum number of the tuned workloads similar to the given workload, whose best
+   * schedules are transferred to the initial population when the given workload is not tuned yet.
+   */
+  int num_transfer_workloads;
 
   static void RegisterReflection() {
     namespace refl = tvm::ffi::reflection;
@@ -392,7 +426,8 @@ class EvolutionarySearchNode : public SearchStrategyNode {
         .def_ro("genetic_num_iters", &EvolutionarySearchNode::genetic_num_iters)
         .def_ro("genetic_mutate_prob", &EvolutionarySearchNode::genetic_mutate_prob)
         .def_ro("genetic_max_fail_count", &EvolutionarySearchNode::genetic_max_fail_count)
-        .def_ro("eps_greedy", &EvolutionarySearchNode::eps_greedy);
+        .def_ro("eps_greedy", &EvolutionarySearchNode::eps_greedy)
+        .def_ro("num_transfer_workloads", &EvolutionarySearchNode::num_transfer_workloads);
   }
 
   static constexpr const char* _type_key = "meta_schedule.EvolutionarySearch";
@@ -436,6 +471,7 @@ class EvolutionarySearchNode : public SearchStrategyNode {
   void PostTuning() final {
     CHECK(this->state_ != nullptr) << "ValueError: `PostTuning` is invoked without corresponding "
                                       "`PreTuning`, or `PostTuning` is already invoked.";
+    this->state_->SummarizeTransfer();
     this->state_.reset();
   }
 
@@ -461,6 +497,7 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     n->genetic_mutate_prob = this->genetic_mutate_prob;
     n->genetic_max_fail_count = this->genetic_max_fail_count;
     n->eps_greedy = this->eps_greedy;
+    n->num_transfer_workloads = this->num_transfer_workloads;
     n->ctx_ = this->ctx_;
     n->rand_state_ = this->rand_state_;
     n->state_ = nullptr;  // cleared the state
@@ -476,11 +513,19 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickBestFromDatabase(int nu
   for (TuningRecord record : top_records) {
     measured_traces.push_back(record->trace);
   }
+  // Fill up with the transferred traces when the workload does not have enough records
+  int num_records = measured_traces.size();
+  for (const tir::Trace& trace : this->transferred_traces_) {
+    if (static_cast<int>(measured_traces.size()) >= num) {
+      break;
+    }
+    measured_traces.push_back(trace);
+  }
   int actual_num = measured_traces.size();
   ThreadedTraceApply pp(self->postprocs_);
   std::vector<Schedule> results(actual_num, Schedule{nullptr});
-  auto f_proc_measured = [this, &measured_traces, &results, &pp](int thread_id,
-                                                                 int trace_id) -> void {
+  auto f_proc_measured = [this, num_records, &measured_traces, &results, &pp](
+                             int thread_id, int trace_id) -> void {
     PerThreadData& data = this->per_thread_data_.at(thread_id);
     TRandState* rand_state = &data.rand_state;
     const IRModule& mod = data.mod;
@@ -489,13 +534,82 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickBestFromDatabase(int nu
     ICHECK(!result.defined());
     if (Optional<Schedule> sch = pp.Apply(mod, trace, rand_state)) {
       result = sch.value();
-    } else {
+    } else if (trace_id < num_records) {
       LOG(FATAL) << "ValueError: Cannot postprocess the trace:\n" << trace;
       throw;
     }
   };
   support::parallel_for_dynamic(0, actual_num, self->ctx_->num_threads, f_proc_measured);
-  return results;
+  std::vector<Schedule> picked;
+  picked.reserve(actual_num);
+  for (int i = 0; i < actual_num; ++i) {
+    if (!results[i].defined()) {
+      // The transferred trace is rejected by the postprocessors
+      continue;
+    }
+    if (i >= num_records) {
+      IRModule mod = results[i]->mod();
+      this->transferred_workloads_.Add(mod, ModuleHash(mod));
+    }
+    picked.push_back(results[i]);
+  }
+  return picked;
+}
+
+void EvolutionarySearchNode::State::TransferFromSimilarWorkloads(const IRModule& mod) {
+  auto _ = Profiler::TimedScope("EvoSearch/TransferFromSimilarWorkloads");
+  auto start = std::chrono::steady_clock::now();
+  const Target& target = self->ctx_->target.value();
+  Array<TuningRecord> records =
+      this->database_->QueryNearestTuningRecords(mod, target, self->num_transfer_workloads);
+  for (const TuningRecord& record : records) {
+    Schedule sch = Schedule::Traced(mod, /*seed=*/ForkSeed(&self->rand_state_), /*debug_mask=*/0,
+                                    /*error_render_level=*/tir::ScheduleErrorRenderLevel::kNone);
+    try {
+      ScheduleUsingAnchorTrace(sch, record->trace, target);
+    } catch (const std::exception& e) {
+      // The trace does not fit the workload
+      continue;
+    }
+    this->transferred_traces_.push_back(sch->trace().value());
+  }
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  TVM_PY_LOG(INFO, self->ctx_->logger)
+      << "Transferred " << this->transferred_traces_.size() << " schedule(s) from "
+      << records.size() << " similar workload(s) in " << seconds << " sec";
+}
+
+void EvolutionarySearchNode::State::SummarizeTransfer() const {
+  if (this->transferred_traces_.empty()) {
+    return;
+  }
+  double best_transferred_ms = std::numeric_limits<double>::infinity();
+  for (const auto& [run_ms, is_transferred] : this->trial_run_ms_) {
+    if (is_transferred) {
+      best_transferred_ms = std::min(best_transferred_ms, run_ms);
+    }
+  }
+  if (std::isinf(best_transferred_ms)) {
+    TVM_PY_LOG(INFO, self->ctx_->logger)
+        << "Transfer tuning: none of the transferred schedules is measured successfully";
+    return;
+  }
+  // The number of trials the search takes to beat the transferred schedules estimates the
+  // tuning time the transfer saves
+  int num_trials = this->trial_run_ms_.size();
+  for (int i = 0; i < num_trials; ++i) {
+    const auto& [run_ms, is_transferred] = this->trial_run_ms_[i];
+    if (!is_transferred && run_ms < best_transferred_ms) {
+      TVM_PY_LOG(INFO, self->ctx_->logger)
+          << "Transfer tuning: the best transferred schedule runs in " << best_transferred_ms
+          << " ms, and the search found a faster one at trial " << i + 1 << " of " << num_trials;
+      return;
+    }
+  }
+  TVM_PY_LOG(INFO, self->ctx_->logger)
+      << "Transfer tuning: the best transferred schedule runs in " << best_transferred_ms
+      << " ms, and the search found no faster one in " << num_trials << " trial(s)";
 }
 
 std::vector<Schedule> EvolutionarySearchNode::State::SampleInitPopulation(int num) {
@@ -595,7 +709,8 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
             // Decision: mutate
             Mutator mutator = opt_mutator.value();
             if (Optional<tir::Trace> new_trace = mutator->Apply(trace, rand_state)) {
-              if (Optional<Schedule> sch = pp.Apply(mod, new_trace.value(), rand_state)) {
+              if (Optional<Schedule> sch = pp.Apply(mod, new_trace.value(), rand_state,
+                                                    &this->prefix_cache_)) {
                 // note that sch's trace is different from new_trace
                 // because it contains post-processing information
                 result = sch.value();
@@ -617,7 +732,8 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
 
       population.swap(next_population);
       TVM_PY_LOG(INFO, self->ctx_->logger) << "Evolve iter #" << iter << " done. Summary:\n"
-                                           << pp.SummarizeFailures();
+                                           << pp.SummarizeFailures() << "\n"
+                                           << this->prefix_cache_.Summarize();
     }
   }
   // Return the best states from the heap, sorting from higher score to lower ones
@@ -740,6 +856,20 @@ void EvolutionarySearchNode::State::NotifyRunnerResults(
     const Array<MeasureCandidate>& measure_candidates, const Array<RunnerResult>& results) {
   st += results.size();
   ed += results.size();
+  if (this->transferred_traces_.empty()) {
+    return;
+  }
+  ICHECK_EQ(measure_candidates.size(), results.size());
+  for (int i = 0, n = results.size(); i < n; ++i) {
+    const RunnerResult& result = results[i];
+    if (result->error_msg.has_value() || !result->run_secs.defined() ||
+        result->run_secs.value().empty()) {
+      continue;
+    }
+    IRModule mod = measure_candidates[i]->sch->mod();
+    this->trial_run_ms_.emplace_back(GetRunMsMedian(result),
+                                     this->transferred_workloads_.Has(mod, ModuleHash(mod)));
+  }
 }
 
 size_t EvolutionarySearchNode::State::ModuleHash(const IRModule& mod) const {
@@ -753,8 +883,11 @@ SearchStrategy SearchStrategy::EvolutionarySearch(int population_size,         /
                                                   int genetic_num_iters,       //
                                                   double genetic_mutate_prob,  //
                                                   int genetic_max_fail_count,  //
-                                                  double eps_greedy) {
+                                                  double eps_greedy,           //
+                                                  int num_transfer_workloads) {
   TVM_META_SCHEDULE_CHECK_PROB_RANGE(init_measured_ratio, "Initial measured ratio");
+  CHECK_GE(num_transfer_workloads, 0)
+      << "ValueError: `num_transfer_workloads` must be non-negative";
   TVM_META_SCHEDULE_CHECK_PROB_RANGE(genetic_mutate_prob, "Mutation probability");
   TVM_META_SCHEDULE_CHECK_PROB_RANGE(eps_greedy, "Greedy pick probability");
   ObjectPtr<EvolutionarySearchNode> n = make_object<EvolutionarySearchNode>();
@@ -767,6 +900,7 @@ SearchStrategy SearchStrategy::EvolutionarySearch(int population_size,         /
   n->genetic_max_fail_count = genetic_max_fail_count;
   n->genetic_mutate_prob = genetic_mutate_prob;
   n->eps_greedy = eps_greedy;
+  n->num_transfer_workloads = num_transfer_workloads;
   return SearchStrategy(n);
 }
 
@@ -18,6 +18,10 @@
  */
 #include <tvm/ffi/reflection/registry.h>
 
+#include <optional>
+#include <string>
+#include <vector>
+
 #include "../utils.h"
 
 namespace tvm {
@@ -28,16 +32,28 @@ class GradientBasedNode final : public TaskSchedulerNode {
  public:
   double alpha;
   int window_size;
+  /*!
+   * \brief The number of rounds over which a task is checked for convergence. A task converges
+   * and stops when its best latency improves by less than `plateau_threshold` within these rounds.
+   * Zero disables the check.
+   */
+  int plateau_rounds;
+  /*! \brief The relative improvement of the best latency below which a task converges. */
+  double plateau_threshold;
   support::LinearCongruentialEngine::TRandState rand_state;
 
   int round_robin_rounds_;
   std::vector<std::vector<double>> best_latency_history_;
+  /*! \brief The reason why each task is stopped by the scheduler, empty if not. */
+  std::vector<std::string> stop_reasons_;
 
   static void RegisterReflection() {
     namespace refl = tvm::ffi::reflection;
     refl::ObjectDef<GradientBasedNode>()
         .def_ro("alpha", &GradientBasedNode::alpha)
-        .def_ro("window_size", &GradientBasedNode::window_size);
+        .def_ro("window_size", &GradientBasedNode::window_size)
+        .def_ro("plateau_rounds", &GradientBasedNode::plateau_rounds)
+        .def_ro("plateau_threshold", &GradientBasedNode::plateau_threshold);
   }
 
   static constexpr const char* _type_key = "meta_schedule.GradientBased";
@@ -50,10 +66,34 @@ class GradientBasedNode final : public TaskSchedulerNode {
             Optional<CostModel> cost_model) final {
     int n_tasks = tasks.size();
     round_robin_rounds_ = 0;
+    best_latency_history_.clear();
     best_latency_history_.resize(n_tasks, std::vector<double>());
+    stop_reasons_.clear();
+    stop_reasons_.resize(n_tasks);
     TaskSchedulerNode::Tune(tasks, task_weights, max_trials_global, max_trials_per_task,
                             num_trials_per_iter, builder, runner, measure_callbacks, database,
                             cost_model);
+    // Log why each task is stopped
+    int total_trials = 0;
+    for (const TaskRecord& task : this->tasks_) {
+      total_trials += task->latency_ms.size();
+    }
+    for (int i = 0; i < n_tasks; ++i) {
+      const TaskRecordNode* task = this->tasks_[i].get();
+      std::string reason = stop_reasons_[i];
+      if (reason.empty()) {
+        if (static_cast<int>(task->latency_ms.size()) >= max_trials_per_task) {
+          reason = "reached max_trials_per_task";
+        } else if (total_trials >= max_trials_global) {
+          reason = "reached max_trials_global";
+        } else {
+          reason = "no more candidates from the search strategy";
+        }
+      }
+      TVM_PY_LOG(INFO, this->logger) << "Task #" << i << ": " << task->ctx->task_name
+                                     << " stopped after " << task->latency_ms.size()
+                                     << " trial(s): " << reason;
+    }
   }
 
   int NextTaskId() final {
@@ -74,21 +114,28 @@ class GradientBasedNode final : public TaskSchedulerNode {
       }
       ++round_robin_rounds_;
     }
-    // Step 2. Collect the tasks that are not terminated yet
+    // Step 2. Collect the tasks that are not terminated yet, and stop the converged ones
     std::vector<int> tasks_alive;
     {
       tasks_alive.reserve(n_tasks);
       for (int i = 0; i < n_tasks; ++i) {
         this->TouchTask(i);
-        if (!this->tasks_[i]->is_terminated) {
-          tasks_alive.push_back(i);
+        if (this->tasks_[i]->is_terminated) {
+          continue;
+        }
+        if (std::optional<std::string> reason = CheckConvergence(i)) {
+          stop_reasons_.at(i) = reason.value();
+          this->TerminateTask(i);
+          continue;
         }
+        tasks_alive.push_back(i);
       }
       if (tasks_alive.empty()) {
         return -1;
       }
     }
-    // Step 3. Calculate the gradient of each task alive
+    // Step 3. Calculate the gradient of each task alive, i.e. its weighted expected improvement.
+    // The trials left by the converged tasks are thus spent on the tasks with more to gain.
     std::vector<double> grad;
     grad.reserve(n_tasks);
     for (int task_id : tasks_alive) {
@@ -122,6 +169,31 @@ class GradientBasedNode final : public TaskSchedulerNode {
     return task_id;
   }
 
+  /*!
+   * \brief Check if a task has converged, i.e. its best latency plateaus over the last rounds.
+   * \param task_id The id of the task, which is not running.
+   * \return The reason to stop the task if it has converged, or std::nullopt otherwise.
+   */
+  std::optional<std::string> CheckConvergence(int task_id) const {
+    if (this->plateau_rounds <= 0 || this->tasks_[task_id]->runner_futures.defined()) {
+      return std::nullopt;
+    }
+    const std::vector<double>& best_latency = this->best_latency_history_.at(task_id);
+    int n = best_latency.size();
+    if (n <= this->plateau_rounds) {
+      return std::nullopt;
+    }
+    double prev = best_latency[n - 1 - this->plateau_rounds];
+    double best = best_latency[n - 1];
+    if (prev >= 1e9 || (prev - best) >= prev * this->plateau_threshold) {
+      return std::nullopt;
+    }
+    std::ostringstream os;
+    os << "converged, the best latency improved by " << (prev - best) / prev * 100.0
+       << "% in the last " << this->plateau_rounds << " round(s)";
+    return os.str();
+  }
+
   Array<RunnerResult> JoinRunningTask(int task_id) final {
     Array<RunnerResult> results = TaskSchedulerNode::JoinRunningTask(task_id);
     TaskRecordNode* task = this->tasks_[task_id].get();
@@ -135,11 +207,16 @@ class GradientBasedNode final : public TaskSchedulerNode {
 };
 
 TaskScheduler TaskScheduler::GradientBased(ffi::Function logger, double alpha, int window_size,
+                                           int plateau_rounds, double plateau_threshold,
                                            support::LinearCongruentialEngine::TRandState seed) {
+  CHECK_GE(plateau_rounds, 0) << "ValueError: `plateau_rounds` must be non-negative";
+  CHECK_GE(plateau_threshold, 0.0) << "ValueError: `plateau_threshold` must be non-negative";
   ObjectPtr<GradientBasedNode> n = make_object<GradientBasedNode>();
   n->logger = logger;
   n->alpha = alpha;
   n->window_size = window_size;
+  n->plateau_rounds = plateau_rounds;
+  n->plateau_threshold = plateau_threshold;
   n->rand_state = support::LinearCongruentialEngine::NormalizeSeed(seed);
   return TaskScheduler(n);
 }
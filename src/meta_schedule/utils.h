@@ -43,8 +43,15 @@
 #include <tvm/tir/transform.h>
 
 #include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <numeric>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -297,6 +304,177 @@ inline tir::BlockRV GetRVFromSRef(const tir::Schedule& sch, const tir::StmtSRef&
   return sch->GetBlock(block->name_hint, global_var_name);
 }
 
+/*!
+ * \brief A thread-safe cache of the schedules to which a prefix of a trace has been applied,
+ * keyed by the hash of the prefix. Replaying a trace resumes from a copy of the schedule of its
+ * longest cached prefix, instead of the original module, which saves most of the replay when a
+ * mutator only changes a decision near the end of the trace.
+ * \note The prefixes are compared by their python form, so the traces must have the decisions
+ * of all their sampling instructions, and be applied to structurally equal modules.
+ */
+class TracePrefixCache {
+ public:
+  /*!
+   * \brief Constructor
+   * \param max_size The maximal number of cached schedules.
+   */
+  explicit TracePrefixCache(int max_size) : max_size_(max_size) {}
+
+  /*!
+   * \brief Apply the trace to the module, resuming from the longest cached prefix of the trace
+   * that ends right before a decision, and cache the schedules at the later decisions.
+   * \param mod The IRModule to be applied
+   * \param trace The trace to apply, without postprocessing instructions
+   * \param rand_state The random seed
+   * \return The schedule with the trace applied
+   */
+  tir::Schedule Replay(const IRModule& mod, const tir::Trace& trace, TRandState* rand_state) {
+    using Clock = std::chrono::steady_clock;
+    auto seconds_since = [](Clock::time_point start) {
+      return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+    Array<String> lines = trace->AsPython(/*remove_postproc=*/true);
+    int n = lines.size();
+    // The prefixes that end right before a decision, from the longest to the shortest
+    std::vector<int> prefix_lens;
+    std::vector<uint64_t> prefix_hashes(n + 1, 0);
+    for (int i = 0; i < n; ++i) {
+      if (i > 0 && trace->decisions.count(trace->insts[i])) {
+        prefix_lens.push_back(i);
+      }
+      prefix_hashes[i + 1] =
+          support::HashCombine(prefix_hashes[i], std::hash<std::string>()(lines[i]));
+    }
+    std::reverse(prefix_lens.begin(), prefix_lens.end());
+
+    Clock::time_point start_time = Clock::now();
+    tir::Schedule sch{nullptr};
+    int begin = 0;
+    double begin_replay_seconds = 0.0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++num_lookups_;
+      for (int len : prefix_lens) {
+        auto it = entries_.find(prefix_hashes[len]);
+        if (it != entries_.end() && it->second.Matches(lines, len)) {
+          // `Copy` forks the random state of the cached schedule, hence the lock.
+          sch = it->second.sch->Copy();
+          begin = len;
+          begin_replay_seconds = it->second.replay_seconds;
+          ++num_hits_;
+          saved_seconds_ += it->second.replay_seconds;
+          break;
+        }
+      }
+    }
+    if (sch.defined()) {
+      sch->Seed(ForkSeed(rand_state));
+    } else {
+      sch = tir::Schedule::Traced(mod,
+                                  /*rand_state=*/ForkSeed(rand_state),
+                                  /*debug_mode=*/0,
+                                  /*error_render_level=*/tir::ScheduleErrorRenderLevel::kNone);
+    }
+    double overhead_seconds = seconds_since(start_time);
+
+    // Replay the rest of the trace segment by segment, caching the schedules in between
+    for (auto it = prefix_lens.rbegin(); it != prefix_lens.rend(); ++it) {
+      int len = *it;
+      if (len <= begin) {
+        continue;
+      }
+      Clock::time_point segment_start = Clock::now();
+      trace->ApplyRangeToSchedule(sch, begin, len);
+      begin_replay_seconds += seconds_since(segment_start);
+      begin = len;
+      Clock::time_point snapshot_start = Clock::now();
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!entries_.count(prefix_hashes[len])) {
+          Insert(prefix_hashes[len], Entry{sch->Copy(), lines, len, begin_replay_seconds});
+        }
+      }
+      overhead_seconds += seconds_since(snapshot_start);
+    }
+    trace->ApplyRangeToSchedule(sch, begin, n);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      overhead_seconds_ += overhead_seconds;
+    }
+    return sch;
+  }
+
+  /*! \brief Returns a string summarizing the hit rate and the replay time saved */
+  std::string Summarize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream os;
+    os << "Trace prefix cache: " << num_hits_ << " hit(s) in " << num_lookups_ << " replay(s)";
+    if (num_lookups_ > 0) {
+      os << " (" << std::fixed << std::setprecision(2) << 100.0 * num_hits_ / num_lookups_
+         << "%)";
+    }
+    os << ", " << entries_.size() << " cached schedule(s), saved " << std::fixed
+       << std::setprecision(4) << saved_seconds_ << " s of replay at a cost of "
+       << overhead_seconds_ << " s";
+    return os.str();
+  }
+
+ private:
+  /*! \brief A cached schedule with a prefix of a trace applied */
+  struct Entry {
+    /*! \brief The schedule, which is copied before use */
+    tir::Schedule sch;
+    /*! \brief The python form of the trace the schedule comes from */
+    Array<String> lines;
+    /*! \brief The length of the prefix applied to the schedule */
+    int len;
+    /*! \brief The time to replay the prefix from the original module */
+    double replay_seconds;
+
+    /*! \brief Whether the python form of a trace has the same prefix, to rule out collisions */
+    bool Matches(const Array<String>& other, int prefix_len) const {
+      if (prefix_len != len) {
+        return false;
+      }
+      for (int i = 0; i < len; ++i) {
+        if (lines[i] != other[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+  /*! \brief Insert an entry, evicting the earliest ones if the cache is full */
+  void Insert(uint64_t key, Entry entry) {
+    while (static_cast<int>(keys_.size()) >= max_size_ && !keys_.empty()) {
+      entries_.erase(keys_.front());
+      keys_.pop_front();
+    }
+    if (max_size_ > 0) {
+      entries_.emplace(key, std::move(entry));
+      keys_.push_back(key);
+    }
+  }
+
+  /*! \brief The maximal number of cached schedules */
+  int max_size_;
+  /*! \brief The mutex guarding the fields below */
+  mutable std::mutex mutex_;
+  /*! \brief The cached schedules keyed by the hash of the prefix */
+  std::unordered_map<uint64_t, Entry> entries_;
+  /*! \brief The keys of the cached schedules in the order of insertion */
+  std::deque<uint64_t> keys_;
+  /*! \brief The number of replays */
+  int64_t num_lookups_ = 0;
+  /*! \brief The number of replays resumed from a cached schedule */
+  int64_t num_hits_ = 0;
+  /*! \brief The replay time of the cached prefixes resumed from */
+  double saved_seconds_ = 0.0;
+  /*! \brief The time spent on copying the cached schedules and caching new ones */
+  double overhead_seconds_ = 0.0;
+};
+
 /*!
  * \brief A helper data structure that replays a trace and collects failure counts
  * for each postprocessor
@@ -319,17 +497,22 @@ struct ThreadedTraceApply {
    * \param mod The IRModule to be applied
    * \param trace The trace to apply to the IRModule
    * \param rand_state The random seed
+   * \param prefix_cache The cache to resume the replay from, if any
    * \return The schedule created, or std::nullopt if any postprocessor fails
    */
   Optional<tir::Schedule> Apply(const IRModule& mod, const tir::Trace& trace,
-                                TRandState* rand_state) {
-    tir::Schedule sch =
-        tir::Schedule::Traced(mod,
-                              /*rand_state=*/ForkSeed(rand_state),
-                              /*debug_mode=*/0,
-                              /*error_render_level=*/tir::ScheduleErrorRenderLevel::kNone);
-
-    trace->ApplyToSchedule(sch, /*remove_postproc=*/true);
+                                TRandState* rand_state,
+                                TracePrefixCache* prefix_cache = nullptr) {
+    tir::Schedule sch{nullptr};
+    if (prefix_cache != nullptr) {
+      sch = prefix_cache->Replay(mod, trace, rand_state);
+    } else {
+      sch = tir::Schedule::Traced(mod,
+                                  /*rand_state=*/ForkSeed(rand_state),
+                                  /*debug_mode=*/0,
+                                  /*error_render_level=*/tir::ScheduleErrorRenderLevel::kNone);
+      trace->ApplyToSchedule(sch, /*remove_postproc=*/true);
+    }
     sch->EnterPostproc();
 
     for (int i = 0; i < n_; ++i) {
@@ -463,28 +646,123 @@ inline Array<Integer> AsIntArray(const ObjectRef& obj) {
   return results;
 }
 
-/*! \brief The struct defining comparison function of sorting by mean run seconds. */
-struct SortTuningRecordByMeanRunSecs {
-  static const constexpr double kMaxMeanTime = 1e10;
-
-  static double Mean(const Array<FloatImm>& a) {
-    if (a.empty()) {
-      return kMaxMeanTime;
+/*!
+ * \brief The statistics of the running time samples of a measurement. The ranking uses the median,
+ * which is robust to the outliers caused by the noise of the measurement.
+ */
+struct RunSecsStatistics {
+  /*! \brief The running time used as a stub for undefined measurements. */
+  static const constexpr double kMaxRunTime = 1e10;
+
+  /*! \brief The number of samples. */
+  int64_t count = 0;
+  /*! \brief The median of the samples. */
+  double median = kMaxRunTime;
+  /*! \brief The 10th percentile of the samples. */
+  double p10 = kMaxRunTime;
+  /*! \brief The 90th percentile of the samples. */
+  double p90 = kMaxRunTime;
+  /*! \brief The sample variance. */
+  double variance = 0.0;
+
+  explicit RunSecsStatistics(const Array<FloatImm>& run_secs) {
+    std::vector<double> v;
+    v.reserve(run_secs.size());
+    for (const FloatImm& run_sec : run_secs) {
+      v.push_back(run_sec->value);
     }
-    double sum = 0.0;
-    for (const FloatImm& i : a) {
-      sum += i->value;
+    if (v.empty()) {
+      return;
     }
-    return sum / a.size();
+    std::sort(v.begin(), v.end());
+    count = v.size();
+    median = Percentile(v, 0.5);
+    p10 = Percentile(v, 0.1);
+    p90 = Percentile(v, 0.9);
+    if (count > 1) {
+      double mean = std::accumulate(v.begin(), v.end(), 0.0) / count;
+      for (double x : v) {
+        variance += (x - mean) * (x - mean);
+      }
+      variance /= count - 1;
+    }
+  }
+
+  /*!
+   * \brief The percentile of the sorted samples, interpolated linearly between the samples.
+   * \param sorted The sorted samples, which are not empty.
+   * \param q The quantile, within [0, 1].
+   * \return The percentile.
+   */
+  static double Percentile(const std::vector<double>& sorted, double q) {
+    double pos = q * (sorted.size() - 1);
+    size_t lo = static_cast<size_t>(pos);
+    size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - lo);
+  }
+};
+
+/*!
+ * \brief The median running time of a tuning record, computed in linear time. It is the same as
+ * the median of RunSecsStatistics, without the other statistics.
+ * \param record The tuning record.
+ * \return The median, or RunSecsStatistics::kMaxRunTime if the record has no measurement.
+ */
+inline double MedianRunSecs(const TuningRecord& record) {
+  if (!record->run_secs.defined() || record->run_secs.value().empty()) {
+    return RunSecsStatistics::kMaxRunTime;
+  }
+  const Array<FloatImm>& run_secs = record->run_secs.value();
+  if (run_secs.size() == 1) {
+    return run_secs[0]->value;
   }
+  std::vector<double> v;
+  v.reserve(run_secs.size());
+  for (const FloatImm& run_sec : run_secs) {
+    v.push_back(run_sec->value);
+  }
+  size_t mid = v.size() / 2;
+  std::nth_element(v.begin(), v.begin() + mid, v.end());
+  double upper = v[mid];
+  if (v.size() % 2 == 1) {
+    return upper;
+  }
+  double lower = *std::max_element(v.begin(), v.begin() + mid);
+  return lower + (upper - lower) * 0.5;
+}
 
+/*! \brief The struct defining comparison function of sorting by the median run seconds. */
+struct SortTuningRecordByRunSecs {
   bool operator()(const TuningRecord& a, const TuningRecord& b) const {
-    double a_time = Mean(a->run_secs.value_or({}));
-    double b_time = Mean(b->run_secs.value_or({}));
-    return a_time < b_time;
+    return MedianRunSecs(a) < MedianRunSecs(b);
   }
 };
 
+/*!
+ * \brief Sort the tuning records stably by the median run seconds. Unlike sorting with
+ * SortTuningRecordByRunSecs, the median of each record is computed only once.
+ * \param records The tuning records to sort.
+ */
+inline void SortTuningRecordsByRunSecs(std::vector<TuningRecord>* records) {
+  std::vector<std::pair<double, TuningRecord>> keyed;
+  keyed.reserve(records->size());
+  for (TuningRecord& record : *records) {
+    keyed.emplace_back(MedianRunSecs(record), std::move(record));
+  }
+  std::stable_sort(keyed.begin(), keyed.end(),
+                   [](const std::pair<double, TuningRecord>& a,
+                      const std::pair<double, TuningRecord>& b) { return a.first < b.first; });
+  for (size_t i = 0; i < keyed.size(); ++i) {
+    (*records)[i] = std::move(keyed[i].second);
+  }
+}
+
+/*!
+ * \brief Tuning records ordered by the median run seconds, which is the key of each record, so
+ * that it is computed once when the record is inserted rather than on every comparison.
+ */
+using TuningRecordsByRunSecs = std::multimap<double, TuningRecord>;
+
 /*!
  * \brief The helper function to clone schedule rules, postprocessors, and mutators.
  * \param src The source space generator.
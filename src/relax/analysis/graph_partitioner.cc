@@ -204,6 +204,41 @@ void GraphPartitioner::CommitFuse(IndexedForwardGraph::Node* src, IndexedForward
   CommitFuse_(src, sink, target);
 }
 
+void GraphPartitioner::CollectGroupsUptoSink_(IndexedForwardGraph::Node* src,
+                                              IndexedForwardGraph::Node* sink,
+                                              std::unordered_set<Group*>* roots) {
+  if (src == sink || visited_.count(src)) return;
+  visited_.insert(src);
+  roots->insert(groups_[src->index]->FindRoot());
+  for (auto link = src->outputs.head; link != nullptr; link = link->next) {
+    CollectGroupsUptoSink_(link->value.node, sink, roots);
+  }
+}
+
+bool GraphPartitioner::CheckFuseProfitable(const IndexedForwardGraph& graph,
+                                           IndexedForwardGraph::Node* src,
+                                           IndexedForwardGraph::Node* sink) {
+  if (fcheck_fuse_ == nullptr) return true;
+  std::unordered_set<Group*> roots{groups_[sink->index]->FindRoot()};
+  visited_.clear();
+  CollectGroupsUptoSink_(src, sink, &roots);
+  if (roots.size() <= 1) return true;
+  // Gather the members of each group in topological order.
+  std::unordered_map<Group*, size_t> root_index;
+  std::vector<std::vector<IndexedForwardGraph::Node*>> members;
+  for (size_t nid = 0; nid < groups_.size(); ++nid) {
+    Group* root = groups_[nid]->FindRoot();
+    if (!roots.count(root)) continue;
+    auto it = root_index.find(root);
+    if (it == root_index.end()) {
+      it = root_index.emplace(root, members.size()).first;
+      members.emplace_back();
+    }
+    members[it->second].push_back(graph.post_dfs_order[nid]);
+  }
+  return fcheck_fuse_(members);
+}
+
 size_t GraphPartitioner::CountNodesUptoSink_(IndexedForwardGraph::Node* src,
                                              IndexedForwardGraph::Node* sink) {
   if (src == sink || visited_.count(src)) return 0;
@@ -340,6 +375,7 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
           auto* src = it->second;
           auto* snode = post_dom_tree.nodes[src->index]->parent->gnode;
           if (groups_[snode->index]->anchor_ref != nullptr) continue;
+          if (!CheckFuseProfitable(graph, src, snode)) continue;
           CommitFuse(src, snode);
         }
       }
@@ -377,7 +413,8 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
         auto fcond = [](OpPatternKind kind, bool is_sink) { return kind <= kInjective; };
         // dom_root_group can also be tuple, as in inception layers
         // CheckPath is needed to avoid fusing two intermediate tuples
-        if (CheckPath(graph_node, dom_node->parent->gnode, fcond)) {
+        if (CheckPath(graph_node, dom_node->parent->gnode, fcond) &&
+            CheckFuseProfitable(graph, graph_node, dom_node->parent->gnode)) {
           CommitFuse(graph_node, dom_node->parent->gnode);
         }
       }
@@ -400,7 +437,8 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
         ICHECK(dom_node->parent->gnode != nullptr);
         // The fuse can be executed if all the intermediate ops are still broadcast.
         auto fcond = [](OpPatternKind kind, bool is_sink) { return kind <= kBroadcast; };
-        if (CheckPath(graph_node, dom_node->parent->gnode, fcond)) {
+        if (CheckPath(graph_node, dom_node->parent->gnode, fcond) &&
+            CheckFuseProfitable(graph, graph_node, dom_node->parent->gnode)) {
           CommitFuse(graph_node, dom_node->parent->gnode);
         }
       }
@@ -420,7 +458,8 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
                     kind == kOutEWiseFusable);
           }
         };
-        if (CheckPath(graph_node, dom_node->parent->gnode, fcond)) {
+        if (CheckPath(graph_node, dom_node->parent->gnode, fcond) &&
+            CheckFuseProfitable(graph, graph_node, dom_node->parent->gnode)) {
           CommitFuse(graph_node, dom_node->parent->gnode);
         }
       }
@@ -430,7 +469,8 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
       if (phase != 1) continue;
       // Check if all path are injective.
       auto fcond = [](OpPatternKind kind, bool is_sink) { return kind <= kInjective; };
-      if (CheckPath(graph_node, dom_node->parent->gnode, fcond)) {
+      if (CheckPath(graph_node, dom_node->parent->gnode, fcond) &&
+          CheckFuseProfitable(graph, graph_node, dom_node->parent->gnode)) {
         CommitFuse(graph_node, dom_node->parent->gnode);
       }
     } else {
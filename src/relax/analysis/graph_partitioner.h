@@ -28,6 +28,7 @@
 #include <tvm/relax/op_attr_types.h>
 #include <tvm/relax/type.h>
 
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -163,12 +164,21 @@ class DominatorTree {
  */
 class GraphPartitioner {
  public:
+  /*!
+   * \brief The function deciding whether fusing groups together is profitable.
+   * \param groups The nodes of each group to be fused together.
+   * \return Whether to fuse the groups.
+   */
+  using FCheckFuse =
+      std::function<bool(const std::vector<std::vector<IndexedForwardGraph::Node*>>& groups)>;
+
   explicit GraphPartitioner(support::Arena* arena, int opt_level, size_t max_fuse_depth,
-                            size_t max_function_args)
+                            size_t max_function_args, FCheckFuse fcheck_fuse = nullptr)
       : arena_(arena),
         opt_level_(opt_level),
         max_fuse_depth_(max_fuse_depth),
-        max_function_args_(max_function_args) {}
+        max_function_args_(max_function_args),
+        fcheck_fuse_(std::move(fcheck_fuse)) {}
   /*!
    * \brief Group as a union find data structure.
    */
@@ -216,6 +226,8 @@ class GraphPartitioner {
   size_t max_fuse_depth_;
   /*! \brief The maximum number of arguments in one fused function */
   size_t max_function_args_;
+  /*! \brief The optional profitability check of each fusion, on top of the pattern rules. */
+  FCheckFuse fcheck_fuse_;
   /*! \brief The internal groups. */
   std::vector<Group*> groups_;
   /*! \brief internal field used for deduplication */
@@ -265,6 +277,18 @@ class GraphPartitioner {
    * \note sink must be a post-dominator of src.
    */
   void CommitFuse(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink);
+  // Internal implementation of CheckFuseProfitable
+  void CollectGroupsUptoSink_(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink,
+                              std::unordered_set<Group*>* roots);
+  /*!
+   * \brief Check whether fusing src up to sink is profitable by fcheck_fuse_.
+   * \param graph The graph being partitioned.
+   * \param src The source node.
+   * \param sink The termination node.
+   * \return Whether to fuse, always true without fcheck_fuse_.
+   */
+  bool CheckFuseProfitable(const IndexedForwardGraph& graph, IndexedForwardGraph::Node* src,
+                           IndexedForwardGraph::Node* sink);
 
   size_t CountNodesUptoSink_(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink);
   // Calculate the number of arguments for the node.
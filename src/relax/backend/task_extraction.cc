@@ -25,6 +25,8 @@
 #include <tvm/tir/function.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <algorithm>
+
 #include "../../meta_schedule/module_equality.h"
 
 namespace tvm {
@@ -48,6 +50,10 @@ using meta_schedule::ModuleHash;
  *   `fn2` is called by 3 Call-TIR and `fn3` is called by 5 Call-TIR.
  *   Then we will have a ExtractedTask for all three functions, whose weight
  *   is 5 + 3 + 2 = 10.
+ *   3. The structurally distinct PrimFuncs deduplicated into a task are kept in
+ *   its `dispatched` field, led by the one to tune. With the anchor-block
+ *   equality, they may differ in the epilogues, and the tuned trace is applied
+ *   to each of them via its anchor block.
  */
 class BlockCounter : public tir::StmtVisitor {
  public:
@@ -106,31 +112,51 @@ class TaskExtractor : public ExprVisitor {
     const GlobalVar& global_var = Downcast<GlobalVar>(call->args[0]);
     const tir::PrimFunc& func = Downcast<tir::PrimFunc>(mod_->Lookup(global_var));
     IRModule mod = (*normalize_mod_func_)(func).cast<IRModule>();
-    size_t weight = 1;
     auto it = func2task_.find(mod);
-    if (it != func2task_.end()) {
-      it->second->weight += 1;
-      const tir::PrimFunc& alt_func = Downcast<tir::PrimFunc>(it->first->Lookup("main"));
-      // When anchor-block based equality is used, tuning tasks "nn_conv2d_add_nn_relu" and
-      // "nn_conv2d_add_add_nn_relu", for example, can be identified as equal. Thus, one of them
-      // will be selected to tune by the code below.
-      //
-      // To make sure that we tune "nn_conv2d_add_nn_relu" and not "nn_conv2d_add_add_nn_relu", we
-      // count the PrinFunc number of blocks and leave only the function with the smallest number of
-      // blocks. This way, "nn_conv2d_add_nn_relu" will have a smaller number of blocks than
-      // "nn_conv2d_add_add_nn_relu" and will be selected to tune.
-      if (BlockCounter::GetBlockCount(func) < BlockCounter::GetBlockCount(alt_func)) {
-        weight += it->second->weight;
-        func2task_.erase(it->first);
+    if (it == func2task_.end()) {
+      ExtractedTask task(/*task_name=*/global_var->name_hint,  //
+                         /*mod=*/mod,                          //
+                         /*target=*/target_,                   //
+                         /*dispatched=*/{mod},                 //
+                         /*weight=*/1);
+      func2task_.emplace(mod, task);
+      return;
+    }
+    ExtractedTask task = it->second;
+    task->weight += 1;
+    // The distinct functions grouped into the task are kept in `dispatched`, so that the tuning
+    // result of the task can be applied to each of them, e.g. via the anchor-block trace.
+    bool is_new_func = std::none_of(task->dispatched.begin(), task->dispatched.end(),
+                                    [&mod](const IRModule& other) {
+                                      return StructuralEqual()(mod, other);
+                                    });
+    const tir::PrimFunc& alt_func = Downcast<tir::PrimFunc>(it->first->Lookup("main"));
+    // When anchor-block based equality is used, tuning tasks "nn_conv2d_add_nn_relu" and
+    // "nn_conv2d_add_add_nn_relu", for example, can be identified as equal. Thus, one of them
+    // will be selected to tune by the code below.
+    //
+    // To make sure that we tune "nn_conv2d_add_nn_relu" and not "nn_conv2d_add_add_nn_relu", we
+    // count the PrinFunc number of blocks and leave only the function with the smallest number of
+    // blocks. This way, "nn_conv2d_add_nn_relu" will have a smaller number of blocks than
+    // "nn_conv2d_add_add_nn_relu" and will be selected to tune. The function to tune is always the
+    // first one in `dispatched`.
+    if (BlockCounter::GetBlockCount(func) < BlockCounter::GetBlockCount(alt_func)) {
+      Array<IRModule> dispatched{mod};
+      for (const IRModule& other : task->dispatched) {
+        if (is_new_func || !StructuralEqual()(mod, other)) {
+          dispatched.push_back(other);
+        }
       }
+      ExtractedTask new_task(/*task_name=*/global_var->name_hint,  //
+                             /*mod=*/mod,                          //
+                             /*target=*/target_,                   //
+                             /*dispatched=*/dispatched,            //
+                             /*weight=*/task->weight);
+      func2task_.erase(it);
+      func2task_.emplace(mod, new_task);
+    } else if (is_new_func) {
+      task->dispatched.push_back(mod);
     }
-
-    ExtractedTask task(/*task_name=*/global_var->name_hint,  //
-                       /*mod=*/mod,                          //
-                       /*target=*/target_,                   //
-                       /*dispatched=*/{mod},                 //
-                       /*weight=*/weight);
-    func2task_.emplace(mod, task);
   }
 
   IRModule mod_;
@@ -0,0 +1,208 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relax/backend/vm/function_build_cache.cc
+ * \brief A cache of the compiled TIR functions across the builds of relax modules, so that only
+ * the functions changed since the previous builds are lowered and compiled again.
+ */
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/ir/module.h>
+#include <tvm/ir/transform.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
+#include <tvm/runtime/module.h>
+#include <tvm/tir/function.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "../../../meta_schedule/module_equality.h"
+#include "../../transform/utils.h"
+
+namespace tvm {
+namespace relax {
+
+/*!
+ * \brief The cache from single-function TIR modules to their compiled runtime modules. The
+ * modules are hashed and compared structurally, including the data of their constants, and the
+ * cache is partitioned by a build key, which identifies the target, the TIR pipeline and the
+ * lowering options of the PassContext of the build.
+ */
+class FunctionBuildCacheNode : public Object {
+ public:
+  /*! \brief The target and TIR pipeline of a build, and the lowering options of its PassContext. */
+  using BuildKey = Array<Any>;
+
+  /*! \brief The number of lookups that found the compiled function. */
+  int64_t num_hits = 0;
+  /*! \brief The number of lookups that did not find the compiled function. */
+  int64_t num_misses = 0;
+
+  // Module equalities that skip parts of the module, e.g. the data of the constants, would link
+  // stale code, so the whole module is compared.
+  FunctionBuildCacheNode() : mod_eq_(meta_schedule::ModuleEquality::Create("structural")) {}
+
+  /*!
+   * \brief Make the build key of the current PassContext.
+   * \param target_pipeline The string identifying the target and the TIR pipeline.
+   * \return The build key, or nullopt if the lowering options of the PassContext cannot be hashed,
+   *  in which case the cache is not used.
+   */
+  static Optional<BuildKey> MakeBuildKey(const String& target_pipeline) {
+    BuildKey build_key{target_pipeline, GetTIRLoweringOptions(transform::PassContext::Current())};
+    try {
+      StructuralHash()(build_key);
+    } catch (const tvm::Error& err) {
+      return std::nullopt;
+    }
+    return build_key;
+  }
+
+  /*!
+   * \brief Look up the compiled module of a single-function TIR module.
+   * \param build_key The build key.
+   * \param mod The single-function TIR module.
+   * \return The compiled module if it is in the cache.
+   */
+  Optional<runtime::Module> Lookup(const BuildKey& build_key, const IRModule& mod) {
+    auto table_it = tables_.find(build_key);
+    if (table_it != tables_.end()) {
+      auto it = table_it->second->find(mod);
+      if (it != table_it->second->end()) {
+        ++num_hits;
+        return it->second;
+      }
+    }
+    ++num_misses;
+    return std::nullopt;
+  }
+
+  /*!
+   * \brief Add the compiled module of a single-function TIR module to the cache.
+   * \param build_key The build key.
+   * \param mod The single-function TIR module.
+   * \param lib The compiled module.
+   */
+  void Insert(const BuildKey& build_key, const IRModule& mod, runtime::Module lib) {
+    std::unique_ptr<Table>& table = tables_[build_key];
+    if (table == nullptr) {
+      table = std::make_unique<Table>(/*bucket_count=*/0, meta_schedule::ModuleHash(*mod_eq_),
+                                      meta_schedule::ModuleEqual(*mod_eq_));
+    }
+    (*table)[mod] = lib;
+  }
+
+  /*! \brief The number of compiled functions in the cache. */
+  int64_t Size() const {
+    int64_t size = 0;
+    for (const auto& [build_key, table] : tables_) {
+      size += table->size();
+    }
+    return size;
+  }
+
+  /*! \brief Remove all the compiled functions and reset the statistics. */
+  void Clear() {
+    tables_.clear();
+    num_hits = 0;
+    num_misses = 0;
+  }
+
+  static void RegisterReflection() {
+    namespace refl = tvm::ffi::reflection;
+    refl::ObjectDef<FunctionBuildCacheNode>()
+        .def_ro("num_hits", &FunctionBuildCacheNode::num_hits)
+        .def_ro("num_misses", &FunctionBuildCacheNode::num_misses);
+  }
+
+  static constexpr const char* _type_key = "relax.FunctionBuildCache";
+  TVM_DECLARE_FINAL_OBJECT_INFO(FunctionBuildCacheNode, Object);
+
+ private:
+  using Table = std::unordered_map<IRModule, runtime::Module, meta_schedule::ModuleHash,
+                                   meta_schedule::ModuleEqual>;
+  /*! \brief The module equality used to hash and compare the functions. */
+  std::unique_ptr<meta_schedule::ModuleEquality> mod_eq_;
+  /*! \brief The cache tables of each build key. */
+  std::unordered_map<BuildKey, std::unique_ptr<Table>, StructuralHash, StructuralEqual> tables_;
+};
+
+class FunctionBuildCache : public ObjectRef {
+ public:
+  /*! \brief Create an empty function build cache. */
+  FunctionBuildCache() { data_ = make_object<FunctionBuildCacheNode>(); }
+
+  TVM_DEFINE_MUTABLE_NOTNULLABLE_OBJECT_REF_METHODS(FunctionBuildCache, ObjectRef,
+                                                    FunctionBuildCacheNode);
+};
+
+/*!
+ * \brief Split a TIR module into single-function modules, which keep the attributes of the
+ * module. The split is not possible when a function calls another function of the module.
+ * \param mod The TIR module.
+ * \return The single-function modules, or std::nullopt if the module cannot be split.
+ */
+Optional<Array<IRModule>> SplitTIRModule(const IRModule& mod) {
+  Array<IRModule> result;
+  for (const auto& [gv, base_func] : mod->functions) {
+    const auto* func = base_func.as<tir::PrimFuncNode>();
+    if (func == nullptr) {
+      return std::nullopt;
+    }
+    bool has_callee = false;
+    tir::PostOrderVisit(func->body, [&has_callee](const ObjectRef& obj) {
+      if (const auto* call = obj.as<tir::CallNode>()) {
+        if (call->op->IsInstance<GlobalVarNode>()) {
+          has_callee = true;
+        }
+      }
+    });
+    if (has_callee) {
+      return std::nullopt;
+    }
+    result.push_back(IRModule({{gv, base_func}}, /*map=*/{}, mod->attrs));
+  }
+  return result;
+}
+
+TVM_FFI_STATIC_INIT_BLOCK({ FunctionBuildCacheNode::RegisterReflection(); });
+
+TVM_FFI_STATIC_INIT_BLOCK({
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef()
+      .def("relax.FunctionBuildCache", []() { return FunctionBuildCache(); })
+      .def("relax.FunctionBuildCacheMakeKey", FunctionBuildCacheNode::MakeBuildKey)
+      .def("relax.FunctionBuildCacheLookup",
+           [](FunctionBuildCache cache, Array<Any> build_key, IRModule mod) {
+             return cache->Lookup(build_key, mod);
+           })
+      .def("relax.FunctionBuildCacheInsert",
+           [](FunctionBuildCache cache, Array<Any> build_key, IRModule mod,
+              runtime::Module lib) { cache->Insert(build_key, mod, lib); })
+      .def("relax.FunctionBuildCacheSize",
+           [](FunctionBuildCache cache) { return cache->Size(); })
+      .def("relax.FunctionBuildCacheClear", [](FunctionBuildCache cache) { cache->Clear(); })
+      .def("relax.SplitTIRModule", SplitTIRModule);
+});
+
+}  // namespace relax
+}  // namespace tvm
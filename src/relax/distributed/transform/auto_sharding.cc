@@ -0,0 +1,512 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/relax/distributed/transform/auto_sharding.cc
+ * \brief Pass for searching the sharding annotations of a function on a device mesh.
+ */
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/relax/analysis.h>
+#include <tvm/relax/distributed/axis_group_graph.h>
+#include <tvm/relax/distributed/transform.h>
+#include <tvm/relax/expr_functor.h>
+#include <tvm/tir/analysis.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "../../op/distributed/distributed.h"
+#include "utils.h"
+
+namespace tvm {
+namespace relax {
+namespace distributed {
+
+/*! \brief The per-device hardware parameters used to estimate the cost of a sharding plan. */
+struct ShardingCostParams {
+  /*! \brief The memory available on each device in bytes, or -1 if unlimited. */
+  int64_t memory_limit;
+  /*! \brief The bandwidth of the collective communication in bytes per second. */
+  double bandwidth;
+  /*! \brief The peak compute throughput of each device in flops per second. */
+  double peak_flops;
+};
+
+/*!
+ * \brief Search a sharding plan for a function on a device mesh.
+ *
+ * Tensor axes connected in the axis group graph always share their sharding after propagation,
+ * so the search space is the choice of at most one axis group per device mesh dimension. A plan
+ * is costed by the compute time of every call, divided by the number of devices the call is
+ * split across, plus the allreduce time of the calls whose reduction axis is sharded. Plans
+ * exceeding the per-device memory limit are only chosen when no plan fits.
+ */
+class ShardingPlanner {
+ public:
+  /*! \brief The annotation to insert after a binding: the placement of the bound var. */
+  using Plan = std::unordered_map<const VarNode*, Placement>;
+
+  static Plan Search(const Function& func, const IRModule& mod, const DeviceMesh& device_mesh,
+                     const ShardingCostParams& params) {
+    ShardingPlanner planner(device_mesh, params);
+    planner.Analyze(func, mod);
+    return planner.Search();
+  }
+
+ private:
+  /*! \brief A tensor of the function, possibly a field of a tuple var. */
+  struct TensorInfo {
+    const ExprNode* expr;
+    int tuple_index;
+    /*! \brief The number of elements and the size in bytes, 0 if the shape is not static. */
+    double elems;
+    double bytes;
+    /*! \brief The axis group of each dimension. */
+    std::vector<int> groups;
+  };
+
+  /*! \brief A call whose cost depends on the sharding of its inputs and outputs. */
+  struct CallInfo {
+    std::vector<int> inputs;
+    std::vector<int> outputs;
+    double flops;
+  };
+
+  /*! \brief An axis group, i.e. a candidate to shard along a device mesh dimension. */
+  struct GroupInfo {
+    bool shardable = true;
+    /*! \brief The gcd of the extents of all axes in the group. */
+    int64_t extent_gcd = 0;
+    /*! \brief The first bound var having an axis in the group, where the annotation goes. */
+    const VarNode* anchor = nullptr;
+    int anchor_dim = -1;
+  };
+
+  struct PlanCost {
+    bool fits;
+    double time;
+    double memory;
+
+    bool BetterThan(const PlanCost& other) const {
+      if (fits != other.fits) {
+        return fits;
+      }
+      if (!fits) {
+        return memory < other.memory;
+      }
+      // Prefer the plan using less memory when the estimated time is effectively equal.
+      const double eps = 1e-6 * std::max(time, other.time);
+      if (std::abs(time - other.time) > eps) {
+        return time < other.time;
+      }
+      return memory < other.memory;
+    }
+  };
+
+  ShardingPlanner(DeviceMesh device_mesh, ShardingCostParams params)
+      : device_mesh_(device_mesh), params_(params) {}
+
+  void Analyze(const Function& func, const IRModule& mod) {
+    BuildAxisGroupGraph(&axis_group_graph_, func, mod);
+    for (const Var& param : func->params) {
+      AddTensors(param.get(), GetStructInfo(param), /*is_binding=*/false);
+    }
+    PostOrderVisit(func->body, [&](const ObjectRef& obj) {
+      const auto* seq = obj.as<SeqExprNode>();
+      if (seq == nullptr) {
+        return;
+      }
+      for (const BindingBlock& block : seq->blocks) {
+        for (const Binding& binding : block->bindings) {
+          const auto* var_binding = binding.as<VarBindingNode>();
+          if (var_binding == nullptr) {
+            continue;
+          }
+          AddTensors(var_binding->var.get(), GetStructInfo(var_binding->var),
+                     /*is_binding=*/true);
+          if (const auto* call = var_binding->value.as<CallNode>()) {
+            AddCall(var_binding->var, GetRef<Call>(call), mod);
+          }
+        }
+      }
+    });
+    // Mark the groups that cannot be sharded consistently.
+    for (const auto& [axis, group] : axis2group_) {
+      if (axis.tensor->IsInstance<ConstantNode>()) {
+        groups_[group].shardable = false;
+      }
+    }
+    for (const TensorInfo& tensor : tensors_) {
+      std::unordered_set<int> seen;
+      for (int group : tensor.groups) {
+        if (!seen.insert(group).second) {
+          groups_[group].shardable = false;
+        }
+      }
+    }
+  }
+
+  int GetGroup(Axis axis) {
+    auto it = axis2group_.find(axis);
+    if (it != axis2group_.end()) {
+      return it->second;
+    }
+    int group = static_cast<int>(groups_.size());
+    groups_.emplace_back();
+    for (const Axis& member : axis_group_graph_.GetAxisGroup(axis)) {
+      axis2group_[member] = group;
+    }
+    return group;
+  }
+
+  void AddTensors(const ExprNode* expr, const StructInfo& sinfo, bool is_binding) {
+    if (const auto* tensor_sinfo = sinfo.as<TensorStructInfoNode>()) {
+      AddTensor(expr, 0, tensor_sinfo, is_binding);
+      if (is_binding) {
+        bound_vars_.insert(expr);
+      }
+    } else if (const auto* tuple_sinfo = sinfo.as<TupleStructInfoNode>()) {
+      for (int i = 0; i < static_cast<int>(tuple_sinfo->fields.size()); i++) {
+        if (const auto* field = tuple_sinfo->fields[i].as<TensorStructInfoNode>()) {
+          AddTensor(expr, i, field, /*is_binding=*/false);
+        }
+      }
+    }
+  }
+
+  void AddTensor(const ExprNode* expr, int tuple_index, const TensorStructInfoNode* sinfo,
+                 bool is_binding) {
+    TensorInfo tensor{expr, tuple_index, 0, 0, {}};
+    const auto* shape = sinfo->shape.as<ShapeExprNode>();
+    bool static_shape = shape != nullptr && !sinfo->dtype.is_void();
+    double elems = 1;
+    for (int i = 0; i < sinfo->ndim; i++) {
+      int group = GetGroup({expr, i, tuple_index});
+      tensor.groups.push_back(group);
+      GroupInfo& info = groups_[group];
+      const auto* extent = shape ? shape->values[i].as<IntImmNode>() : nullptr;
+      if (extent == nullptr) {
+        static_shape = false;
+        info.shardable = false;
+        continue;
+      }
+      elems *= extent->value;
+      info.extent_gcd = std::gcd(info.extent_gcd, extent->value);
+      if (is_binding && info.anchor == nullptr) {
+        info.anchor = static_cast<const VarNode*>(expr);
+        info.anchor_dim = i;
+      }
+    }
+    if (static_shape) {
+      tensor.elems = elems;
+      tensor.bytes = elems * sinfo->dtype.bytes() * sinfo->dtype.lanes();
+    }
+    tensor_index_[{expr, tuple_index}] = static_cast<int>(tensors_.size());
+    tensors_.push_back(std::move(tensor));
+  }
+
+  void AddCall(const Var& var, const Call& call, const IRModule& mod) {
+    static const Op& call_tir_op = Op::Get("relax.call_tir");
+    static const Op& matmul_op = Op::Get("relax.matmul");
+    CallInfo info;
+    auto collect = [this](const ExprNode* expr, std::vector<int>* indices) {
+      for (int i = 0;; i++) {
+        auto it = tensor_index_.find({expr, i});
+        if (it == tensor_index_.end()) {
+          break;
+        }
+        indices->push_back(it->second);
+      }
+    };
+    for (const Expr& arg : GetCallArgs(call)) {
+      if (arg->IsInstance<VarNode>() || arg->IsInstance<ConstantNode>()) {
+        collect(arg.get(), &info.inputs);
+      }
+    }
+    collect(var.get(), &info.outputs);
+    if (info.outputs.empty()) {
+      return;
+    }
+
+    double out_elems = 0;
+    for (int output : info.outputs) {
+      out_elems += tensors_[output].elems;
+    }
+    info.flops = out_elems;
+    if (call->op.same_as(call_tir_op)) {
+      if (Optional<tir::PrimFunc> prim_func = MatchPrimFunc(mod, call->args[0])) {
+        info.flops = tir::EstimateTIRFlops(prim_func.value()->body);
+      }
+    } else if (call->op.same_as(matmul_op)) {
+      const auto* lhs_sinfo = GetStructInfoAs<TensorStructInfoNode>(call->args[0]);
+      const auto* lhs_shape = lhs_sinfo ? lhs_sinfo->shape.as<ShapeExprNode>() : nullptr;
+      if (lhs_shape != nullptr && !lhs_shape->values.empty()) {
+        if (const auto* reduce_extent = lhs_shape->values.back().as<IntImmNode>()) {
+          info.flops = 2.0 * out_elems * reduce_extent->value;
+        }
+      }
+    }
+    calls_.push_back(std::move(info));
+  }
+
+  /*! \brief The number of devices a tensor is split across, given the mesh dim of each group. */
+  int64_t ShardFactor(const TensorInfo& tensor, const std::vector<int>& group2mesh_dim) const {
+    int64_t factor = 1;
+    for (int group : tensor.groups) {
+      if (group2mesh_dim[group] != -1) {
+        factor *= device_mesh_->shape[group2mesh_dim[group]];
+      }
+    }
+    return factor;
+  }
+
+  bool HasAxisInGroup(const std::vector<int>& tensors, int group) const {
+    for (int tensor : tensors) {
+      const std::vector<int>& groups = tensors_[tensor].groups;
+      if (std::find(groups.begin(), groups.end(), group) != groups.end()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  PlanCost Evaluate(const std::vector<int>& mesh_dim2group) const {
+    std::vector<int> group2mesh_dim(groups_.size(), -1);
+    for (int i = 0; i < static_cast<int>(mesh_dim2group.size()); i++) {
+      if (mesh_dim2group[i] != -1) {
+        group2mesh_dim[mesh_dim2group[i]] = i;
+      }
+    }
+    PlanCost cost{true, 0, 0};
+    // An upper bound that keeps every tensor alive, which orders the plans the same way.
+    for (const TensorInfo& tensor : tensors_) {
+      cost.memory += tensor.bytes / ShardFactor(tensor, group2mesh_dim);
+    }
+    if (params_.memory_limit >= 0) {
+      cost.fits = cost.memory <= static_cast<double>(params_.memory_limit);
+    }
+    for (const CallInfo& call : calls_) {
+      double parallelism = 1;
+      double comm_bytes = 0;
+      for (int i = 0; i < static_cast<int>(mesh_dim2group.size()); i++) {
+        int group = mesh_dim2group[i];
+        if (group == -1) {
+          continue;
+        }
+        bool in_outputs = HasAxisInGroup(call.outputs, group);
+        bool in_inputs = HasAxisInGroup(call.inputs, group);
+        if (!in_outputs && !in_inputs) {
+          continue;
+        }
+        int64_t n = device_mesh_->shape[i];
+        parallelism *= n;
+        if (in_inputs && !in_outputs) {
+          // The sharded axis is reduced, so the partial results are allreduced.
+          for (int output : call.outputs) {
+            const TensorInfo& tensor = tensors_[output];
+            comm_bytes +=
+                2.0 * (n - 1) / n * tensor.bytes / ShardFactor(tensor, group2mesh_dim);
+          }
+        }
+      }
+      cost.time += call.flops / params_.peak_flops / parallelism;
+      cost.time += comm_bytes / params_.bandwidth;
+    }
+    return cost;
+  }
+
+  Plan Search() {
+    int mesh_ndim = static_cast<int>(device_mesh_->shape.size());
+    std::vector<int> mesh_dim2group(mesh_ndim, -1);
+    if (!tensors_.empty()) {
+      // Coordinate descent over the mesh dims, larger dims first.
+      std::vector<int> dim_order(mesh_ndim);
+      std::iota(dim_order.begin(), dim_order.end(), 0);
+      std::stable_sort(dim_order.begin(), dim_order.end(), [this](int lhs, int rhs) {
+        return device_mesh_->shape[lhs] > device_mesh_->shape[rhs];
+      });
+      PlanCost best = Evaluate(mesh_dim2group);
+      constexpr int kMaxRounds = 4;
+      for (int round = 0; round < kMaxRounds; round++) {
+        bool changed = false;
+        for (int dim : dim_order) {
+          int64_t n = device_mesh_->shape[dim];
+          if (n <= 1) {
+            continue;
+          }
+          for (int group = 0; group < static_cast<int>(groups_.size()); group++) {
+            const GroupInfo& info = groups_[group];
+            if (!info.shardable || info.anchor == nullptr || info.extent_gcd % n != 0 ||
+                group == mesh_dim2group[dim] ||
+                std::find(mesh_dim2group.begin(), mesh_dim2group.end(), group) !=
+                    mesh_dim2group.end()) {
+              continue;
+            }
+            std::vector<int> candidate = mesh_dim2group;
+            candidate[dim] = group;
+            PlanCost cost = Evaluate(candidate);
+            if (cost.BetterThan(best)) {
+              best = cost;
+              mesh_dim2group = std::move(candidate);
+              changed = true;
+            }
+          }
+        }
+        if (!changed) {
+          break;
+        }
+      }
+      if (!best.fits) {
+        LOG(WARNING) << "No sharding plan fits in the memory limit of " << params_.memory_limit
+                     << " bytes, using the plan with the least memory of " << best.memory
+                     << " bytes per device";
+      }
+    }
+    return BuildPlan(mesh_dim2group);
+  }
+
+  Plan BuildPlan(const std::vector<int>& mesh_dim2group) {
+    int mesh_ndim = static_cast<int>(device_mesh_->shape.size());
+    std::unordered_map<const VarNode*, std::vector<PlacementSpec>> specs;
+    auto get_specs = [&](const VarNode* var) -> std::vector<PlacementSpec>& {
+      auto it = specs.find(var);
+      if (it == specs.end()) {
+        it = specs.emplace(var, std::vector<PlacementSpec>(mesh_ndim, PlacementSpec::Replica()))
+                 .first;
+      }
+      return it->second;
+    };
+    for (int i = 0; i < mesh_ndim; i++) {
+      if (mesh_dim2group[i] != -1) {
+        const GroupInfo& info = groups_[mesh_dim2group[i]];
+        get_specs(info.anchor)[i] = PlacementSpec::Sharding(info.anchor_dim);
+      }
+    }
+    // Every tensor needs a device mesh, which propagates through the calls as well.
+    std::unordered_set<const ExprNode*> covered;
+    auto cover = [&](const VarNode* var) {
+      for (const Axis& axis : axis_group_graph_.GetAxisGroup({var, -1})) {
+        covered.insert(axis.tensor);
+      }
+    };
+    for (const auto& kv : specs) {
+      cover(kv.first);
+    }
+    for (const TensorInfo& tensor : tensors_) {
+      if (!bound_vars_.count(tensor.expr) || covered.count(tensor.expr)) {
+        continue;
+      }
+      const auto* var = static_cast<const VarNode*>(tensor.expr);
+      get_specs(var);
+      cover(var);
+    }
+    Plan plan;
+    for (const auto& [var, var_specs] : specs) {
+      plan[var] = Placement(Array<PlacementSpec>(var_specs.begin(), var_specs.end()));
+    }
+    return plan;
+  }
+
+  struct TensorKeyHash {
+    size_t operator()(const std::pair<const ExprNode*, int>& key) const {
+      return std::hash<const ExprNode*>()(key.first) ^ (std::hash<int>()(key.second) << 1);
+    }
+  };
+
+  DeviceMesh device_mesh_;
+  ShardingCostParams params_;
+  AxisGroupGraph axis_group_graph_;
+  std::unordered_map<Axis, int, AxisHash> axis2group_;
+  std::vector<GroupInfo> groups_;
+  std::vector<TensorInfo> tensors_;
+  std::unordered_map<std::pair<const ExprNode*, int>, int, TensorKeyHash> tensor_index_;
+  std::vector<CallInfo> calls_;
+  /*! \brief The vars of tensor type bound in the function, which can be annotated. */
+  std::unordered_set<const ExprNode*> bound_vars_;
+};
+
+/*!
+ * \brief Insert relax.dist.annotate_sharding after the bindings chosen by the planner.
+ */
+class ShardingAnnotationInserter : public ExprMutator {
+ public:
+  ShardingAnnotationInserter(DeviceMesh device_mesh, ShardingPlanner::Plan plan)
+      : device_mesh_(device_mesh), plan_(std::move(plan)) {}
+
+  using ExprMutator::VisitBinding_;
+
+  void VisitBinding_(const VarBindingNode* binding) final {
+    ExprMutator::VisitBinding_(binding);
+    auto it = plan_.find(binding->var.get());
+    if (it == plan_.end()) {
+      return;
+    }
+    Expr value = annotate_sharding(VisitExpr(binding->var), device_mesh_, it->second);
+    String name = binding->var->name_hint() + "_sharded";
+    bool is_output =
+        builder_->CurrentBlockIsDataFlow() && !binding->var->IsInstance<DataflowVarNode>();
+    Var annotated = is_output ? builder_->EmitOutput(value, name) : builder_->Emit(value, name);
+    var_remap_[binding->var->vid] = annotated;
+  }
+
+ private:
+  DeviceMesh device_mesh_;
+  ShardingPlanner::Plan plan_;
+};
+
+namespace transform {
+
+Pass AutoSharding(DeviceMesh device_mesh, int64_t memory_limit, double bandwidth,
+                  double peak_flops) {
+  ICHECK_GT(bandwidth, 0) << "The bandwidth must be positive";
+  ICHECK_GT(peak_flops, 0) << "The peak flops must be positive";
+  ShardingCostParams params{memory_limit, bandwidth, peak_flops};
+  auto pass_func = [=](IRModule mod, PassContext pc) {
+    IRModule updated = mod;
+    for (const auto& [gv, base_func] : mod->functions) {
+      const auto* func = base_func.as<FunctionNode>();
+      if (func == nullptr || IsShardingAnnotatedFunc(GetRef<Function>(func)) ||
+          IsDistIRFunc(GetRef<Function>(func))) {
+        continue;
+      }
+      ShardingPlanner::Plan plan =
+          ShardingPlanner::Search(GetRef<Function>(func), mod, device_mesh, params);
+      if (plan.empty()) {
+        continue;
+      }
+      Function new_func =
+          Downcast<Function>(ShardingAnnotationInserter(device_mesh, plan)(GetRef<Function>(func)));
+      updated.CopyOnWrite()->Update(gv, new_func);
+    }
+    return updated;
+  };
+  return CreateModulePass(pass_func, 1, "AutoSharding", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK({
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.distributed.transform.AutoSharding", AutoSharding);
+});
+
+}  // namespace transform
+
+}  // namespace distributed
+}  // namespace relax
+}  // namespace tvm
@@ -23,6 +23,7 @@
 #include <tvm/ir/function.h>
 #include <tvm/ir/module.h>
 #include <tvm/relax/analysis.h>
+#include <tvm/relax/distributed/axis_group_graph.h>
 #include <tvm/relax/distributed/struct_info.h>
 #include <tvm/relax/expr_functor.h>
 namespace tvm {
@@ -60,6 +61,15 @@ bool IsDistIRFunc(Function func);
  */
 bool IsShardingAnnotatedFunc(Function func);
 
+/*!
+ * \brief Build the axis group graph of the given function.
+ * \param axis_group_graph The graph to add the axis edges to
+ * \param func The function to build the graph for
+ * \param mod The module containing the PrimFuncs called by the function
+ */
+void BuildAxisGroupGraph(AxisGroupGraph* axis_group_graph, const Function& func,
+                         const IRModule& mod);
+
 }  // namespace distributed
 }  // namespace relax
 }  // namespace tvm
@@ -138,11 +138,15 @@ IRModule FunctionPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
   for (const auto& it : updated_mod->functions) {
     // only picks up relax::Function
     if (auto* n = it.second.as<FunctionNode>()) {
-      Function func = GetRef<Function>(n);
-      auto updated_func = pass_func(func, updated_mod, pass_ctx);
-      updates.push_back({it.first, updated_func});
+      updates.push_back({it.first, GetRef<Function>(n)});
     }
   }
+  // The functions are independent, as updated_mod is only modified after
+  // all of them have been processed, so they may run concurrently.
+  RunFunctionPassTasks(pass_ctx, GetFunctionPassNumThreads(pass_ctx),
+                       static_cast<int>(updates.size()), [&](int i) {
+                         updates[i].second = pass_func(updates[i].second, updated_mod, pass_ctx);
+                       });
 
   for (const auto& pair : updates) {
     updated_mod->Add(pair.first, pair.second, true);
@@ -78,8 +78,10 @@ using tir::Layout;
  */
 class LayoutConvertMutator : public ExprMutator {
  public:
-  explicit LayoutConvertMutator(const Map<String, Array<String>>& desired_layouts)
-      : desired_layouts_(desired_layouts) {}
+  explicit LayoutConvertMutator(
+      const Map<String, Array<String>>& desired_layouts,
+      std::unordered_map<const CallNode*, Array<String>> call_desired_layouts = {})
+      : desired_layouts_(desired_layouts), call_desired_layouts_(std::move(call_desired_layouts)) {}
 
  private:
   Array<Integer> LayoutToIntegers(const Layout& layout) {
@@ -215,8 +217,15 @@ class LayoutConvertMutator : public ExprMutator {
   }
 
   void VisitBinding_(const VarBindingNode* binding, const CallNode* call_node) final {
-    Optional<InferLayoutOutput> res =
-        GetInferLayoutInfo(call_node, desired_layouts_, var_layout_map_);
+    Optional<InferLayoutOutput> res;
+    auto it = call_desired_layouts_.find(call_node);
+    if (it == call_desired_layouts_.end()) {
+      res = GetInferLayoutInfo(call_node, desired_layouts_, var_layout_map_);
+    } else if (!it->second.empty()) {
+      Map<String, Array<String>> desired_layouts{
+          {Downcast<Op>(call_node->op)->name, it->second}};
+      res = GetInferLayoutInfo(call_node, desired_layouts, var_layout_map_);
+    }
     ObjectPtr<CallNode> new_call = make_object<CallNode>(*call_node);
     new_call->struct_info_ = std::nullopt;
     if (!res.defined() ||
@@ -333,11 +342,14 @@ class LayoutConvertMutator : public ExprMutator {
 
   std::unordered_map<Var, NLayout> var_layout_map_;
   Map<String, Array<String>> desired_layouts_;
+  /*! \brief The desired layouts of individual calls, empty for the original layout. */
+  std::unordered_map<const CallNode*, Array<String>> call_desired_layouts_;
 };  // namespace relax
 
-DataflowBlock ConvertLayoutPass(const DataflowBlock& df_block,
-                                Map<String, Array<String>> desired_layouts) {
-  LayoutConvertMutator mutator(desired_layouts);
+DataflowBlock ConvertLayoutPass(
+    const DataflowBlock& df_block, Map<String, Array<String>> desired_layouts,
+    std::unordered_map<const CallNode*, Array<String>> call_desired_layouts) {
+  LayoutConvertMutator mutator(desired_layouts, std::move(call_desired_layouts));
   return Downcast<DataflowBlock>(mutator.VisitBindingBlock(df_block));
 }
 
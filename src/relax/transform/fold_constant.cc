@@ -28,19 +28,261 @@
 #include <tvm/tir/function.h>
 #include <tvm/tir/op.h>
 
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "utils.h"
+
 namespace tvm {
 namespace relax {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.fold_constant_batch_build", Bool);
+
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.fold_constant_build_cache_size", Integer);
+
+/*!
+ * \brief Process-wide cache of the PrimFuncs built for constant evaluation.
+ *
+ * Keyed by structural equality of the PrimFunc and of the parts of the
+ * PassContext that may change how the PrimFunc is lowered, so that the same
+ * PrimFunc is only built once across functions, modules and invocations of
+ * FoldConstant. The least recently used entries are evicted beyond the
+ * capacity given by the PassContext option "relax.fold_constant_build_cache_size".
+ */
+class FoldConstantBuildCache {
+ public:
+  /*! \brief The key of a build, with its structural hash computed once. */
+  struct Key {
+    ObjectRef value;
+    uint64_t hash;
+  };
+
+  static FoldConstantBuildCache* Global() {
+    static FoldConstantBuildCache* inst = new FoldConstantBuildCache();
+    return inst;
+  }
+
+  /*!
+   * \brief Make the key of a build.
+   *
+   * Besides the PrimFunc, the key holds the lowering options of the PassContext.
+   * \param func The PrimFunc to build.
+   * \param pass_ctx The PassContext the PrimFunc is built under.
+   * \return The key, or nullopt if it cannot be hashed, e.g. because of the
+   *  passes added through "tir.add_lower_pass". Such builds are not cached.
+   */
+  static std::optional<Key> MakeKey(const tir::PrimFunc& func,
+                                    const transform::PassContext& pass_ctx) {
+    Array<ObjectRef> value{func, GetTIRLoweringOptions(pass_ctx)};
+    try {
+      return Key{value, StructuralHash()(value)};
+    } catch (const tvm::Error& err) {
+      return std::nullopt;
+    }
+  }
+
+  /*!
+   * \brief Look up a build.
+   * \param key The key of the build.
+   * \param result Set to the cached build, which is nullopt if the build failed.
+   * \return Whether the build was found in the cache.
+   */
+  bool Lookup(const Key& key, Optional<ffi::Function>* result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) return false;
+    // Mark as the most recently used.
+    entries_.splice(entries_.begin(), entries_, it->second);
+    *result = it->second->second;
+    return true;
+  }
+
+  /*!
+   * \brief Insert a build.
+   * \param key The key of the build.
+   * \param build_func The build, nullopt if the build failed.
+   * \param capacity The maximum number of builds to keep.
+   */
+  void Insert(const Key& key, Optional<ffi::Function> build_func, size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      entries_.erase(it->second);
+      index_.erase(it);
+    }
+    if (capacity == 0) return;
+    entries_.emplace_front(key, std::move(build_func));
+    index_[key] = entries_.begin();
+    while (entries_.size() > capacity) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.clear();
+    entries_.clear();
+  }
+
+ private:
+  using Entry = std::pair<Key, Optional<ffi::Function>>;
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const { return key.hash; }
+  };
+
+  struct KeyEqual {
+    bool operator()(const Key& lhs, const Key& rhs) const {
+      return lhs.hash == rhs.hash && StructuralEqual()(lhs.value, rhs.value);
+    }
+  };
+
+  std::mutex mutex_;
+  /*! \brief The cached builds, from the most to the least recently used. */
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash, KeyEqual> index_;
+};
+
+/*!
+ * \brief Collect the PrimFuncs of call_tir bindings that may fold to constants.
+ *
+ * A binding may fold if all of its tensor arguments are constants or
+ * variables bound to bindings that may fold.  The result is a superset of
+ * the calls that ConstantFolder evaluates, used to build their PrimFuncs
+ * ahead of time in a single module.
+ */
+class FoldableCallTIRCollector : public ExprVisitor {
+ public:
+  static std::vector<tir::PrimFunc> Collect(const Function& func, const IRModule& ctx_module) {
+    FoldableCallTIRCollector collector(ctx_module);
+    collector.VisitExpr(func);
+    return collector.funcs_;
+  }
+
+ private:
+  explicit FoldableCallTIRCollector(IRModule ctx_module) : ctx_module_(std::move(ctx_module)) {}
+
+  void VisitBinding_(const VarBindingNode* binding) final {
+    ExprVisitor::VisitBinding_(binding);
+    static const Op& call_tir_op = Op::Get("relax.call_tir");
+    const Expr& value = binding->value;
+    bool maybe_constant = false;
+    if (value->IsInstance<ConstantNode>()) {
+      maybe_constant = true;
+    } else if (value->IsInstance<VarNode>()) {
+      maybe_constant = maybe_constant_.count(value.as<VarNode>());
+    } else if (const auto* call = value.as<CallNode>()) {
+      if (call->op.same_as(call_tir_op)) {
+        const auto* args = call->args.size() >= 2 ? call->args[1].as<TupleNode>() : nullptr;
+        const auto* gvar = call->args[0].as<GlobalVarNode>();
+        if (args != nullptr && gvar != nullptr && AllMaybeConstant(args->fields)) {
+          Optional<BaseFunc> base_func = ctx_module_->functions.Get(GetRef<GlobalVar>(gvar));
+          if (const auto* func = base_func.as<tir::PrimFuncNode>()) {
+            funcs_.push_back(GetRef<tir::PrimFunc>(func));
+            maybe_constant = true;
+          }
+        }
+      } else if (call->op->IsInstance<OpNode>()) {
+        // Other operators are legalized to call_tir when folded.
+        maybe_constant = AllMaybeConstant(call->args);
+      }
+    }
+    if (maybe_constant) {
+      maybe_constant_.insert(binding->var.get());
+    }
+  }
+
+  bool AllMaybeConstant(const Array<Expr>& args) const {
+    for (const Expr& arg : args) {
+      if (arg->IsInstance<ConstantNode>() || arg->IsInstance<ShapeExprNode>()) continue;
+      if (const auto* var = arg.as<VarNode>(); var != nullptr && maybe_constant_.count(var)) {
+        continue;
+      }
+      return false;
+    }
+    return true;
+  }
+
+  IRModule ctx_module_;
+  std::unordered_set<const VarNode*> maybe_constant_;
+  std::vector<tir::PrimFunc> funcs_;
+};
+
 class ConstantFolder : public ExprMutator {
  public:
-  static Function Fold(Function func, IRModule ctx_module) {
-    ConstantFolder folder(std::move(ctx_module));
+  static Function Fold(Function func, IRModule ctx_module, transform::PassContext pass_ctx) {
+    bool batch_build =
+        pass_ctx->GetConfig<Bool>("relax.fold_constant_batch_build", Bool(false)).value();
+    ConstantFolder folder(ctx_module, std::move(pass_ctx));
+    if (batch_build) {
+      folder.BuildBatch(FoldableCallTIRCollector::Collect(func, ctx_module));
+    }
     func = Downcast<Function>(RemoveAllUnused(folder(func)));
     return func;
   }
 
  private:
-  explicit ConstantFolder(IRModule ctx_module) : ExprMutator(ctx_module) {}
+  explicit ConstantFolder(IRModule ctx_module, transform::PassContext pass_ctx)
+      : ExprMutator(ctx_module),
+        pass_ctx_(pass_ctx),
+        cache_capacity_(
+            pass_ctx->GetConfig<Integer>("relax.fold_constant_build_cache_size", Integer(256))
+                .value()
+                ->value) {}
+
+  /*!
+   * \brief Build the PrimFuncs that are not cached yet together, as one module.
+   *
+   * If the combined build fails, e.g. because one of the PrimFuncs is
+   * scheduled for a GPU only, nothing is cached and each PrimFunc is built
+   * on its own by GetCachedBuild once it is evaluated.
+   */
+  void BuildBatch(const std::vector<tir::PrimFunc>& funcs) {
+    FoldConstantBuildCache* cache = FoldConstantBuildCache::Global();
+    std::vector<tir::PrimFunc> missing;
+    std::unordered_set<tir::PrimFunc, StructuralHash, StructuralEqual> visited;
+    std::vector<FoldConstantBuildCache::Key> missing_keys;
+    for (const tir::PrimFunc& func : funcs) {
+      if (!visited.insert(func).second) continue;
+      std::optional<FoldConstantBuildCache::Key> key =
+          FoldConstantBuildCache::MakeKey(func, pass_ctx_);
+      // The builds could not be cached, so they are left to GetCachedBuild.
+      if (!key.has_value()) return;
+      Optional<ffi::Function> cached;
+      if (!cache->Lookup(*key, &cached)) {
+        missing.push_back(func);
+        missing_keys.push_back(*key);
+      }
+    }
+    // A single function gains nothing from batching.
+    if (missing.size() <= 1) return;
+
+    Map<GlobalVar, BaseFunc> functions;
+    std::vector<std::string> symbols;
+    for (size_t i = 0; i < missing.size(); ++i) {
+      std::string symbol = "tir_function_" + std::to_string(i);
+      functions.Set(GlobalVar(symbol),
+                    WithAttr(missing[i], tvm::attr::kGlobalSymbol, String(symbol)));
+      symbols.push_back(symbol);
+    }
+    try {
+      const auto pf = tvm::ffi::Function::GetGlobalRequired("tir.build");
+      runtime::Module rt_module = pf(IRModule(functions), Target("llvm")).cast<runtime::Module>();
+      for (size_t i = 0; i < missing.size(); ++i) {
+        cache->Insert(missing_keys[i], rt_module.GetFunction(symbols[i]), cache_capacity_);
+      }
+    } catch (const tvm::Error& err) {
+      DLOG(WARNING) << "Batched build failure for " << missing.size()
+                    << " functions, falling back to individual builds. Error message: "
+                    << err.what();
+    }
+  }
 
   /*!
    * \brief Pattern match the shape inside the given struct info to a
@@ -102,15 +344,15 @@ class ConstantFolder : public ExprMutator {
    * \return The cached func, nullopt if func cannot be built.
    */
   Optional<ffi::Function> GetCachedBuild(tir::PrimFunc func) {
-    // TODO(tvm-team): consider another way of bulk extract and build PrimFunc once
-    // would be helpful for future cases where PrimFunc recursively call into each other
     Target eval_cpu_target{"llvm"};
 
-    auto it = func_build_cache_.find(func);
-    if (it != func_build_cache_.end()) {
-      return it->second;
-    }
+    FoldConstantBuildCache* cache = FoldConstantBuildCache::Global();
+    std::optional<FoldConstantBuildCache::Key> key =
+        FoldConstantBuildCache::MakeKey(func, pass_ctx_);
     Optional<ffi::Function> build_func = std::nullopt;
+    if (key.has_value() && cache->Lookup(*key, &build_func)) {
+      return build_func;
+    }
 
     try {
       // Not all the primfunc can be directly built via llvm, for example, if a function is
@@ -125,7 +367,9 @@ class ConstantFolder : public ExprMutator {
       // build failure may happen in which case we skip
       DLOG(WARNING) << "Build failure for function " << func << ", Error message: " << err.what();
     }
-    func_build_cache_[func] = build_func;
+    if (key.has_value()) {
+      cache->Insert(*key, build_func, cache_capacity_);
+    }
     return build_func;
   }
 
@@ -314,23 +558,27 @@ class ConstantFolder : public ExprMutator {
     return ExprMutator::VisitExpr_(op);
   }
 
-  // cache for function build, via structural equality
-  std::unordered_map<tir::PrimFunc, Optional<ffi::Function>, StructuralHash, StructuralEqual>
-      func_build_cache_;
+  /*! \brief The PassContext of the invocation, part of the key of the builds. */
+  transform::PassContext pass_ctx_;
+  /*! \brief The maximum number of builds kept in the process-wide cache. */
+  size_t cache_capacity_;
 };
 
 namespace transform {
 
 Pass FoldConstant() {
   auto pass_func = [=](Function f, IRModule m, PassContext pc) {
-    return ConstantFolder::Fold(f, m);
+    return ConstantFolder::Fold(f, m, pc);
   };
   return CreateFunctionPass(pass_func, 0, "FoldConstant", {});
 }
 
 TVM_FFI_STATIC_INIT_BLOCK({
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def("relax.transform.FoldConstant", FoldConstant);
+  refl::GlobalDef()
+      .def("relax.transform.FoldConstant", FoldConstant)
+      .def("relax.transform.FoldConstantClearCache",
+           []() { FoldConstantBuildCache::Global()->Clear(); });
 });
 
 }  // namespace transform
@@ -28,21 +28,27 @@
  */
 
 #include <tvm/ffi/reflection/registry.h>
+#include <tvm/meta_schedule/database.h>
 #include <tvm/relax/analysis.h>
 #include <tvm/relax/dataflow_matcher.h>
 #include <tvm/relax/dataflow_pattern.h>
 #include <tvm/relax/expr_functor.h>
 #include <tvm/relax/struct_info.h>
 #include <tvm/relax/transform.h>
+#include <tvm/target/target.h>
 #include <tvm/tir/analysis.h>
 #include <tvm/tir/expr_functor.h>
 #include <tvm/tir/function.h>
 
+#include <algorithm>
+#include <memory>
 #include <optional>
+#include <thread>
 
 #include "../../support/arena.h"
 #include "../analysis/graph_partitioner.h"
 #include "tvm/relax/expr.h"
+#include "roofline.h"
 #include "utils.h"
 
 namespace tvm {
@@ -98,6 +104,7 @@ using support::LinkNode;
 constexpr uint32_t kMaxFusedOps = 256;
 
 TVM_REGISTER_PASS_CONFIG_OPTION("relax.FuseOps.max_depth", Integer);
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.FuseOps.cost_model", Bool);
 
 class GraphCreator : public ExprVisitor {
  public:
@@ -1037,15 +1044,240 @@ class OperatorFusor : public ExprMutator {
   bool lift_constants_{true};
 };
 
-IRModule FuseOps(IRModule mod, int opt_level, size_t max_fuse_depth) {
+/*!
+ * \brief The estimated latency of the kernels generated for groups of graph nodes. It is used as
+ * the profitability check of the graph partitioner, so that a fusion allowed by the pattern rules
+ * is only committed when the fused kernel is estimated no slower than the separate ones.
+ *
+ * A kernel is estimated by a roofline on its flops and the bytes it reads and writes outside the
+ * group, plus a fixed launch overhead. When the producers of a reduction are fused into it, the
+ * fused kernel is assumed to be parallelized over the reduction output only. The estimate of a
+ * group is calibrated by the measured latency of its members in the MetaSchedule database.
+ */
+class FusionCostModel {
+ public:
+  using Node = IndexedForwardGraph::Node;
+
+  FusionCostModel(const IRModule& mod, const IndexedForwardGraph& graph,
+                  Optional<meta_schedule::Database> database, Optional<Target> target)
+      : mod_(mod), database_(std::move(database)), target_(std::move(target)) {
+    if (database_.defined() && target_.defined()) {
+      normalize_mod_ = tvm::ffi::Function::GetGlobal("tvm.meta_schedule.normalize_mod");
+    }
+    num_cores_ = target_.defined()
+                     ? target_.value()->GetAttr<Integer>("num-cores").value_or(-1).IntValue()
+                     : -1;
+    if (num_cores_ <= 0) {
+      num_cores_ = std::max<int64_t>(std::thread::hardware_concurrency(), 1);
+    }
+    std::unordered_map<const Object*, Expr> var2value;
+    for (const auto& [gv, base_func] : mod->functions) {
+      if (const auto* func = base_func.as<FunctionNode>()) {
+        PostOrderVisit(func->body, [&var2value](const ObjectRef& obj) {
+          if (const auto* seq = obj.as<SeqExprNode>()) {
+            for (const BindingBlock& block : seq->blocks) {
+              for (const Binding& binding : block->bindings) {
+                if (const auto* var_binding = binding.as<VarBindingNode>()) {
+                  var2value[var_binding->var.get()] = var_binding->value;
+                }
+              }
+            }
+          }
+        });
+      }
+    }
+    for (Node* node : graph.post_dfs_order) {
+      NodeInfo& info = node_info_[node];
+      if (node->ref->IsInstance<ExprNode>()) {
+        Expr expr = GetRef<Expr>(static_cast<const ExprNode*>(node->ref));
+        std::tie(info.out_elems, info.out_bytes) = StaticTensorSize(GetStructInfo(expr));
+      }
+      auto it = var2value.find(node->ref);
+      if (it != var2value.end()) {
+        AnalyzeKernel(it->second, &info);
+      }
+      for (auto* link = node->outputs.head; link != nullptr; link = link->next) {
+        node_info_[link->value.node].inputs.push_back(node);
+      }
+    }
+    for (Node* node : graph.post_dfs_order) {
+      NodeInfo& info = node_info_[node];
+      if (info.is_kernel) {
+        info.estimated_secs = Estimate({node});
+      }
+    }
+  }
+
+  bool operator()(const std::vector<std::vector<Node*>>& groups) const {
+    double separate_secs = 0;
+    std::vector<Node*> fused;
+    for (const std::vector<Node*>& group : groups) {
+      separate_secs += Cost(group);
+      fused.insert(fused.end(), group.begin(), group.end());
+    }
+    return Cost(fused) <= separate_secs;
+  }
+
+ private:
+  struct NodeInfo {
+    /*! \brief The producers of the node. */
+    std::vector<Node*> inputs;
+    double out_elems = 0;
+    double out_bytes = 0;
+    bool is_kernel = false;
+    double flops = 0;
+    /*! \brief The roofline estimate of the node as a separate kernel. */
+    double estimated_secs = 0;
+    /*! \brief The measured latency of the node as a separate kernel, or -1 if unknown. */
+    double measured_secs = -1;
+  };
+
+  static std::pair<double, double> StaticTensorSize(const StructInfo& sinfo) {
+    if (const auto* tensor = sinfo.as<TensorStructInfoNode>()) {
+      const auto* shape = tensor->shape.as<ShapeExprNode>();
+      if (shape == nullptr || tensor->dtype.is_void()) {
+        return {0, 0};
+      }
+      double elems = 1;
+      for (const PrimExpr& dim : shape->values) {
+        const auto* int_dim = dim.as<IntImmNode>();
+        if (int_dim == nullptr) {
+          return {0, 0};
+        }
+        elems *= int_dim->value;
+      }
+      return {elems, elems * tensor->dtype.bytes() * tensor->dtype.lanes()};
+    } else if (const auto* tuple = sinfo.as<TupleStructInfoNode>()) {
+      std::pair<double, double> total{0, 0};
+      for (const StructInfo& field : tuple->fields) {
+        auto [elems, bytes] = StaticTensorSize(field);
+        total.first += elems;
+        total.second += bytes;
+      }
+      return total;
+    }
+    return {0, 0};
+  }
+
+  void AnalyzeKernel(const Expr& value, NodeInfo* info) {
+    static const Op& call_tir_op = Op::Get("relax.call_tir");
+    static const Op& call_tir_inplace_op = Op::Get("relax.call_tir_inplace");
+    const auto* call = value.as<CallNode>();
+    if (call == nullptr ||
+        !(call->op.same_as(call_tir_op) || call->op.same_as(call_tir_inplace_op))) {
+      return;
+    }
+    const GlobalVar& gv = Downcast<GlobalVar>(call->args[0]);
+    auto func = mod_->Lookup(gv).as<tir::PrimFunc>();
+    if (!func.has_value()) {
+      return;
+    }
+    info->is_kernel = true;
+    info->flops = tir::EstimateTIRFlops(func.value()->body);
+    if (normalize_mod_.has_value()) {
+      IRModule workload = (*normalize_mod_)(func.value()).cast<IRModule>();
+      Optional<meta_schedule::TuningRecord> record =
+          database_.value()->QueryTuningRecord(workload, target_.value(), gv->name_hint);
+      if (record.defined() && record.value()->run_secs.defined() &&
+          !record.value()->run_secs.value().empty()) {
+        double total = 0;
+        for (const FloatImm& secs : record.value()->run_secs.value()) {
+          total += secs->value;
+        }
+        info->measured_secs = total / record.value()->run_secs.value().size();
+      }
+    }
+  }
+
+  /*! \brief The roofline estimate of the kernel fused from the given nodes. */
+  double Estimate(const std::vector<Node*>& nodes) const {
+    std::unordered_set<const Node*> members(nodes.begin(), nodes.end());
+    std::unordered_set<const Node*> external_inputs;
+    double flops = 0;
+    double bytes = 0;
+    double parallelism = static_cast<double>(num_cores_);
+    for (Node* node : nodes) {
+      const NodeInfo& info = node_info_.at(node);
+      flops += info.flops;
+      bool fused_producer = false;
+      for (Node* input : info.inputs) {
+        if (members.count(input)) {
+          fused_producer = true;
+        } else if (external_inputs.insert(input).second) {
+          bytes += node_info_.at(input).out_bytes;
+        }
+      }
+      bool external_output = node->extern_ref;
+      for (auto* link = node->outputs.head; link != nullptr; link = link->next) {
+        external_output |= !members.count(link->value.node);
+      }
+      if (external_output) {
+        bytes += info.out_bytes;
+      }
+      if (node->pattern == kCommReduce && fused_producer && info.out_elems > 0) {
+        parallelism = std::min(parallelism, info.out_elems);
+      }
+    }
+    double compute_secs = flops / (kRooflinePeakFlops * parallelism / num_cores_);
+    return std::max(compute_secs, bytes / kRooflineMemoryBandwidth) + kKernelOverhead;
+  }
+
+  /*! \brief The cost of the nodes as one kernel, calibrated by the measured members. */
+  double Cost(const std::vector<Node*>& nodes) const {
+    double measured = 0;
+    double estimated = 0;
+    bool has_kernel = false;
+    bool all_measured = true;
+    for (Node* node : nodes) {
+      const NodeInfo& info = node_info_.at(node);
+      if (!info.is_kernel) {
+        continue;
+      }
+      has_kernel = true;
+      all_measured &= info.measured_secs >= 0;
+      measured += info.measured_secs;
+      estimated += info.estimated_secs;
+    }
+    if (!has_kernel) {
+      return 0;
+    }
+    double cost = Estimate(nodes);
+    if (all_measured && estimated > 0) {
+      cost *= measured / estimated;
+    }
+    return cost;
+  }
+
+  /*! \brief The fixed cost in seconds of launching a kernel. */
+  static constexpr double kKernelOverhead = 2e-6;
+
+  IRModule mod_;
+  Optional<meta_schedule::Database> database_;
+  Optional<Target> target_;
+  std::optional<tvm::ffi::Function> normalize_mod_;
+  int64_t num_cores_;
+  std::unordered_map<const Node*, NodeInfo> node_info_;
+};
+
+IRModule FuseOps(IRModule mod, int opt_level, size_t max_fuse_depth, bool use_cost_model) {
   support::Arena arena;
 
   // Step 1. Create the indexed-forward graph according to the input IRModule.
   IndexedForwardGraph graph = GraphCreator::Create(mod, &arena);
 
-  // Step 2. Partition the graph by applying the fusion algorithm.
+  // Step 2. Partition the graph by applying the fusion algorithm, optionally only committing the
+  // fusions that are estimated to be profitable.
+  GraphPartitioner::FCheckFuse fcheck_fuse = nullptr;
+  if (use_cost_model) {
+    Target target = Target::Current(true);
+    auto cost_model = std::make_shared<FusionCostModel>(
+        mod, graph, meta_schedule::Database::Current(),
+        target.defined() ? Optional<Target>(target) : std::nullopt);
+    fcheck_fuse = [cost_model](const auto& groups) { return (*cost_model)(groups); };
+  }
   std::vector<GraphPartitioner::Group*> groups =
-      GraphPartitioner(&arena, opt_level, max_fuse_depth, /*max_function_args=*/0).Partition(graph);
+      GraphPartitioner(&arena, opt_level, max_fuse_depth, /*max_function_args=*/0, fcheck_fuse)
+          .Partition(graph);
 
   // Step 3. Transform the IRModule by fusing the operators in accordance with the graph partition
   // results.
@@ -1435,7 +1667,8 @@ Pass FuseOps(int fuse_opt_level) {
       [=](IRModule m, PassContext pc) {
         int opt_level = fuse_opt_level == -1 ? pc->opt_level : fuse_opt_level;
         auto max_fuse_depth = pc->GetConfig("relax.FuseOps.max_depth", Integer(kMaxFusedOps));
-        return relax::FuseOps(m, opt_level, max_fuse_depth.value().IntValue());
+        bool use_cost_model = pc->GetConfig<Bool>("relax.FuseOps.cost_model", Bool(false)).value();
+        return relax::FuseOps(m, opt_level, max_fuse_depth.value().IntValue(), use_cost_model);
       };
   return CreateModulePass(/*pass_function=*/pass_func,  //
                           /*opt_level=*/0,              //
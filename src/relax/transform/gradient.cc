@@ -32,7 +32,10 @@
 #include <tvm/relax/nested_msg.h>
 #include <tvm/relax/op_attr_types.h>
 #include <tvm/relax/transform.h>
+#include <tvm/relax/utils.h>
+#include <tvm/tir/analysis.h>
 
+#include <algorithm>
 #include <unordered_set>
 
 #include "../op/tensor/binary.h"
@@ -604,12 +607,15 @@ class BackwardBindingGenerator : private ExprVisitor {
 class GradientMutator : private ExprMutator {
  public:
   static IRModule Transform(IRModule mod, String func_name, Optional<Array<Var>> require_grads,
-                            int target_index) {
+                            int target_index, Map<Var, Var>* forward_var_map = nullptr) {
     // Step 1. Copy function
     auto* old_func = mod->Lookup(func_name).as<FunctionNode>();
     CHECK(old_func) << func_name << "is not a Relax Function";
     auto copier = FunctionCopier();
     auto new_func = copier.Copy(GetRef<Function>(old_func));
+    if (forward_var_map != nullptr) {
+      *forward_var_map = copier.GetVarMap();
+    }
 
     // Step 2. Handle the checkpoints and eliminate start_checkpoint and end_checkpoint ops
     auto cp_collector = CheckpointCollector();
@@ -776,6 +782,240 @@ class GradientMutator : private ExprMutator {
   Expr return_expr_;
 };
 
+/*!
+ * \brief Choose the forward vars to be recomputed in the backward pass under a memory budget, and
+ * mark them with start_checkpoint and end_checkpoint, so that Gradient recomputes them.
+ *
+ * The saved activations are the forward vars that the backward bindings use. They are found by
+ * differentiating the function once without checkpoints. Dropping a saved activation saves its
+ * bytes, but the inputs of its binding must be kept for the recomputation, unless they are
+ * dropped or are function parameters. The activations are considered in the increasing order of
+ * their recomputation FLOPs per byte, and each is dropped when that lowers the memory of the
+ * saved tensors, until the memory fits in the budget.
+ *
+ * Since the dropped activations die right after their forward uses, and their recomputation is
+ * emitted right before their backward uses, StaticPlanBlockMemory can reuse their storage in
+ * between.
+ */
+class CheckpointPlanner : private ExprMutator {
+ public:
+  static IRModule Transform(IRModule mod, String func_name, int64_t memory_budget,
+                            int target_index) {
+    auto* func = mod->Lookup(func_name).as<FunctionNode>();
+    CHECK(func) << func_name << " is not a Relax Function";
+    const auto* seq = func->body.as<SeqExprNode>();
+    if (seq == nullptr || seq->blocks.size() != 1 ||
+        !seq->blocks[0]->IsInstance<DataflowBlockNode>() || HasCheckpoint(seq->blocks[0])) {
+      // Leave the functions that Gradient rejects, or that are checkpointed by the user, as is.
+      return mod;
+    }
+
+    // Step 1. Find the saved activations by differentiating the function without checkpoints.
+    Map<Var, Var> forward_var_map;
+    IRModule grad_mod =
+        GradientMutator::Transform(mod, func_name, std::nullopt, target_index, &forward_var_map);
+    std::unordered_map<const VarNode*, Var> copy2orig;
+    for (const auto& [orig, copy] : forward_var_map) {
+      copy2orig[copy.get()] = orig;
+    }
+    std::unordered_set<const VarNode*> saved;
+    auto adjoint = Downcast<Function>(grad_mod->Lookup(func_name + "_adjoint"));
+    for (const BindingBlock& block : Downcast<SeqExpr>(adjoint->body)->blocks) {
+      for (const Binding& binding : block->bindings) {
+        if (copy2orig.count(binding->var.get())) {
+          continue;
+        }
+        PostOrderVisit(GetBoundValue(binding), [&](const Expr& e) {
+          auto it = copy2orig.find(e.as<VarNode>());
+          if (it != copy2orig.end() && it->second->IsInstance<DataflowVarNode>()) {
+            saved.insert(it->second.get());
+          }
+        });
+      }
+    }
+
+    // Step 2. Collect the bytes, the inputs and the recomputation FLOPs of the forward vars.
+    const auto* block = seq->blocks[0].as<DataflowBlockNode>();
+    std::unordered_set<const VarNode*> params;
+    for (const Var& param : func->params) {
+      params.insert(param.get());
+    }
+    std::unordered_map<const VarNode*, int64_t> bytes;
+    std::unordered_map<const VarNode*, std::vector<const VarNode*>> inputs;
+    std::vector<std::pair<double, const VarNode*>> candidates;
+    for (const Binding& binding : block->bindings) {
+      const VarNode* var = binding->var.get();
+      bytes[var] = StaticBytes(GetStructInfo(binding->var));
+      PostOrderVisit(GetBoundValue(binding), [&](const Expr& e) {
+        if (const auto* input = e.as<VarNode>()) {
+          inputs[var].push_back(input);
+        }
+      });
+      if (!saved.count(var) || bytes[var] <= 0 || inputs[var].empty()) {
+        continue;
+      }
+      double flops = EstimateFlops(mod, GetBoundValue(binding));
+      if (flops >= 0) {
+        candidates.push_back({flops / bytes[var], var});
+      }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    // Step 3. Drop the saved activations greedily until the memory fits in the budget.
+    auto f_memory = [&](const std::unordered_set<const VarNode*>& dropped) {
+      std::unordered_set<const VarNode*> kept;
+      for (const VarNode* var : saved) {
+        if (!dropped.count(var)) {
+          kept.insert(var);
+        }
+      }
+      for (const VarNode* var : dropped) {
+        for (const VarNode* input : inputs[var]) {
+          if (!dropped.count(input) && !params.count(input)) {
+            kept.insert(input);
+          }
+        }
+      }
+      int64_t memory = 0;
+      for (const VarNode* var : kept) {
+        memory += std::max<int64_t>(bytes.count(var) ? bytes[var] : 0, 0);
+      }
+      return memory;
+    };
+    std::unordered_set<const VarNode*> dropped;
+    int64_t memory = f_memory(dropped);
+    for (const auto& [ratio, var] : candidates) {
+      if (memory <= memory_budget) {
+        break;
+      }
+      dropped.insert(var);
+      int64_t new_memory = f_memory(dropped);
+      if (new_memory < memory) {
+        memory = new_memory;
+      } else {
+        dropped.erase(var);
+      }
+    }
+    if (dropped.empty()) {
+      return mod;
+    }
+
+    // Step 4. Mark the dropped vars with the checkpoint ops.
+    CheckpointPlanner planner(std::move(dropped));
+    auto new_func = Downcast<Function>(planner.VisitExpr(GetRef<Function>(func)));
+    IRModule result = mod;
+    result.CopyOnWrite()->Update(mod->GetGlobalVar(func_name), new_func);
+    return result;
+  }
+
+ private:
+  explicit CheckpointPlanner(std::unordered_set<const VarNode*> dropped)
+      : dropped_(std::move(dropped)) {}
+
+  static bool HasCheckpoint(const BindingBlock& block) {
+    static const auto s_cp = Op::Get("relax.grad.start_checkpoint");
+    static const auto e_cp = Op::Get("relax.grad.end_checkpoint");
+    for (const Binding& binding : block->bindings) {
+      if (const auto* call = GetBoundValue(binding).as<CallNode>()) {
+        if (call->op == s_cp || call->op == e_cp) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  /*! \brief The number of bytes of a tensor, or -1 if its shape is not static. */
+  static int64_t StaticBytes(const StructInfo& sinfo) {
+    const auto* tensor = sinfo.as<TensorStructInfoNode>();
+    if (tensor == nullptr || tensor->IsUnknownDtype() || !tensor->shape.defined()) {
+      return -1;
+    }
+    const auto* shape = tensor->shape.as<ShapeExprNode>();
+    if (shape == nullptr) {
+      return -1;
+    }
+    int64_t bytes = tensor->dtype.bytes() * tensor->dtype.lanes();
+    for (const PrimExpr& dim : shape->values) {
+      const auto* int_dim = dim.as<IntImmNode>();
+      if (int_dim == nullptr) {
+        return -1;
+      }
+      bytes *= int_dim->value;
+    }
+    return bytes;
+  }
+
+  /*! \brief Estimate the FLOPs to recompute a binding value, or -1 if it cannot be recomputed. */
+  static double EstimateFlops(const IRModule& mod, const Expr& value) {
+    static const Op& call_tir_op = Op::Get("relax.call_tir");
+    static const auto& legalize_map = Op::GetAttrMap<FLegalize>("FLegalize");
+    static const auto& purity_map = Op::GetAttrMap<Bool>("FPurity");
+    const auto* call = value.as<CallNode>();
+    const auto* op = call != nullptr ? call->op.as<OpNode>() : nullptr;
+    if (op == nullptr) {
+      return -1;
+    }
+    if (call->op.same_as(call_tir_op)) {
+      auto gv = Downcast<GlobalVar>(call->args[0]);
+      const auto* prim_func = mod->Lookup(gv).as<tir::PrimFuncNode>();
+      return prim_func != nullptr ? tir::EstimateTIRFlops(prim_func->body) : -1;
+    }
+    Op call_op = GetRef<Op>(op);
+    if (!purity_map.get(call_op, Bool(false))->value || !legalize_map.count(call_op)) {
+      return -1;
+    }
+    BlockBuilder bb = BlockBuilder::Create(IRModule());
+    legalize_map[call_op](bb, GetRef<Call>(call));
+    double flops = 0;
+    for (const auto& [gv, func] : bb->GetContextIRModule()->functions) {
+      if (const auto* prim_func = func.as<tir::PrimFuncNode>()) {
+        flops += tir::EstimateTIRFlops(prim_func->body);
+      }
+    }
+    return flops;
+  }
+
+  using ExprMutator::VisitBinding_;
+
+  void VisitBinding_(const VarBindingNode* binding) final {
+    static const Op& s_cp = Op::Get("relax.grad.start_checkpoint");
+    static const Op& e_cp = Op::Get("relax.grad.end_checkpoint");
+    bool is_dropped = dropped_.count(binding->var.get());
+    // A dropped binding reads the kept vars through start_checkpoint, and a kept binding reads
+    // the dropped vars through end_checkpoint.
+    Map<Var, Expr> replace;
+    PostOrderVisit(binding->value, [&](const Expr& e) {
+      const auto* var = e.as<VarNode>();
+      if (var == nullptr || is_dropped == static_cast<bool>(dropped_.count(var))) {
+        return;
+      }
+      std::unordered_map<const VarNode*, Var>& marks = is_dropped ? start_vars_ : end_vars_;
+      auto it = marks.find(var);
+      if (it == marks.end()) {
+        Call mark(is_dropped ? s_cp : e_cp, {GetRef<Var>(var)});
+        it = marks.emplace(var, builder_->Emit(mark, var->name_hint() + (is_dropped ? "_s" : "_e")))
+                 .first;
+      }
+      replace.Set(GetRef<Var>(var), it->second);
+    });
+    if (replace.empty()) {
+      builder_->EmitNormalized(GetRef<VarBinding>(binding));
+    } else {
+      Expr new_value = builder_->Normalize(Bind(binding->value, replace));
+      builder_->EmitNormalized(VarBinding(binding->var, new_value));
+    }
+  }
+
+  /*! \brief The forward vars to be recomputed. */
+  std::unordered_set<const VarNode*> dropped_;
+  /*! \brief The start_checkpoint var of each kept var read by the dropped bindings. */
+  std::unordered_map<const VarNode*, Var> start_vars_;
+  /*! \brief The end_checkpoint var of each dropped var read by the kept bindings. */
+  std::unordered_map<const VarNode*, Var> end_vars_;
+};
+
 namespace transform {
 
 Pass Gradient(String func_name, Optional<Array<Var>> require_grads, int target_index) {
@@ -788,9 +1028,21 @@ Pass Gradient(String func_name, Optional<Array<Var>> require_grads, int target_i
                           /*required=*/{});
 }
 
+Pass AutoCheckpoint(String func_name, int64_t memory_budget, int target_index) {
+  auto pass_func = [=](IRModule mod, PassContext pc) {
+    return relax::CheckpointPlanner::Transform(mod, func_name, memory_budget, target_index);
+  };
+  return CreateModulePass(/*pass_function=*/pass_func,
+                          /*opt_level=*/0,
+                          /*pass_name=*/"AutoCheckpoint",
+                          /*required=*/{});
+}
+
 TVM_FFI_STATIC_INIT_BLOCK({
   namespace refl = tvm::ffi::reflection;
-  refl::GlobalDef().def("relax.transform.Gradient", Gradient);
+  refl::GlobalDef()
+      .def("relax.transform.Gradient", Gradient)
+      .def("relax.transform.AutoCheckpoint", AutoCheckpoint);
 });
 
 }  // namespace transform
@@ -0,0 +1,394 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file src/relax/transform/horizontal_fuse_tir.cc
+ * \brief Pack the independent small call_tir of a dataflow block into one horizontally fused
+ * PrimFunc, whose outermost parallel loop dispatches each of its iterations to one of the
+ * original kernels.
+ */
+
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/relax/analysis.h>
+#include <tvm/relax/expr_functor.h>
+#include <tvm/relax/transform.h>
+#include <tvm/target/target.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace relax {
+
+/*! \brief The call_tir binding that can be packed into a horizontally fused kernel. */
+struct KernelInfo {
+  /*! \brief The index of the binding in the dataflow block. */
+  size_t binding_index;
+  /*! \brief The called PrimFunc. */
+  tir::PrimFunc func;
+  /*! \brief The tensor arguments of the call. */
+  Array<Expr> args;
+  /*! \brief The struct info of each output tensor. */
+  Array<StructInfo> outputs;
+  /*! \brief Whether the call returns a tuple. */
+  bool tuple_output;
+};
+
+/*!
+ * \brief Suffix the names of the blocks of a kernel, so that the blocks stay unique when the same
+ * PrimFunc is packed more than once and the fused PrimFunc can be scheduled.
+ */
+class BlockNameSuffixer : public tir::StmtMutator {
+ public:
+  static tir::Stmt Rename(const tir::Stmt& stmt, const std::string& suffix) {
+    BlockNameSuffixer renamer(suffix);
+    return renamer(stmt);
+  }
+
+ private:
+  explicit BlockNameSuffixer(std::string suffix) : suffix_(std::move(suffix)) {}
+
+  tir::Stmt VisitStmt_(const tir::BlockNode* op) final {
+    tir::Block block = Downcast<tir::Block>(tir::StmtMutator::VisitStmt_(op));
+    block.CopyOnWrite()->name_hint = std::string(block->name_hint) + suffix_;
+    return block;
+  }
+
+  std::string suffix_;
+};
+
+class HorizontalFuser : public ExprMutator {
+ public:
+  HorizontalFuser(IRModule mod, int64_t max_num_elements, int max_group_size)
+      : ExprMutator(mod),
+        mod_(mod),
+        max_num_elements_(max_num_elements),
+        max_group_size_(max_group_size) {}
+
+  IRModule Run() {
+    for (const auto& [gv, func] : mod_->functions) {
+      if (const auto* relax_func = func.as<FunctionNode>()) {
+        if (relax_func->GetAttr<String>(attr::kCodegen).has_value() ||
+            relax_func->GetAttr<String>(attr::kComposite).has_value()) {
+          continue;
+        }
+        Function new_func = Downcast<Function>(VisitExpr(GetRef<Function>(relax_func)));
+        builder_->UpdateFunction(gv, new_func);
+      }
+    }
+    if (num_fused_kernels_ > 0) {
+      LOG(INFO) << "HorizontalFuseTIR packed " << num_fused_kernels_ << " kernels into "
+                << num_fused_groups_ << ", reducing the number of kernels by "
+                << num_fused_kernels_ - num_fused_groups_;
+    }
+    return builder_->GetContextIRModule();
+  }
+
+  using ExprMutator::VisitBindingBlock_;
+
+  BindingBlock VisitBindingBlock_(const DataflowBlockNode* block) final {
+    const Array<Binding>& bindings = block->bindings;
+    // The level of a binding is the length of the longest chain of bindings in the block it
+    // depends on. The bindings of the same level are independent of each other.
+    std::unordered_map<const VarNode*, int> var_levels;
+    std::vector<int> levels;
+    levels.reserve(bindings.size());
+    for (const Binding& binding : bindings) {
+      int level = 0;
+      for (const Var& var : FreeVars(GetBoundValue(binding))) {
+        auto it = var_levels.find(var.get());
+        if (it != var_levels.end()) {
+          level = std::max(level, it->second + 1);
+        }
+      }
+      var_levels[binding->var.get()] = level;
+      levels.push_back(level);
+    }
+
+    // Group the candidate kernels by level, in the order of their bindings.
+    std::map<int, std::vector<KernelInfo>> level_kernels;
+    for (size_t i = 0; i < bindings.size(); ++i) {
+      if (std::optional<KernelInfo> kernel = GetKernelInfo(bindings[i], i)) {
+        level_kernels[levels[i]].push_back(std::move(kernel.value()));
+      }
+    }
+    std::vector<std::vector<KernelInfo>> groups;
+    std::unordered_map<size_t, int> binding_group;
+    for (auto& [level, kernels] : level_kernels) {
+      for (size_t begin = 0; begin + 1 < kernels.size(); begin += max_group_size_) {
+        size_t end = std::min(kernels.size(), begin + max_group_size_);
+        if (end - begin < 2) {
+          break;
+        }
+        for (size_t i = begin; i < end; ++i) {
+          binding_group[kernels[i].binding_index] = static_cast<int>(groups.size());
+        }
+        groups.emplace_back(kernels.begin() + begin, kernels.begin() + end);
+      }
+    }
+    if (groups.empty()) {
+      return ExprMutator::VisitBindingBlock_(block);
+    }
+
+    // Sorting the bindings by level keeps the block in a topological order, and places the
+    // members of each group next to each other.
+    std::vector<size_t> order(bindings.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t lhs, size_t rhs) { return levels[lhs] < levels[rhs]; });
+
+    std::vector<bool> group_emitted(groups.size(), false);
+    builder_->BeginDataflowBlock();
+    for (size_t index : order) {
+      auto it = binding_group.find(index);
+      if (it == binding_group.end()) {
+        VisitBinding(bindings[index]);
+      } else if (!group_emitted[it->second]) {
+        EmitGroup(groups[it->second], bindings);
+        group_emitted[it->second] = true;
+      }
+    }
+    return builder_->EndBlock();
+  }
+
+ private:
+  /*!
+   * \brief Check whether the binding is a call_tir to a small PrimFunc that has static shapes
+   * and is not scheduled yet.
+   */
+  std::optional<KernelInfo> GetKernelInfo(const Binding& binding, size_t index) {
+    static const Op& call_tir_op = Op::Get("relax.call_tir");
+    const auto* var_binding = binding.as<VarBindingNode>();
+    if (var_binding == nullptr) {
+      return std::nullopt;
+    }
+    const auto* call = var_binding->value.as<CallNode>();
+    if (call == nullptr || !call->op.same_as(call_tir_op) || call->args.size() != 2) {
+      return std::nullopt;
+    }
+    const auto* gv = call->args[0].as<GlobalVarNode>();
+    const auto* args = call->args[1].as<TupleNode>();
+    if (gv == nullptr || args == nullptr || !mod_->ContainGlobalVar(gv->name_hint)) {
+      return std::nullopt;
+    }
+    Optional<tir::PrimFunc> func = mod_->Lookup(GetRef<GlobalVar>(gv)).as<tir::PrimFunc>();
+    if (!func.defined()) {
+      return std::nullopt;
+    }
+
+    KernelInfo kernel;
+    kernel.binding_index = index;
+    kernel.func = func.value();
+    kernel.args = args->fields;
+    StructInfo out_sinfo = call->sinfo_args[0];
+    if (const auto* tuple_sinfo = out_sinfo.as<TupleStructInfoNode>()) {
+      kernel.outputs = tuple_sinfo->fields;
+      kernel.tuple_output = true;
+    } else {
+      kernel.outputs = {out_sinfo};
+      kernel.tuple_output = false;
+    }
+    if (kernel.func->params.size() != kernel.args.size() + kernel.outputs.size()) {
+      return std::nullopt;
+    }
+
+    int64_t num_elements = 0;
+    for (const StructInfo& output : kernel.outputs) {
+      const auto* tensor_sinfo = output.as<TensorStructInfoNode>();
+      if (tensor_sinfo == nullptr || tensor_sinfo->IsUnknownDtype()) {
+        return std::nullopt;
+      }
+      const auto* shape = tensor_sinfo->shape.as<ShapeExprNode>();
+      if (shape == nullptr) {
+        return std::nullopt;
+      }
+      int64_t output_elements = 1;
+      for (const PrimExpr& dim : shape->values) {
+        const auto* int_dim = dim.as<IntImmNode>();
+        if (int_dim == nullptr) {
+          return std::nullopt;
+        }
+        output_elements *= int_dim->value;
+      }
+      num_elements += output_elements;
+    }
+    if (num_elements > max_num_elements_) {
+      return std::nullopt;
+    }
+
+    for (const tir::Var& param : kernel.func->params) {
+      auto it = kernel.func->buffer_map.find(param);
+      if (it == kernel.func->buffer_map.end()) {
+        return std::nullopt;
+      }
+      for (const PrimExpr& dim : (*it).second->shape) {
+        if (!dim->IsInstance<IntImmNode>()) {
+          return std::nullopt;
+        }
+      }
+    }
+    // The kernels that already have parallel, vectorized or thread-bound loops are scheduled,
+    // and cannot be nested in the parallel dispatch loop.
+    bool scheduled = false;
+    tir::PostOrderVisit(kernel.func->body, [&scheduled](const ObjectRef& obj) {
+      if (const auto* loop = obj.as<tir::ForNode>()) {
+        if (loop->kind != tir::ForKind::kSerial && loop->kind != tir::ForKind::kUnrolled) {
+          scheduled = true;
+        }
+      }
+    });
+    if (scheduled) {
+      return std::nullopt;
+    }
+    return kernel;
+  }
+
+  /*!
+   * \brief Create the PrimFunc executing the kernels of a group. Its parameters are the inputs
+   * of all the kernels followed by the outputs of all the kernels, and the iteration i of its
+   * parallel dispatch loop runs the body of the i-th kernel. The blocks of the i-th kernel are
+   * suffixed with "_k{i}", and the buffers allocated by the root blocks of the kernels are
+   * allocated by the root block of the fused PrimFunc.
+   */
+  static tir::PrimFunc FuseKernels(const std::vector<KernelInfo>& kernels) {
+    Array<tir::Var> input_params;
+    Array<tir::Var> output_params;
+    Map<tir::Var, tir::Buffer> buffer_map;
+    Array<tir::Buffer> alloc_buffers;
+    std::vector<tir::Stmt> bodies;
+    for (size_t k = 0; k < kernels.size(); ++k) {
+      const KernelInfo& kernel = kernels[k];
+      // Renew the definitions, since the same PrimFunc may be called more than once.
+      tir::PrimFunc func = tir::RenewDefs(kernel.func);
+      for (size_t i = 0; i < func->params.size(); ++i) {
+        const tir::Var& param = func->params[i];
+        if (i < kernel.args.size()) {
+          input_params.push_back(param);
+        } else {
+          output_params.push_back(param);
+        }
+        buffer_map.Set(param, func->buffer_map.at(param));
+      }
+      tir::Stmt kernel_body = func->body;
+      if (const auto* realize = kernel_body.as<tir::BlockRealizeNode>()) {
+        const tir::Block& root = realize->block;
+        if (realize->iter_values.empty() && tir::is_one(realize->predicate) &&
+            root->iter_vars.empty() && root->match_buffers.empty() && root->annotations.empty() &&
+            !root->init.defined()) {
+          alloc_buffers.insert(alloc_buffers.end(), root->alloc_buffers.begin(),
+                               root->alloc_buffers.end());
+          kernel_body = root->body;
+        }
+      }
+      bodies.push_back(BlockNameSuffixer::Rename(kernel_body, "_k" + std::to_string(k)));
+    }
+
+    tir::Var kernel_index("kernel_index", DataType::Int(32));
+    tir::Stmt body = bodies.back();
+    for (int i = static_cast<int>(bodies.size()) - 2; i >= 0; --i) {
+      body = tir::IfThenElse(kernel_index == i, bodies[i], body);
+    }
+    body = tir::For(kernel_index, Integer(0), Integer(static_cast<int>(bodies.size())),
+                    tir::ForKind::kParallel, body);
+    body = tir::BlockRealize(/*iter_values=*/{}, /*predicate=*/Bool(true),
+                             tir::Block(/*iter_vars=*/{}, /*reads=*/{}, /*writes=*/{},
+                                        /*name_hint=*/"root", body, /*init=*/std::nullopt,
+                                        alloc_buffers));
+
+    Array<tir::Var> params = input_params;
+    params.insert(params.end(), output_params.begin(), output_params.end());
+    return tir::PrimFunc(params, body, VoidType(), buffer_map,
+                         DictAttrs({{"tir.noalias", Bool(true)}}));
+  }
+
+  /*! \brief Emit the call to the fused kernel of the group, and bind the original outputs. */
+  void EmitGroup(const std::vector<KernelInfo>& kernels, const Array<Binding>& bindings) {
+    static const Op& call_tir_op = Op::Get("relax.call_tir");
+    GlobalVar fused_gv = builder_->AddFunction(FuseKernels(kernels), "fused_horizontal");
+
+    Array<Expr> args;
+    Array<StructInfo> outputs;
+    for (const KernelInfo& kernel : kernels) {
+      for (const Expr& arg : kernel.args) {
+        args.push_back(VisitExpr(arg));
+      }
+      outputs.insert(outputs.end(), kernel.outputs.begin(), kernel.outputs.end());
+    }
+    Var fused = builder_->Emit(
+        Call(call_tir_op, {fused_gv, Tuple(args)}, {}, {TupleStructInfo(outputs)}),
+        "fused_horizontal");
+
+    int output_index = 0;
+    for (const KernelInfo& kernel : kernels) {
+      Array<Expr> fields;
+      for (size_t i = 0; i < kernel.outputs.size(); ++i) {
+        fields.push_back(TupleGetItem(fused, output_index++));
+      }
+      Expr value = kernel.tuple_output ? Expr(Tuple(fields)) : fields[0];
+      const Binding& binding = bindings[kernel.binding_index];
+      VisitBinding(VarBinding(binding->var, value, binding->span));
+    }
+    num_fused_kernels_ += kernels.size();
+    num_fused_groups_ += 1;
+  }
+
+  /*! \brief The input module. */
+  IRModule mod_;
+  /*! \brief The maximal number of output elements of a kernel to be fused. */
+  int64_t max_num_elements_;
+  /*! \brief The maximal number of kernels in a fused kernel. */
+  int max_group_size_;
+  /*! \brief The number of kernels replaced by the fused kernels. */
+  int num_fused_kernels_ = 0;
+  /*! \brief The number of fused kernels created. */
+  int num_fused_groups_ = 0;
+};
+
+namespace transform {
+
+Pass HorizontalFuseTIR(int64_t max_num_elements, int max_group_size) {
+  ICHECK_GE(max_group_size, 2) << "ValueError: The maximal group size must be at least 2, but got "
+                               << max_group_size;
+  auto pass_func = [=](IRModule mod, PassContext pc) {
+    // The kernels are dispatched by a parallel loop, which is only executable on CPU before the
+    // kernels are scheduled.
+    Target target = Target::Current(true);
+    if (target.defined() && target->GetTargetDeviceType() != kDLCPU) {
+      return mod;
+    }
+    return HorizontalFuser(mod, max_num_elements, max_group_size).Run();
+  };
+  return CreateModulePass(pass_func, /*opt_level=*/0, "HorizontalFuseTIR", /*required=*/{});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK({
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.transform.HorizontalFuseTIR", HorizontalFuseTIR);
+});
+
+}  // namespace transform
+}  // namespace relax
+}  // namespace tvm
@@ -268,6 +268,18 @@ bool NoDesiredLayout(const Call& call, const Map<String, Array<String>>& desired
  */
 LayoutDecision FollowDecision(const LayoutDecision& src, int dst_ndim);
 
+/*!
+ * \brief Convert the layouts of the bindings in a dataflow block.
+ * \param df_block The dataflow block to be converted.
+ * \param desired_layouts The desired layouts of each operator.
+ * \param call_desired_layouts The desired layouts of individual calls, which take precedence
+ * over desired_layouts. An empty array keeps the call in its original layout.
+ * \return The converted dataflow block.
+ */
+DataflowBlock ConvertLayoutPass(
+    const DataflowBlock& df_block, Map<String, Array<String>> desired_layouts,
+    std::unordered_map<const CallNode*, Array<String>> call_desired_layouts = {});
+
 }  // namespace relax
 }  // namespace tvm
 
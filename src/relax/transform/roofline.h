@@ -0,0 +1,41 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relax/transform/roofline.h
+ * \brief The machine model of the roofline estimates used by the cost models of the passes.
+ * \sa tvm/relax/transform/fuse_ops.cc
+ * \sa tvm/relax/transform/select_layout.cc
+ */
+
+#ifndef TVM_RELAX_TRANSFORM_ROOFLINE_H_
+#define TVM_RELAX_TRANSFORM_ROOFLINE_H_
+
+namespace tvm {
+namespace relax {
+
+/*! \brief The peak FLOP/s of all the cores in the roofline estimates. */
+constexpr double kRooflinePeakFlops = 1e11;
+/*! \brief The memory bandwidth in bytes/s of the roofline estimates. */
+constexpr double kRooflineMemoryBandwidth = 2e10;
+
+}  // namespace relax
+}  // namespace tvm
+
+#endif  // TVM_RELAX_TRANSFORM_ROOFLINE_H_
@@ -0,0 +1,440 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file src/relax/transform/select_layout.cc
+ * \brief Select the layout of each layout-sensitive call by minimizing the estimated cost.
+ * \details
+ * Unlike ConvertLayout, which converts every call of an operator to one user-given layout,
+ * this pass takes a list of candidate layouts for each operator and decides per call.
+ *
+ * For each call of a candidate operator in a dataflow block, and for each of its candidates
+ * (including the original layout), we legalize the converted call and estimate the time of
+ * the resulting kernels. When a MetaSchedule database is in scope, the tuned run time of a
+ * kernel is used if the database has a record of it. Otherwise the kernel time is estimated
+ * with a roofline over its FLOPs and the bytes of its buffers.
+ *
+ * The layout of a call output is propagated by ConvertLayout through the following layout
+ * inferable ops. So the data input of each call follows the layout of at most one earlier
+ * candidate call, and the calls form a forest. A layout transform is inserted on an edge of
+ * the forest when the layouts at its two ends differ, as well as when a call consumes a
+ * tensor of the original layout or its output leaves the region where layouts propagate.
+ * The assignment with the minimal total cost is found exactly by dynamic programming over
+ * the forest, and is applied with the layout conversion of ConvertLayout.
+ */
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/meta_schedule/database.h>
+#include <tvm/relax/expr_functor.h>
+#include <tvm/relax/op_attr_types.h>
+#include <tvm/relax/transform.h>
+#include <tvm/relax/utils.h>
+#include <tvm/target/target.h>
+#include <tvm/tir/analysis.h>
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "infer_layout_utils.h"
+#include "roofline.h"
+
+namespace tvm {
+namespace relax {
+
+/*! \brief The number of bytes of a tensor, or -1 if its shape is not static. */
+static int64_t StaticTensorBytes(const StructInfo& sinfo) {
+  const auto* tensor = sinfo.as<TensorStructInfoNode>();
+  if (tensor == nullptr || tensor->IsUnknownDtype()) {
+    return -1;
+  }
+  const auto* shape = tensor->shape.as<ShapeExprNode>();
+  if (shape == nullptr) {
+    return -1;
+  }
+  int64_t bytes = tensor->dtype.bytes() * tensor->dtype.lanes();
+  for (const PrimExpr& dim : shape->values) {
+    const auto* int_dim = dim.as<IntImmNode>();
+    if (int_dim == nullptr) {
+      return -1;
+    }
+    bytes *= int_dim->value;
+  }
+  return bytes;
+}
+
+/*! \brief The estimator of the time of calls and layout transforms. */
+class LayoutCostEstimator {
+ public:
+  explicit LayoutCostEstimator(Optional<meta_schedule::Database> database,
+                               Optional<Target> target)
+      : database_(std::move(database)), target_(std::move(target)) {
+    if (database_.defined() && target_.defined()) {
+      normalize_mod_ = tvm::ffi::Function::GetGlobal("tvm.meta_schedule.normalize_mod");
+    }
+  }
+
+  /*!
+   * \brief Estimate the time of the kernels that a call is legalized into.
+   * \return The estimated time in seconds, or -1 if the call cannot be legalized.
+   */
+  double EstimateCall(const Call& call) {
+    static const auto& legalize_map = Op::GetAttrMap<FLegalize>("FLegalize");
+    const auto* op = call->op.as<OpNode>();
+    if (op == nullptr || !legalize_map.count(GetRef<Op>(op))) {
+      return -1;
+    }
+    BlockBuilder bb = BlockBuilder::Create(IRModule());
+    legalize_map[GetRef<Op>(op)](bb, call);
+    double cost = 0;
+    for (const auto& [gv, func] : bb->GetContextIRModule()->functions) {
+      if (const auto* prim_func = func.as<tir::PrimFuncNode>()) {
+        cost += EstimatePrimFunc(GetRef<tir::PrimFunc>(prim_func), gv->name_hint);
+      }
+    }
+    return cost;
+  }
+
+  /*! \brief Estimate the time of moving a tensor of the given bytes into another layout. */
+  static double EstimateTransform(int64_t bytes) {
+    return 2.0 * std::max<int64_t>(bytes, 0) / kRooflineMemoryBandwidth;
+  }
+
+ private:
+  double EstimatePrimFunc(const tir::PrimFunc& func, const String& name) {
+    if (normalize_mod_.has_value()) {
+      IRModule mod = (*normalize_mod_)(func).cast<IRModule>();
+      Optional<meta_schedule::TuningRecord> record =
+          database_.value()->QueryTuningRecord(mod, target_.value(), name);
+      if (record.defined() && record.value()->run_secs.defined() &&
+          !record.value()->run_secs.value().empty()) {
+        double total = 0;
+        for (const FloatImm& secs : record.value()->run_secs.value()) {
+          total += secs->value;
+        }
+        return total / record.value()->run_secs.value().size();
+      }
+    }
+    double flops = tir::EstimateTIRFlops(func->body);
+    double bytes = 0;
+    for (const auto& [var, buffer] : func->buffer_map) {
+      double buffer_bytes = buffer->dtype.bytes() * buffer->dtype.lanes();
+      for (const PrimExpr& dim : buffer->shape) {
+        const auto* int_dim = dim.as<IntImmNode>();
+        buffer_bytes *= int_dim != nullptr ? int_dim->value : 1;
+      }
+      bytes += buffer_bytes;
+    }
+    return std::max(flops / kRooflinePeakFlops, bytes / kRooflineMemoryBandwidth);
+  }
+
+  /*! \brief The database of the tuned kernels. */
+  Optional<meta_schedule::Database> database_;
+  /*! \brief The target that the kernels are tuned for. */
+  Optional<Target> target_;
+  /*! \brief The function to normalize a PrimFunc into a database workload. */
+  std::optional<tvm::ffi::Function> normalize_mod_;
+};
+
+/*! \brief The selector of the layout of each candidate call in a dataflow block. */
+class LayoutSelector {
+ public:
+  explicit LayoutSelector(Map<String, Array<Array<String>>> candidate_layouts,
+                          LayoutCostEstimator* estimator)
+      : candidate_layouts_(std::move(candidate_layouts)), estimator_(estimator) {}
+
+  /*!
+   * \brief Select the layouts of the candidate calls in a dataflow block.
+   * \return The desired layouts of each candidate call, empty for the original layout.
+   */
+  std::unordered_map<const CallNode*, Array<String>> Select(const DataflowBlock& block) {
+    CollectNodes(block);
+    std::vector<int> choices = Solve();
+    std::unordered_map<const CallNode*, Array<String>> result;
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+      result[nodes_[i].call] = nodes_[i].layouts[choices[i]];
+    }
+    return result;
+  }
+
+ private:
+  /*! \brief A candidate call together with the cost of each of its layouts. */
+  struct Node {
+    const CallNode* call;
+    /*! \brief The node whose output layout the data input follows, or -1 for the original. */
+    int producer{-1};
+    /*! \brief Whether the output is used outside the region where layouts propagate. */
+    bool has_sink{false};
+    int64_t data_bytes{0};
+    int64_t out_bytes{0};
+    std::string init_data_layout;
+    std::string init_out_layout;
+    /*! \brief The candidate layouts, the first of which is the original layout. */
+    std::vector<Array<String>> layouts;
+    std::vector<std::string> data_layouts;
+    std::vector<std::string> out_layouts;
+    /*! \brief The cost of the kernels and the weight transforms of each candidate. */
+    std::vector<double> costs;
+    std::vector<int> consumers;
+  };
+
+  void CollectNodes(const DataflowBlock& block) {
+    static const auto& infer_layout_map = Op::GetAttrMap<FRelaxInferLayout>("FRelaxInferLayout");
+    // The node whose output layout each var follows.
+    std::unordered_map<const VarNode*, int> var2node;
+    auto f_mark_sink = [&](const Expr& expr) {
+      PostOrderVisit(expr, [&](const Expr& e) {
+        if (const auto* var = e.as<VarNode>()) {
+          auto it = var2node.find(var);
+          if (it != var2node.end()) {
+            nodes_[it->second].has_sink = true;
+          }
+        }
+      });
+    };
+
+    for (const Binding& binding : block->bindings) {
+      const auto* var_binding = binding.as<VarBindingNode>();
+      const auto* call = var_binding != nullptr ? var_binding->value.as<CallNode>() : nullptr;
+      const auto* op = call != nullptr ? call->op.as<OpNode>() : nullptr;
+      bool is_dataflow_var = binding->var->IsInstance<DataflowVarNode>();
+      bool is_tensor = GetStructInfo(binding->var)->IsInstance<TensorStructInfoNode>();
+      if (op == nullptr || (!is_dataflow_var && !is_tensor) || call->args.empty() ||
+          !infer_layout_map.count(GetRef<Op>(op))) {
+        // The inputs of the binding are converted back to the original layout.
+        f_mark_sink(GetBoundValue(binding));
+        continue;
+      }
+
+      int producer = -1;
+      if (const auto* data = call->args[0].as<VarNode>()) {
+        auto it = var2node.find(data);
+        if (it != var2node.end()) {
+          producer = it->second;
+        }
+      }
+      // Other inputs are converted to the layout that the call desires, regarded as a
+      // conversion back to the original layout of their producers.
+      for (size_t i = 1; i < call->args.size(); ++i) {
+        f_mark_sink(call->args[i]);
+      }
+
+      if (candidate_layouts_.count(op->name)) {
+        std::optional<Node> node = CreateNode(GetRef<Call>(call), candidate_layouts_[op->name]);
+        if (node.has_value()) {
+          int index = static_cast<int>(nodes_.size());
+          node.value().producer = producer;
+          // The output bound to a non-dataflow var is converted back to the original layout.
+          node.value().has_sink = !is_dataflow_var;
+          if (producer >= 0) {
+            nodes_[producer].consumers.push_back(index);
+          }
+          nodes_.push_back(std::move(node.value()));
+          var2node[binding->var.get()] = index;
+          continue;
+        }
+      }
+      // The layout of the data input propagates to the output.
+      if (producer >= 0 && is_dataflow_var) {
+        var2node[binding->var.get()] = producer;
+      } else if (producer >= 0) {
+        nodes_[producer].has_sink = true;
+      }
+    }
+  }
+
+  std::optional<Node> CreateNode(const Call& call, const Array<Array<String>>& candidates) {
+    static const auto& infer_layout_map = Op::GetAttrMap<FRelaxInferLayout>("FRelaxInferLayout");
+    Op op = Downcast<Op>(call->op);
+    Node node;
+    node.call = call.get();
+    node.data_bytes = StaticTensorBytes(GetStructInfo(call->args[0]));
+    node.out_bytes = StaticTensorBytes(GetStructInfo(call));
+    if (node.data_bytes < 0 || node.out_bytes < 0) {
+      return std::nullopt;
+    }
+    NLayout init_data = InitialNLayout(call->args[0]);
+    NLayout init_out = InitialNLayout(call);
+    if (!init_data.IsLeaf() || !init_out.IsLeaf()) {
+      return std::nullopt;
+    }
+    node.init_data_layout = init_data.LeafValue().name();
+    node.init_out_layout = init_out.LeafValue().name();
+
+    double original_cost = estimator_->EstimateCall(call);
+    if (original_cost < 0) {
+      return std::nullopt;
+    }
+    node.layouts.push_back(Array<String>());
+    node.data_layouts.push_back(node.init_data_layout);
+    node.out_layouts.push_back(node.init_out_layout);
+    node.costs.push_back(original_cost);
+
+    for (const Array<String>& layouts : candidates) {
+      Map<String, Array<String>> desired_layouts{{op->name, layouts}};
+      InferLayoutOutput infer =
+          infer_layout_map[op](call, desired_layouts, VarLayoutMap());
+      if (infer->input_layouts.empty() || infer->output_layouts.empty() ||
+          !infer->input_layouts[0].IsLeaf() || !infer->output_layouts[0].IsLeaf()) {
+        continue;
+      }
+      std::string data_layout = infer->input_layouts[0].LeafValue().name();
+      std::string out_layout = infer->output_layouts[0].LeafValue().name();
+      Optional<Call> converted = ConvertCall(call, layouts);
+      if (!converted.defined()) {
+        continue;
+      }
+      double cost = estimator_->EstimateCall(converted.value());
+      if (cost < 0) {
+        continue;
+      }
+      // The weights are transformed in place of the call, unless they are folded as constants.
+      for (size_t i = 1; i < infer->input_layouts.size() && i < call->args.size(); ++i) {
+        const NLayout& layout = infer->input_layouts[i];
+        if (!call->args[i]->IsInstance<ConstantNode>() && layout.IsLeaf() &&
+            !NLayoutEqual()(layout, InitialNLayout(call->args[i]))) {
+          cost += LayoutCostEstimator::EstimateTransform(
+              StaticTensorBytes(GetStructInfo(call->args[i])));
+        }
+      }
+      node.layouts.push_back(layouts);
+      node.data_layouts.push_back(data_layout);
+      node.out_layouts.push_back(out_layout);
+      node.costs.push_back(cost);
+    }
+    return node;
+  }
+
+  /*! \brief Convert a single call to the given layouts, without the surrounding transforms. */
+  static Optional<Call> ConvertCall(const Call& call, const Array<String>& layouts) {
+    Op op = Downcast<Op>(call->op);
+    DataflowVar out("out", GetStructInfo(call));
+    DataflowBlock block({VarBinding(out, call)});
+    DataflowBlock converted = ConvertLayoutPass(block, {{op->name, layouts}});
+    for (const Binding& binding : converted->bindings) {
+      if (const auto* converted_call = GetBoundValue(binding).as<CallNode>()) {
+        if (converted_call->op.same_as(op)) {
+          return GetRef<Call>(converted_call);
+        }
+      }
+    }
+    return std::nullopt;
+  }
+
+  /*! \brief The cost of a node in a layout, excluding the edges to its producer and consumers. */
+  double UnaryCost(const Node& node, int choice) const {
+    double cost = node.costs[choice];
+    if (node.producer < 0 && node.data_layouts[choice] != node.init_data_layout) {
+      cost += LayoutCostEstimator::EstimateTransform(node.data_bytes);
+    }
+    if (node.has_sink && node.out_layouts[choice] != node.init_out_layout) {
+      cost += LayoutCostEstimator::EstimateTransform(node.out_bytes);
+    }
+    return cost;
+  }
+
+  /*! \brief The cost of the edge from a producer layout to a consumer layout. */
+  double EdgeCost(const Node& producer, int producer_choice, const Node& consumer,
+                  int consumer_choice) const {
+    if (producer.out_layouts[producer_choice] == consumer.data_layouts[consumer_choice]) {
+      return 0;
+    }
+    return LayoutCostEstimator::EstimateTransform(consumer.data_bytes);
+  }
+
+  /*! \brief The minimal cost of a consumer subtree given the layout of its producer. */
+  double BestConsumerCost(const Node& producer, int producer_choice, int consumer,
+                          int* best_choice) const {
+    double best = std::numeric_limits<double>::infinity();
+    for (size_t c = 0; c < nodes_[consumer].layouts.size(); ++c) {
+      double cost = subtree_costs_[consumer][c] +
+                    EdgeCost(producer, producer_choice, nodes_[consumer], static_cast<int>(c));
+      if (cost < best) {
+        best = cost;
+        *best_choice = static_cast<int>(c);
+      }
+    }
+    return best;
+  }
+
+  /*! \brief Find the layout assignment of the minimal total cost. */
+  std::vector<int> Solve() {
+    // Producers always come before their consumers, so the subtree costs are computed
+    // in the reverse order.
+    int num_nodes = static_cast<int>(nodes_.size());
+    subtree_costs_.assign(num_nodes, {});
+    for (int i = num_nodes - 1; i >= 0; --i) {
+      const Node& node = nodes_[i];
+      for (size_t c = 0; c < node.layouts.size(); ++c) {
+        double cost = UnaryCost(node, static_cast<int>(c));
+        for (int consumer : node.consumers) {
+          int unused;
+          cost += BestConsumerCost(node, static_cast<int>(c), consumer, &unused);
+        }
+        subtree_costs_[i].push_back(cost);
+      }
+    }
+    std::vector<int> choices(num_nodes, 0);
+    for (int i = 0; i < num_nodes; ++i) {
+      const Node& node = nodes_[i];
+      if (node.producer < 0) {
+        const std::vector<double>& costs = subtree_costs_[i];
+        choices[i] = static_cast<int>(std::min_element(costs.begin(), costs.end()) - costs.begin());
+      }
+      for (int consumer : node.consumers) {
+        BestConsumerCost(node, choices[i], consumer, &choices[consumer]);
+      }
+    }
+    return choices;
+  }
+
+  /*! \brief The candidate layouts of each operator. */
+  Map<String, Array<Array<String>>> candidate_layouts_;
+  /*! \brief The cost estimator. */
+  LayoutCostEstimator* estimator_;
+  /*! \brief The candidate calls in the order of their bindings. */
+  std::vector<Node> nodes_;
+  /*! \brief The minimal cost of the subtree rooted at each node in each of its layouts. */
+  std::vector<std::vector<double>> subtree_costs_;
+};
+
+namespace transform {
+
+Pass SelectLayout(Map<String, Array<Array<String>>> candidate_layouts) {
+  ffi::TypedFunction<DataflowBlock(DataflowBlock, IRModule, PassContext)> pass_func =
+      [=](DataflowBlock df_block, IRModule m, PassContext pc) {
+        Target target = Target::Current(true);
+        LayoutCostEstimator estimator(meta_schedule::Database::Current(),
+                                      target.defined() ? Optional<Target>(target) : std::nullopt);
+        LayoutSelector selector(candidate_layouts, &estimator);
+        std::unordered_map<const CallNode*, Array<String>> call_layouts =
+            selector.Select(df_block);
+        return ConvertLayoutPass(df_block, {}, std::move(call_layouts));
+      };
+  return CreateDataflowBlockPass(pass_func, 0, "SelectLayout", {});
+}
+
+TVM_FFI_STATIC_INIT_BLOCK({
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("relax.transform.SelectLayout", SelectLayout);
+});
+
+}  // namespace transform
+}  // namespace relax
+}  // namespace tvm
@@ -52,6 +52,16 @@
  * including dynamically-sized tensors, without requiring that
  * `StaticPlanBlockMemory` track these dynamic-sized tensors.
  *
+ * When the PassContext option "relax.memory_plan_arena" is set, the second
+ * stage plans offsets instead of token reuse: every constant-size tensor in
+ * the "global" scope keeps its own token together with its live range, and
+ * at the end of each binding block the tokens of a device are laid into one
+ * arena greedily by size. The third stage then emits a single
+ * `memory.alloc_storage` per arena, and each `memory.alloc_tensor` takes its
+ * planned offset into it. Each planned function is annotated with the
+ * constant bytes planned by the token reuse ("relax.memory_plan_token_bytes")
+ * and by the arena ("relax.memory_plan_arena_bytes").
+ *
  * The memory planning pass "supports" dynamic shape in the way of TIR variable
  * upper bound annotation. To be more specific, we can annotate the attribute
  * "tir_var_upper_bound" to Relax functions. The attribute value is a dict from
@@ -71,8 +81,10 @@
 #include <tvm/relax/expr_functor.h>
 #include <tvm/relax/nested_msg.h>
 #include <tvm/relax/transform.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <algorithm>
 #include <map>
 #include <set>
 #include <vector>
@@ -265,6 +277,15 @@ class TokenAllocator1D {
     full_pool_.clear();
   }
 
+  /*! \brief The total number of bytes of the allocated tokens that have constant size. */
+  int64_t TotalConstBytes() const {
+    int64_t total = 0;
+    for (const StorageToken& token : full_pool_) {
+      total += std::max<int64_t>(token->const_bytes(), 0);
+    }
+    return total;
+  }
+
  private:
   /*! \brief The hash class to enable std::pair as map key class. */
   struct PairHash {
@@ -688,8 +709,8 @@ class StorageAllocatorInit : public StorageAllocatorBaseVisitor {
 class StorageAllocator : public StorageAllocatorBaseVisitor {
  public:
   explicit StorageAllocator(std::unordered_map<const ExprNode*, Tokens> token_map,
-                            arith::Analyzer* analyzer)
-      : allocator_(analyzer) {
+                            arith::Analyzer* analyzer, bool use_arena = false)
+      : allocator_(analyzer), reuse_shadow_allocator_(analyzer), use_arena_(use_arena) {
     this->token_map_ = std::move(token_map);
   }
 
@@ -701,7 +722,15 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
       }
       // Clear the allocator to make the planning of different functions independent.
       allocator_.Clear();
+      reuse_shadow_allocator_.Clear();
+      arena_bytes_ = 0;
       this->VisitExpr_(func);
+      if (use_arena_) {
+        // The tokens outside the arenas are planned by token reuse in both plans.
+        int64_t other_bytes = allocator_.TotalConstBytes();
+        func2token_bytes[it.first] = other_bytes + reuse_shadow_allocator_.TotalConstBytes();
+        func2arena_bytes[it.first] = other_bytes + arena_bytes_;
+      }
     }
   }
 
@@ -712,6 +741,18 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
   std::unordered_map<const ExprNode*, StorageToken> alloc_tensor2token;
   /*! \brief The mapping from each binding block to the storage tokens that are create inside. */
   std::unordered_map<const BindingBlockNode*, std::vector<const StorageTokenNode*>> block2tokens;
+  /*! \brief The offset of each arena-planned `builtin.alloc_tensor` into its arena. */
+  std::unordered_map<const ExprNode*, int64_t> alloc_tensor2offset;
+  /*!
+   * \brief The constant number of bytes planned for each function by token reuse alone.
+   * Only computed when planning arenas.
+   */
+  std::unordered_map<GlobalVar, int64_t, ObjectPtrHash, ObjectPtrEqual> func2token_bytes;
+  /*!
+   * \brief The constant number of bytes planned for each function with arenas.
+   * Only computed when planning arenas.
+   */
+  std::unordered_map<GlobalVar, int64_t, ObjectPtrHash, ObjectPtrEqual> func2arena_bytes;
 
  private:
   using ExprVisitor::VisitBinding_;
@@ -724,10 +765,17 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
     for (const StorageTokenNode* token : block2tokens[block]) {
       ICHECK_EQ(token->ref_counter, 0);
     }
+    this->PlanArena(block);
+  }
+
+  void VisitBindingBlock_(const DataflowBlockNode* block) final {
+    StorageAllocatorBaseVisitor::VisitBindingBlock_(block);
+    this->PlanArena(block);
   }
 
   void VisitBinding_(const VarBindingNode* binding, const CallNode* call) final {
     static const Op& alloc_tensor_op = Op::Get("relax.builtin.alloc_tensor");
+    ++binding_index_;
     if (call->op == alloc_tensor_op) {
       auto it = token_map_.find(call);
       ICHECK(it != token_map_.end());
@@ -738,10 +786,30 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
         return;
       }
       ICHECK(it->second.IsLeaf());
-      StorageToken new_token = this->RequestReuseOrAlloc(it->second.LeafValue());
-
-      // Record that this alloc_tensor is using the token.
-      alloc_tensor2token.insert({call, new_token});
+      StorageToken prototype = it->second.LeafValue();
+      StorageToken new_token = prototype;
+      const auto* device_index = Downcast<PrimValue>(call->args[2])->value.as<IntImmNode>();
+      if (use_arena_ && prototype->const_bytes() >= 0 && prototype->storage_scope == "global" &&
+          device_index != nullptr) {
+        // Plan a copy of the token with token reuse alone, to report the bytes it would take.
+        StorageToken shadow(make_object<StorageTokenNode>(*prototype.get()));
+        Optional<StorageToken> reused = reuse_shadow_allocator_.RequestReuse(shadow);
+        if (!reused.defined()) {
+          reused = reuse_shadow_allocator_.Alloc(shadow, n_shadow_storage_++);
+        }
+        token2reuse_shadow_.insert({prototype.get(), reused.value()});
+        // The token keeps its own storage and only records its live range. The
+        // offset into the arena is decided at the end of the binding block.
+        prototype->storage_id = this->n_storage_++;
+        live_range_[prototype.get()] = {binding_index_, binding_index_};
+        ICHECK(!block_stack_.empty());
+        block2arena_tensors_[block_stack_.back()].push_back(
+            {call, prototype, device_index->value});
+      } else {
+        new_token = this->RequestReuseOrAlloc(prototype);
+        // Record that this alloc_tensor is using the token.
+        alloc_tensor2token.insert({call, new_token});
+      }
       token2cur_tensor_[new_token.get()].push_back(binding->var);
       SetTokens(call, Tokens(new_token));
       // Record that the token is allocated in the current block.
@@ -798,19 +866,116 @@ class StorageAllocator : public StorageAllocatorBaseVisitor {
     ICHECK_GE(token->ref_counter, 0);
 
     if (token->ref_counter == 0) {
-      allocator_.Release(token);
+      auto it_range = live_range_.find(token.get());
+      if (it_range != live_range_.end()) {
+        it_range->second.second = binding_index_;
+        StorageToken shadow = token2reuse_shadow_.at(token.get());
+        shadow->ref_counter = 0;
+        reuse_shadow_allocator_.Release(shadow);
+      } else {
+        allocator_.Release(token);
+      }
       auto it = token2cur_tensor_.find(token.get());
       ICHECK(it != token2cur_tensor_.end());
       token2cur_tensor_.erase(it);
     }
   }
 
+  /*!
+   * \brief Lay the arena tokens allocated in the given block into one arena per device.
+   * \details The tokens are placed in decreasing size order, each at the lowest aligned
+   * offset that does not overlap a placed token whose live range intersects its own.
+   * \param block The binding block whose tokens are to be planned.
+   */
+  void PlanArena(const BindingBlockNode* block) {
+    auto it = block2arena_tensors_.find(block);
+    if (it == block2arena_tensors_.end()) {
+      return;
+    }
+    std::map<int64_t, std::vector<ArenaTensor>> device2tensors;
+    for (const ArenaTensor& tensor : it->second) {
+      device2tensors[tensor.device_index].push_back(tensor);
+    }
+    block2arena_tensors_.erase(it);
+
+    for (auto& [device_index, tensors] : device2tensors) {
+      std::stable_sort(tensors.begin(), tensors.end(),
+                       [](const ArenaTensor& lhs, const ArenaTensor& rhs) {
+                         return lhs.token->const_bytes() > rhs.token->const_bytes();
+                       });
+      std::vector<int64_t> offsets;
+      int64_t arena_bytes = 0;
+      for (size_t i = 0; i < tensors.size(); ++i) {
+        const auto& [begin, end] = live_range_.at(tensors[i].token.get());
+        int64_t size = tensors[i].token->const_bytes();
+        // Collect the address ranges taken by the placed tokens that are alive together.
+        std::vector<std::pair<int64_t, int64_t>> occupied;
+        for (size_t j = 0; j < i; ++j) {
+          const auto& [other_begin, other_end] = live_range_.at(tensors[j].token.get());
+          if (begin <= other_end && other_begin <= end) {
+            occupied.push_back({offsets[j], offsets[j] + tensors[j].token->const_bytes()});
+          }
+        }
+        std::sort(occupied.begin(), occupied.end());
+        int64_t offset = 0;
+        for (const auto& [lo, hi] : occupied) {
+          if (offset + size <= lo) {
+            break;
+          }
+          offset = std::max(offset, AlignOffset(hi));
+        }
+        offsets.push_back(offset);
+        arena_bytes = std::max(arena_bytes, offset + size);
+      }
+
+      StorageToken arena({IntImm(DataType::Int(64), arena_bytes)}, DataType::UInt(8), "global");
+      arena->storage_id = this->n_storage_++;
+      for (size_t i = 0; i < tensors.size(); ++i) {
+        alloc_tensor2token.insert({tensors[i].call, arena});
+        alloc_tensor2offset[tensors[i].call] = offsets[i];
+      }
+      arena_bytes_ += arena_bytes;
+    }
+  }
+
+  /*! \brief Round the offset up to the allocation alignment of the runtime. */
+  static int64_t AlignOffset(int64_t offset) {
+    constexpr int64_t align = runtime::kAllocAlignment;
+    return (offset + align - 1) / align * align;
+  }
+
+  /*! \brief A `builtin.alloc_tensor` whose storage is planned in an arena. */
+  struct ArenaTensor {
+    const ExprNode* call;
+    StorageToken token;
+    int64_t device_index;
+  };
+
   /*! \brief Number of allocated storages. */
   int n_storage_{0};
   /*! \brief The 1D memory allocator. */
   TokenAllocator1D allocator_;
+  /*!
+   * \brief The 1D memory allocator that plans copies of the arena tokens with token reuse,
+   * only to report the bytes that token reuse would take.
+   */
+  TokenAllocator1D reuse_shadow_allocator_;
+  /*! \brief Number of storages allocated by the shadow allocator. */
+  int n_shadow_storage_{0};
+  /*! \brief The copy planned by the shadow allocator for each arena token. */
+  std::unordered_map<const StorageTokenNode*, StorageToken> token2reuse_shadow_;
   /*! \brief The mapping from each token to the tensors that are currently using it. */
   std::unordered_map<const StorageTokenNode*, std::vector<Var>> token2cur_tensor_;
+  /*! \brief Whether to plan the constant-size tokens into arenas. */
+  bool use_arena_;
+  /*! \brief The index of the call binding being visited, used as the time of live ranges. */
+  int64_t binding_index_{0};
+  /*! \brief The live range of each arena token, from its allocation to its last use. */
+  std::unordered_map<const StorageTokenNode*, std::pair<int64_t, int64_t>> live_range_;
+  /*! \brief The tensors of each binding block that wait for arena planning. */
+  std::unordered_map<const BindingBlockNode*, std::vector<ArenaTensor>> block2arena_tensors_;
+  /*! \brief The bytes of the arenas planned in the current function. */
+  int64_t arena_bytes_{0};
 };
 
 /*!
@@ -824,10 +989,12 @@ class StorageAllocationRewriter : public ExprMutator {
   explicit StorageAllocationRewriter(
       IRModule mod, std::unordered_map<const ExprNode*, StorageToken> alloc_tensor2token,
       std::unordered_map<const BindingBlockNode*, std::vector<const StorageTokenNode*>>
-          block2tokens)
+          block2tokens,
+      std::unordered_map<const ExprNode*, int64_t> alloc_tensor2offset = {})
       : ExprMutator(std::move(mod)),
         alloc_tensor2token_(std::move(alloc_tensor2token)),
-        block2tokens_(std::move(block2tokens)) {}
+        block2tokens_(std::move(block2tokens)),
+        alloc_tensor2offset_(std::move(alloc_tensor2offset)) {}
 
   IRModule Rewrite() {
     const IRModule& mod = builder_->GetContextIRModule();
@@ -888,7 +1055,9 @@ class StorageAllocationRewriter : public ExprMutator {
       }
 
       // And always create a `memory.alloc_tensor` for the old `builtin.alloc_tensor`.
-      PrimValue offset = PrimValue::Int64(0);
+      auto it_offset = alloc_tensor2offset_.find(call);
+      PrimValue offset =
+          PrimValue::Int64(it_offset != alloc_tensor2offset_.end() ? it_offset->second : 0);
       DataType dtype = sinfo->dtype;
       return Call(mem_alloc_tensor, {storage_var, offset, sinfo->shape.value(), DataTypeImm(dtype)},
                   Attrs());
@@ -941,31 +1110,51 @@ class StorageAllocationRewriter : public ExprMutator {
   std::unordered_map<const ExprNode*, StorageToken> alloc_tensor2token_;
   /*! \brief The mapping from each binding block to the storage tokens that are create inside. */
   std::unordered_map<const BindingBlockNode*, std::vector<const StorageTokenNode*>> block2tokens_;
+  /*! \brief The offset of each arena-planned `builtin.alloc_tensor` into its storage. */
+  std::unordered_map<const ExprNode*, int64_t> alloc_tensor2offset_;
   /*! \brief The mapping from each token to its corresponding storage var in each function. */
   std::unordered_map<const StorageTokenNode*, Var> token2storage_var_;
 };
 
-IRModule StaticPlanBlockMemory(IRModule mod) {
+IRModule StaticPlanBlockMemory(IRModule mod, bool use_arena) {
   arith::Analyzer ana;
 
   // Step 1. Initialize.
   std::unordered_map<const ExprNode*, Tokens> token_map =
       StorageAllocatorInit::Initialize(mod, &ana);
   // Step 2. Collect the memory allocation info.
-  StorageAllocator allocator(std::move(token_map), &ana);
+  StorageAllocator allocator(std::move(token_map), &ana, use_arena);
   allocator.Allocate(mod);
   // Step 3. Rewrite the function.
   StorageAllocationRewriter rewriter(std::move(mod),  //
                                      std::move(allocator.alloc_tensor2token),
-                                     std::move(allocator.block2tokens));
-  return rewriter.Rewrite();
+                                     std::move(allocator.block2tokens),
+                                     std::move(allocator.alloc_tensor2offset));
+  IRModule result = rewriter.Rewrite();
+  if (!use_arena) {
+    return result;
+  }
+
+  IRModuleNode* result_ptr = result.CopyOnWrite();
+  for (const auto& [gv, arena_bytes] : allocator.func2arena_bytes) {
+    Function func = Downcast<Function>(result_ptr->Lookup(gv));
+    func = WithAttr(std::move(func), "relax.memory_plan_token_bytes",
+                    IntImm(DataType::Int(64), allocator.func2token_bytes.at(gv)));
+    func = WithAttr(std::move(func), "relax.memory_plan_arena_bytes",
+                    IntImm(DataType::Int(64), arena_bytes));
+    result_ptr->Update(gv, func);
+  }
+  return result;
 }
 
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relax.memory_plan_arena", Bool);
+
 Pass StaticPlanBlockMemory() {
   auto pass_func = [=](IRModule m, PassContext pc) {
-    return relax::StaticPlanBlockMemory(std::move(m));
+    bool use_arena = pc->GetConfig<Bool>("relax.memory_plan_arena", Bool(false)).value();
+    return relax::StaticPlanBlockMemory(std::move(m), use_arena);
   };
   return CreateModulePass(pass_func, /*opt_level=*/0, "StaticPlanBlockMemory", {});
 }
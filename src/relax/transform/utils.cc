@@ -21,6 +21,8 @@
 
 #include <tvm/relax/analysis.h>
 
+#include "../../support/utils.h"
+
 namespace tvm {
 namespace relax {
 
@@ -92,5 +94,16 @@ Function ComposeFunctions(Function func_a, Function func_b) {
   return new_function;
 }
 
+Array<ObjectRef> GetTIRLoweringOptions(const transform::PassContext& pass_ctx) {
+  Map<String, Any> tir_config;
+  for (const auto& [name, value] : pass_ctx->config) {
+    if (support::StartsWith(name, "tir.")) {
+      tir_config.Set(name, value);
+    }
+  }
+  return {Integer(pass_ctx->opt_level), pass_ctx->required_pass, pass_ctx->disabled_pass,
+          tir_config};
+}
+
 }  // namespace relax
 }  // namespace tvm
@@ -26,6 +26,7 @@
 
 #include <builtin_fp16.h>
 #include <tvm/ir/module.h>
+#include <tvm/ir/transform.h>
 #include <tvm/relax/expr.h>
 #include <tvm/relax/expr_functor.h>
 #include <tvm/tir/expr_functor.h>
@@ -450,6 +451,19 @@ Function BundleModelParams(const Function& func, Optional<String> param_tuple_na
  */
 TVM_DLL Function ComposeFunctions(Function func_a, Function func_b);
 
+/*!
+ * \brief Get the parts of a PassContext that may change how a PrimFunc is lowered.
+ *
+ * These are the opt_level, the required and disabled passes, and the config
+ * options prefixed with "tir.". The caches of compiled PrimFuncs compare them
+ * structurally. They cannot always be hashed, e.g. when passes are added
+ * through "tir.add_lower_pass".
+ *
+ * \param pass_ctx The PassContext.
+ * \return The lowering options of the PassContext.
+ */
+Array<ObjectRef> GetTIRLoweringOptions(const transform::PassContext& pass_ctx);
+
 }  // namespace relax
 }  // namespace tvm
 
@@ -0,0 +1,272 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \file perf_event.cc
+ * \brief Hardware performance counters via the Linux perf_event_open interface.
+ */
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <tvm/ffi/reflection/registry.h>
+#include <tvm/runtime/contrib/perf_event.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+/*! \brief Counters collected when the user does not request any. */
+static const std::vector<std::string> default_perf_event_names = {"cycles", "instructions",
+                                                                  "cache-misses", "branch-misses"};
+
+/*! \brief Cache event config as described in `man perf_event_open`. */
+static constexpr uint64_t CacheEventConfig(uint64_t cache, uint64_t op, uint64_t result) {
+  return cache | (op << 8) | (result << 16);
+}
+
+/*! \brief Mapping from user visible counter names to (type, config) pairs for perf_event_attr. */
+static const std::unordered_map<std::string, std::pair<uint32_t, uint64_t>>& PerfEventTable() {
+  static const std::unordered_map<std::string, std::pair<uint32_t, uint64_t>> table = {
+      {"cycles", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES}},
+      {"instructions", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS}},
+      {"ref-cycles", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_REF_CPU_CYCLES}},
+      {"cache-references", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES}},
+      {"cache-misses", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES}},
+      {"branch-instructions", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS}},
+      {"branch-misses", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}},
+      {"stalled-cycles-frontend", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND}},
+      {"stalled-cycles-backend", {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND}},
+      {"L1-dcache-loads",
+       {PERF_TYPE_HW_CACHE, CacheEventConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                             PERF_COUNT_HW_CACHE_RESULT_ACCESS)}},
+      {"L1-dcache-load-misses",
+       {PERF_TYPE_HW_CACHE, CacheEventConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                             PERF_COUNT_HW_CACHE_RESULT_MISS)}},
+      {"LLC-loads",
+       {PERF_TYPE_HW_CACHE, CacheEventConfig(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ,
+                                             PERF_COUNT_HW_CACHE_RESULT_ACCESS)}},
+      {"LLC-load-misses",
+       {PERF_TYPE_HW_CACHE, CacheEventConfig(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ,
+                                             PERF_COUNT_HW_CACHE_RESULT_MISS)}},
+  };
+  return table;
+}
+
+/*! \brief A single counter reading. Layout matches `PERF_FORMAT_TOTAL_TIME_ENABLED |
+ * PERF_FORMAT_TOTAL_TIME_RUNNING`. */
+struct PerfEventReading {
+  uint64_t value = 0;
+  uint64_t time_enabled = 0;
+  uint64_t time_running = 0;
+};
+
+/*! \brief Object that holds the values of counters at the start of a function call. */
+struct PerfEventStartNode : public Object {
+  /*! \brief The starting values of all opened counters. */
+  std::vector<PerfEventReading> start_values;
+
+  explicit PerfEventStartNode(std::vector<PerfEventReading> start_values)
+      : start_values(std::move(start_values)) {}
+
+  static constexpr const char* _type_key = "PerfEventStartNode";
+  TVM_DECLARE_FINAL_OBJECT_INFO(PerfEventStartNode, Object);
+};
+
+/*! \brief MetricCollectorNode for hardware counters read through `perf_event_open`.
+ *
+ * Each counter is opened on the calling process with `inherit` set, so threads
+ * created after `Init` (i.e. the TVM thread pool, which the `Profiler` resets)
+ * are counted as well. Counters are multiplexed by the kernel when there are
+ * more events than hardware counters; values are scaled by
+ * `time_enabled / time_running` to compensate.
+ */
+struct PerfEventMetricCollectorNode final : public MetricCollectorNode {
+  /*! \brief Construct a metric collector that collects a specific set of counters.
+   * \param metrics The names of the counters to collect. See `PerfEventTable`.
+   */
+  explicit PerfEventMetricCollectorNode(Array<String> metrics) {
+    for (const String& metric : metrics) {
+      metric_names.push_back(metric);
+    }
+  }
+
+  /*! \brief Initialization call. Opens one counter per metric.
+   * \param devices The devices this collector will be running on. Only CPU is supported.
+   */
+  void Init(Array<DeviceWrapper> devices) final {
+    bool has_cpu = false;
+    for (auto wrapped_device : devices) {
+      if (wrapped_device->device.device_type == kDLCPU) {
+        has_cpu = true;
+      }
+    }
+    if (!has_cpu) {
+      return;
+    }
+    if (metric_names.empty()) {
+      metric_names = default_perf_event_names;
+    }
+
+    const auto& table = PerfEventTable();
+    for (const std::string& name : metric_names) {
+      auto it = table.find(name);
+      CHECK(it != table.end()) << "PerfEventMetricCollector does not support counter \"" << name
+                               << "\"";
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = it->second.first;
+      attr.config = it->second.second;
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      attr.disabled = 1;
+      attr.inherit = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+      if (fd < 0) {
+        LOG(WARNING) << "perf_event_open failed for counter \"" << name
+                     << "\": " << std::strerror(errno)
+                     << ". Try setting `sudo sh -c 'echo 1 >/proc/sys/kernel/perf_event_paranoid'`";
+        continue;
+      }
+      fds.push_back(fd);
+      opened_names.push_back(name);
+    }
+
+    // Because we may have multiple calls in flight at the same time, we
+    // start all the counters when we initialize. Then we calculate the
+    // counts for a call by comparing counter values at the start vs end of
+    // the call.
+    for (int fd : fds) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+
+  /*! \brief Called right before a function call. Reads starting values of the counters.
+   * \param dev The device the function will be run on.
+   * \returns A `PerfEventStartNode` containing the counter values at the start of the call.
+   */
+  ObjectRef Start(Device dev) final {
+    if (dev.device_type != kDLCPU || fds.empty()) {
+      return ObjectRef(nullptr);
+    }
+    return ObjectRef(make_object<PerfEventStartNode>(ReadAll()));
+  }
+
+  /*! \brief Called right after a function call. Computes the change in each
+   * counter since the corresponding `Start` call.
+   * \param obj `PerfEventStartNode` created by a call to `Start`.
+   * \returns A mapping from metric name to value.
+   */
+  Map<String, ffi::Any> Stop(ObjectRef obj) final {
+    const PerfEventStartNode* start = obj.as<PerfEventStartNode>();
+    std::vector<PerfEventReading> end_values = ReadAll();
+    std::unordered_map<String, ffi::Any> reported_metrics;
+    int64_t cycles = -1;
+    int64_t instructions = -1;
+    for (size_t i = 0; i < end_values.size(); i++) {
+      const PerfEventReading& s = start->start_values[i];
+      const PerfEventReading& e = end_values[i];
+      int64_t count;
+      if (e.value < s.value) {
+        LOG(WARNING) << "Detected overflow when reading performance counter, setting value to -1.";
+        count = -1;
+      } else {
+        double delta = static_cast<double>(e.value - s.value);
+        uint64_t enabled = e.time_enabled - s.time_enabled;
+        uint64_t running = e.time_running - s.time_running;
+        // The counter was multiplexed with others, extrapolate to the full interval.
+        if (running > 0 && running < enabled) {
+          delta *= static_cast<double>(enabled) / static_cast<double>(running);
+        }
+        count = static_cast<int64_t>(delta);
+      }
+      if (opened_names[i] == "cycles") cycles = count;
+      if (opened_names[i] == "instructions") instructions = count;
+      reported_metrics[opened_names[i]] = ObjectRef(make_object<CountNode>(count));
+    }
+    if (cycles > 0 && instructions >= 0) {
+      reported_metrics["IPC"] = ObjectRef(
+          make_object<RatioNode>(static_cast<double>(instructions) / static_cast<double>(cycles)));
+    }
+    return reported_metrics;
+  }
+
+  ~PerfEventMetricCollectorNode() final {
+    for (int fd : fds) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      close(fd);
+    }
+  }
+
+  /*! \brief Requested counter names. */
+  std::vector<std::string> metric_names;
+  /*! \brief Names of the counters that were successfully opened. Order matches `fds`. */
+  std::vector<std::string> opened_names;
+  /*! \brief File descriptors returned by `perf_event_open`. */
+  std::vector<int> fds;
+
+  static constexpr const char* _type_key = "runtime.profiling.PerfEventMetricCollector";
+  TVM_DECLARE_FINAL_OBJECT_INFO(PerfEventMetricCollectorNode, MetricCollectorNode);
+
+ private:
+  /*! \brief Read the current value of all opened counters. */
+  std::vector<PerfEventReading> ReadAll() const {
+    std::vector<PerfEventReading> values(fds.size());
+    for (size_t i = 0; i < fds.size(); i++) {
+      ssize_t n = read(fds[i], &values[i], sizeof(PerfEventReading));
+      CHECK_EQ(n, static_cast<ssize_t>(sizeof(PerfEventReading)))
+          << "Failed to read performance counter \"" << opened_names[i]
+          << "\": " << std::strerror(errno);
+    }
+    return values;
+  }
+};
+
+/*! \brief Wrapper for `PerfEventMetricCollectorNode`. */
+class PerfEventMetricCollector : public MetricCollector {
+ public:
+  explicit PerfEventMetricCollector(Array<String> metrics) {
+    data_ = make_object<PerfEventMetricCollectorNode>(metrics);
+  }
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(PerfEventMetricCollector, MetricCollector,
+                                        PerfEventMetricCollectorNode);
+};
+
+MetricCollector CreatePerfEventMetricCollector(Array<String> metrics) {
+  return PerfEventMetricCollector(metrics);
+}
+
+TVM_FFI_STATIC_INIT_BLOCK({
+  namespace refl = tvm::ffi::reflection;
+  refl::GlobalDef().def("runtime.profiling.PerfEventMetricCollector",
+                        [](Array<String> metrics) { return PerfEventMetricCollector(metrics); });
+});
+
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
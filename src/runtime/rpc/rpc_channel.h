@@ -45,6 +45,22 @@ class RPCChannel {
    * \return The actual bytes sent.
    */
   virtual size_t Send(const void* data, size_t size) = 0;
+  /*!
+   * \brief Send a header followed by a payload in one operation if possible.
+   *
+   *  Channels that support scatter/gather IO (e.g. sockets via writev) can override
+   *  this to push the payload straight from the caller's memory without first
+   *  copying it into the write buffer. The default only sends the header.
+   *
+   * \param head The header pointer.
+   * \param head_size The size of the header, must be non-zero.
+   * \param body The payload pointer, can be nullptr.
+   * \param body_size The size of the payload.
+   * \return The actual bytes sent, counted from the start of the header.
+   */
+  virtual size_t SendV(const void* head, size_t head_size, const void* body, size_t body_size) {
+    return Send(head, head_size);
+  }
   /*!
    * \brief Recv data from channel.
    *
@@ -32,6 +32,7 @@
 #include <array>
 #include <chrono>
 #include <cmath>
+#include <exception>
 #include <memory>
 #include <string>
 #include <utility>
@@ -510,6 +511,9 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
       this->ReturnVoid();
       this->SwitchToState(kRecvPacketNumBytes);
     } else {
+      // The payload of a device tensor, or of a tensor owned by a forwarded session, is not
+      // addressable from here, so it is staged in the arena before being handed to the session.
+      // Only the sending side of a pipelined copy avoids the intermediate buffer.
       char* temp_data = this->ArenaAlloc<char>(data_bytes);
       this->ReadArray(temp_data, data_bytes);
 
@@ -916,6 +920,87 @@ void RPCEndpoint::CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes
   handler_->FinishCopyAck();
 }
 
+void RPCEndpoint::FlushWriterWithPayload(const char* payload, uint64_t nbytes) {
+  while (writer_.bytes_available() != 0) {
+    size_t head_left = writer_.bytes_available();
+    writer_.ReadWithCallback(
+        [&](const void* data, size_t size) {
+          // The payload can only be attached to the last contiguous piece of the header.
+          if (size != head_left) {
+            size_t n = channel_->Send(data, size);
+            head_left -= n;
+            return n;
+          }
+          size_t n = channel_->SendV(data, size, payload, nbytes);
+          if (n <= size) {
+            head_left -= n;
+            return n;
+          }
+          payload += n - size;
+          nbytes -= n - size;
+          head_left = 0;
+          return size;
+        },
+        head_left);
+  }
+  while (nbytes != 0) {
+    size_t n = channel_->Send(payload, nbytes);
+    payload += n;
+    nbytes -= n;
+  }
+}
+
+void RPCEndpoint::CopyToRemotePipelined(void* from_bytes, DLTensor* to, uint64_t nbytes,
+                                        uint64_t block_bytes, int window) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  RPCCode code = RPCCode::kCopyToRemote;
+  ICHECK_GT(block_bytes, 0U);
+  ICHECK_GT(window, 0);
+
+  uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*to));
+  ICHECK_LE(nbytes, tensor_total_size_bytes)
+      << "CopyToRemote: overflow in tensor size: (nbytes=" << nbytes
+      << ", tensor_total_size=" << tensor_total_size_bytes << ")";
+
+  const char* src = reinterpret_cast<const char*>(from_bytes);
+  int num_in_flight = 0;
+  // The first error raised by an acknowledgement. The acknowledgements still in flight are read
+  // before it is rethrown, so that they are not taken as the replies of the next request.
+  std::exception_ptr error = nullptr;
+  auto wait_ack = [&]() {
+    try {
+      ICHECK(HandleUntilReturnEvent(true, [](ffi::PackedArgs) {}) == RPCCode::kReturn);
+    } catch (...) {
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+    }
+    --num_in_flight;
+  };
+  for (uint64_t offset = 0; offset < nbytes && error == nullptr; offset += block_bytes) {
+    uint64_t block_nbytes = std::min(block_bytes, nbytes - offset);
+    to->byte_offset = offset;
+    uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(to, code, block_nbytes);
+    uint64_t packet_nbytes = overhead + block_nbytes;
+
+    handler_->Write(packet_nbytes);
+    handler_->Write(code);
+    RPCReference::SendDLTensor(handler_, to);
+    handler_->Write(block_nbytes);
+    FlushWriterWithPayload(src + offset, block_nbytes);
+
+    if (++num_in_flight == window) {
+      wait_ack();
+    }
+  }
+  while (num_in_flight > 0) {
+    wait_ack();
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
 // SysCallEventHandler functions
 void RPCGetGlobalFunc(RPCSession* handler, ffi::PackedArgs args, ffi::Any* rv) {
   auto name = args[0].cast<std::string>();
@@ -1089,6 +1174,12 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
     uint64_t rpc_max_size = GetRPCMaxTransferSize();
     ICHECK_GT(rpc_max_size, overhead) << "CopyToRemote: Invalid block size!";
     const uint64_t block_size = rpc_max_size - overhead;
+
+    if (copy_window_ > 1) {
+      endpoint_->CopyToRemotePipelined(local_from_bytes, remote_to, nbytes,
+                                       std::min(block_size, copy_block_bytes_), copy_window_);
+      return;
+    }
     uint64_t block_count = 0;
     const uint64_t num_blocks = nbytes / block_size;
     void* from_bytes;
@@ -1206,6 +1297,13 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
 
   bool IsLocalSession() const final { return false; }
 
+  void SetCopyPipeline(uint64_t block_bytes, int window) final {
+    ICHECK_GT(block_bytes, 0U) << "SetCopyPipeline: block size must be positive";
+    ICHECK_GT(window, 0) << "SetCopyPipeline: window must be positive";
+    copy_block_bytes_ = block_bytes;
+    copy_window_ = window;
+  }
+
   void Shutdown() final { endpoint_->Shutdown(); }
 
  private:
@@ -1232,6 +1330,10 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
 
   std::shared_ptr<RPCEndpoint> endpoint_;
   int64_t rpc_chunk_max_size_bytes_ = -1;
+  // Block size used by pipelined CopyToRemote.
+  uint64_t copy_block_bytes_ = 1 << 22;
+  // Number of CopyToRemote blocks in flight, 1 means no pipelining.
+  int copy_window_ = 1;
 };
 
 std::shared_ptr<RPCSession> CreateClientSession(std::shared_ptr<RPCEndpoint> endpoint) {
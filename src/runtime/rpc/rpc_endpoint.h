@@ -159,6 +159,22 @@ class RPCEndpoint {
    * \param type_hint Hint of content data type.
    */
   void CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes);
+  /*!
+   * \brief Copy bytes into remote array content with several blocks in flight.
+   *
+   *  Each block is sent as a regular CopyToRemote packet, so no server support is
+   *  needed: the server answers packets in order and the client only waits for an
+   *  acknowledgement once window blocks are outstanding. Block payloads are sent
+   *  directly from from_bytes without being copied into the write buffer.
+   *
+   * \param from_bytes The source host data.
+   * \param to The target array, byte_offset is updated per block.
+   * \param nbytes The size of the memory in bytes.
+   * \param block_bytes The maximum payload size of each block.
+   * \param window The maximum number of blocks in flight.
+   */
+  void CopyToRemotePipelined(void* from_bytes, DLTensor* to, uint64_t nbytes,
+                             uint64_t block_bytes, int window);
 
   /*!
    * \brief Call a remote defined system function with arguments.
@@ -186,6 +202,8 @@ class RPCEndpoint {
   // Handle events until receives a return
   // Also flushes channels so that the function advances.
   RPCCode HandleUntilReturnEvent(bool client_mode, RPCSession::FEncodeReturn setreturn);
+  // Flush the writer followed by a payload that lives outside of the writer.
+  void FlushWriterWithPayload(const char* payload, uint64_t nbytes);
   // Initalization
   void Init();
   // Internal channel.
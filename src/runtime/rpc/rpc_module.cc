@@ -485,6 +485,12 @@ TVM_FFI_STATIC_INIT_BLOCK({
                     ICHECK_EQ(tkey, "rpc");
                     *rv = static_cast<RPCModuleNode*>(m.operator->())->sess()->table_index();
                   })
+      .def("rpc.SessSetCopyPipeline",
+           [](Module mod, int64_t block_bytes, int window) {
+             ICHECK_GT(block_bytes, 0) << "block_bytes must be positive";
+             RPCModuleGetSession(mod)->SetCopyPipeline(static_cast<uint64_t>(block_bytes),
+                                                       window);
+           })
       .def("tvm.rpc.NDArrayFromRemoteOpaqueHandle",
            [](Module mod, void* remote_array, DLTensor* template_tensor, Device dev,
               void* ndarray_handle) -> NDArray {
@@ -139,6 +139,18 @@ class RPCSession {
    */
   virtual void CopyFromRemote(DLTensor* remote_from, void* local_to_bytes, uint64_t nbytes) = 0;
 
+  /*!
+   * \brief Configure pipelined bulk transfer for CopyToRemote.
+   *
+   *  When enabled, large copies are split into blocks of at most block_bytes and
+   *  up to window blocks are kept in flight before waiting for acknowledgement.
+   *  Sessions that do not go through a channel ignore this setting.
+   *
+   * \param block_bytes The maximum size of each block.
+   * \param window The maximum number of blocks in flight, 1 disables pipelining.
+   */
+  virtual void SetCopyPipeline(uint64_t block_bytes, int window) {}
+
   /*!
    * \brief Free a remote function.
    * \param handle The remote object handle.
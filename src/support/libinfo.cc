@@ -210,6 +210,10 @@
 #define TVM_INFO_USE_RANDOM "NOT-FOUND"
 #endif
 
+#ifndef TVM_INFO_USE_PERF_EVENT
+#define TVM_INFO_USE_PERF_EVENT "NOT-FOUND"
+#endif
+
 #ifndef TVM_INFO_USE_CPP_RPC
 #define TVM_INFO_USE_CPP_RPC "NOT-FOUND"
 #endif
@@ -332,6 +336,7 @@ TVM_DLL ffi::Map<ffi::String, ffi::String> GetLibInfo() {
       {"USE_OPENCL_GTEST", TVM_INFO_USE_OPENCL_GTEST},
       {"USE_OPENMP", TVM_INFO_USE_OPENMP},
       {"USE_PAPI", TVM_INFO_USE_PAPI},
+      {"USE_PERF_EVENT", TVM_INFO_USE_PERF_EVENT},
       {"USE_RANDOM", TVM_INFO_USE_RANDOM},
       {"TVM_DEBUG_WITH_ABI_CHANGE", TVM_INFO_TVM_DEBUG_WITH_ABI_CHANGE},
       {"TVM_LOG_BEFORE_THROW", TVM_INFO_TVM_LOG_BEFORE_THROW},
@@ -45,6 +45,7 @@
 #include <sys/ioctl.h>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #endif
 
@@ -469,6 +470,28 @@ class TCPSocket : public Socket, public dmlc::Stream {
     return RetryCallOnEINTR(
         [&]() { return send(sockfd, buf, static_cast<sock_size_t>(len), flag); }, GetLastErrorCode);
   }
+  /*!
+   * \brief send a header and a payload with a single gather write
+   * \param head the pointer to the header
+   * \param head_len the size of the header
+   * \param body the pointer to the payload
+   * \param body_len the size of the payload
+   * \return size of data actually sent
+   *         return -1 if error occurs
+   */
+  ssize_t SendV(const void* head, size_t head_len, const void* body, size_t body_len) {
+#ifdef _WIN32
+    return Send(head, head_len);
+#else
+    struct iovec iov[2];
+    iov[0].iov_base = const_cast<void*>(head);
+    iov[0].iov_len = head_len;
+    iov[1].iov_base = const_cast<void*>(body);
+    iov[1].iov_len = body_len;
+    int iovcnt = body_len != 0 ? 2 : 1;
+    return RetryCallOnEINTR([&]() { return writev(sockfd, iov, iovcnt); }, GetLastErrorCode);
+#endif
+  }
   /*!
    * \brief receive data using the socket
    * \param buf_ the pointer to the buffer
@@ -198,6 +198,22 @@ class FlopEstimator : private ExprFunctor<TResult(const PrimExpr& n)>,
   TResult VisitExpr_(const IntImmNode* op) override { return TResult(); }
   TResult VisitExpr_(const FloatImmNode* op) override { return TResult(); }
   TResult VisitExpr_(const CastNode* op) override { return VisitExpr(op->value); }
+  TResult VisitExpr_(const StringImmNode* op) override { return TResult(); }
+  TResult VisitExpr_(const RampNode* op) override { return TResult(); }
+  TResult VisitExpr_(const BroadcastNode* op) override { return VisitExpr(op->value); }
+  TResult VisitExpr_(const ShuffleNode* op) override {
+    TResult result;
+    for (const PrimExpr& vec : op->vectors) {
+      result += VisitExpr(vec);
+    }
+    return result;
+  }
+  TResult VisitExpr_(const LetNode* op) override {
+    TResult result = VisitExpr(op->value);
+    result += VisitExpr(op->body);
+    return result;
+  }
+  TResult VisitStmt_(const AssertStmtNode* op) override { return VisitStmt(op->body); }
   TResult VisitStmt_(const AllocateConstNode* op) override { return VisitStmt(op->body); }
   TResult VisitStmt_(const AllocateNode* op) override { return VisitStmt(op->body); }
   TResult VisitStmt_(const DeclBufferNode* op) override { return VisitStmt(op->body); }
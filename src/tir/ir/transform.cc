@@ -38,10 +38,12 @@ TVM_REGISTER_PASS_CONFIG_OPTION("tir.instrument_bound_checkers", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.disable_assert", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.disable_vectorize", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.enable_buffer_level_predication", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.vectorize_predicated_tail", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.disable_cse_tir", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.enable_debug", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.enable_equiv_terms_in_cse_tir", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.disable_storage_rewrite", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.storage_rewrite_interference_planning", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.is_entry_func", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.add_lower_pass", Array<Array<ObjectRef>>);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.debug_keep_trivial_loop", Bool);
@@ -111,6 +113,35 @@ PrimFuncPass::PrimFuncPass(std::function<PrimFunc(PrimFunc, IRModule, PassContex
 // Perform Module -> Module optimizations at the PrimFunc level.
 IRModule PrimFuncPassNode::operator()(IRModule mod, const PassContext& pass_ctx) const {
   ICHECK(mod.defined());
+
+  int num_threads = GetFunctionPassNumThreads(pass_ctx);
+  if (num_threads > 1) {
+    // Every function sees the input module, and the results are applied
+    // in the order of the function map, independent of the scheduling.
+    IRModule input_mod = mod->ShallowCopy();
+    std::vector<GlobalVar> gvars;
+    std::vector<PrimFunc> funcs;
+    for (const auto& [gvar, base_func] : input_mod->functions) {
+      if (auto opt_func = base_func.as<PrimFunc>()) {
+        gvars.push_back(gvar);
+        funcs.push_back(opt_func.value());
+      }
+    }
+    std::vector<PrimFunc> results(funcs.size());
+    RunFunctionPassTasks(pass_ctx, num_threads, static_cast<int>(funcs.size()), [&](int i) {
+      results[i] = pass_func(std::move(funcs[i]), input_mod, pass_ctx);
+    });
+    IRModuleNode* mod_ptr = mod.CopyOnWrite();
+    for (size_t i = 0; i < gvars.size(); ++i) {
+      if (results[i].defined()) {
+        mod_ptr->Update(gvars[i], results[i]);
+      } else {
+        mod_ptr->Remove(gvars[i]);
+      }
+    }
+    return mod;
+  }
+
   std::vector<GlobalVar> deleted_list;
 
   IRModuleNode* mod_ptr = mod.CopyOnWrite();
@@ -52,9 +52,8 @@ class ScheduleCopier {
   using SMap = std::unordered_map<K, V, ObjectPtrHash, ObjectPtrEqual>;
 
  public:
-  static void Copy(const ConcreteScheduleNode* self, ScheduleState* new_state,
-                   TSymbolTable* new_symbol_table) {
-    const ScheduleState& src_state = self->state_;
+  static void Copy(const ScheduleState& src_state, const TSymbolTable& src_symbol_table,
+                   ScheduleState* new_state, TSymbolTable* new_symbol_table) {
     ScheduleCopier copier(src_state);
     ObjectPtr<ScheduleStateNode> n = make_object<ScheduleStateNode>();
     n->mod = src_state->mod;
@@ -63,7 +62,8 @@ class ScheduleCopier {
     n->debug_mask = src_state->debug_mask;
     n->enable_check = src_state->enable_check;
     *new_state = ScheduleState(std::move(n));
-    *new_symbol_table = copier.Copy(self->symbol_table_);
+    *new_symbol_table = copier.Copy(src_symbol_table);
+    new_state->get()->DebugVerify();
   }
 
  private:
@@ -185,19 +185,79 @@ class ScheduleCopier {
 };
 
 void ConcreteScheduleNode::WorkOn(const String& func_name) {
-  this->func_working_on_ = this->state_->mod->GetGlobalVar(func_name);
+  this->func_working_on_ = this->GetState()->mod->GetGlobalVar(func_name);
 }
 
-void ConcreteScheduleNode::Copy(ScheduleState* new_state, TSymbolTable* new_symbol_table) const {
-  ScheduleCopier::Copy(this, new_state, new_symbol_table);
-  new_state->get()->DebugVerify();
+ConcreteScheduleNode::~ConcreteScheduleNode() {
+  if (copies_data_ == nullptr) {
+    return;
+  }
+  std::shared_ptr<SharedData> data = std::move(copies_data_);
+  std::lock_guard<std::mutex> lock(data->mutex);
+  data->source = nullptr;
+  if (data.use_count() == 1) {
+    return;
+  }
+  // Hand over the data to the pending copies, which is free unless the state is referenced
+  // elsewhere, e.g. by the users of `state()`
+  if (state_.unique()) {
+    data->state = std::move(state_);
+    data->symbol_table = std::move(symbol_table_);
+  } else {
+    ScheduleCopier::Copy(state_, symbol_table_, &data->state, &data->symbol_table);
+  }
+}
+
+void ConcreteScheduleNode::ForkDataInto(ConcreteScheduleNode* copy) const {
+  if (source_data_ != nullptr) {
+    // This schedule is a pending copy itself, and the new copy shares its source
+    copy->source_data_ = source_data_;
+    return;
+  }
+  if (!state_.unique()) {
+    // The state is referenced elsewhere, e.g. by the users of `state()`, and may be changed
+    // through those references without accessing this schedule, so the copy is taken now
+    ScheduleCopier::Copy(state_, symbol_table_, &copy->state_, &copy->symbol_table_);
+    return;
+  }
+  if (copies_data_ == nullptr) {
+    copies_data_ = std::make_shared<SharedData>();
+    copies_data_->source = this;
+  }
+  copy->source_data_ = copies_data_;
+}
+
+void ConcreteScheduleNode::PrepareDataSlow() const {
+  if (copies_data_ != nullptr) {
+    // This schedule is about to be accessed, and possibly changed, so the pending copies have to
+    // take a snapshot of the data unless all of them are gone
+    std::shared_ptr<SharedData> data = std::move(copies_data_);
+    std::lock_guard<std::mutex> lock(data->mutex);
+    data->source = nullptr;
+    if (data.use_count() > 1) {
+      ScheduleCopier::Copy(state_, symbol_table_, &data->state, &data->symbol_table);
+    }
+  } else if (source_data_ != nullptr) {
+    std::shared_ptr<SharedData> data = std::move(source_data_);
+    std::lock_guard<std::mutex> lock(data->mutex);
+    if (data->source != nullptr) {
+      const ConcreteScheduleNode* source = data->source;
+      ScheduleCopier::Copy(source->state_, source->symbol_table_, &state_, &symbol_table_);
+    } else if (data.use_count() == 1) {
+      // The last pending copy takes over the snapshot
+      state_ = std::move(data->state);
+      symbol_table_ = std::move(data->symbol_table);
+    } else {
+      ScheduleCopier::Copy(data->state, data->symbol_table, &state_, &symbol_table_);
+    }
+  }
 }
 
 Schedule ConcreteScheduleNode::Copy() {
   ObjectPtr<ConcreteScheduleNode> n = make_object<ConcreteScheduleNode>();
   n->func_working_on_ = this->func_working_on_;
   n->error_render_level_ = this->error_render_level_;
-  ConcreteScheduleNode::Copy(&n->state_, &n->symbol_table_);
+  ForkDataInto(n.get());
   n->analyzer_ = std::make_unique<arith::Analyzer>();  // new analyzer needed because it is stateful
   n->rand_state_ = ForkSeed();
   return Schedule(std::move(n));
@@ -267,8 +327,8 @@ Array<ExprRV> ConcreteScheduleNode::SamplePartitionedTile(const LoopRV& loop_rv,
 LoopRV ConcreteScheduleNode::SampleComputeLocation(const BlockRV& block_rv,
                                                    Optional<Integer> decision) {
   TVM_TIR_SCHEDULE_BEGIN();
-  return CreateRV<LoopRV>(
-      tir::SampleComputeLocation(state_, &this->rand_state_, this->GetSRef(block_rv), &decision));
+  return CreateRV<LoopRV>(tir::SampleComputeLocation(GetState(), &this->rand_state_,
+                                                     this->GetSRef(block_rv), &decision));
   TVM_TIR_SCHEDULE_END("sample-compute-location", this->error_render_level_);
   throw;
 }
@@ -312,7 +372,7 @@ BlockRV ConcreteScheduleNode::GetBlock(const String& name, const Optional<String
   };
   GlobalVar gv = NullValue<GlobalVar>();
   if (func_name.has_value()) {
-    gv = state_->mod->GetGlobalVar(func_name.value());
+    gv = GetState()->mod->GetGlobalVar(func_name.value());
   } else if (func_working_on_.has_value()) {
     gv = this->func_working_on_.value();
   } else {
@@ -320,10 +380,10 @@ BlockRV ConcreteScheduleNode::GetBlock(const String& name, const Optional<String
                   "specify the function name explicitly, or call `work_on` to specify the function "
                   "before using `get_block`.";
   }
-  Array<StmtSRef> blocks = tir::GetBlocks(this->state_, name, gv);
+  Array<StmtSRef> blocks = tir::GetBlocks(this->GetState(), name, gv);
   if (blocks.size() != 1) {
     TVM_TIR_SCHEDULE_BEGIN();
-    throw NotSingleResult(name, this->state_->mod, blocks);
+    throw NotSingleResult(name, this->GetState()->mod, blocks);
     TVM_TIR_SCHEDULE_END("get-block", this->error_render_level_);
   }
   return CreateRV<BlockRV>(blocks[0]);
@@ -336,38 +396,38 @@ Array<LoopRV> ConcreteScheduleNode::GetLoops(const BlockRV& block_rv) {
 Array<BlockRV> ConcreteScheduleNode::GetChildBlocks(const BlockRV& block_rv) {
   Array<BlockRV> result;
   TVM_TIR_SCHEDULE_BEGIN();
-  result = CreateRV<BlockRV>(tir::GetChildBlocks(state_, this->GetSRef(block_rv)));
+  result = CreateRV<BlockRV>(tir::GetChildBlocks(GetState(), this->GetSRef(block_rv)));
   TVM_TIR_SCHEDULE_END("get-child-blocks", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return result;
 }
 
 Array<BlockRV> ConcreteScheduleNode::GetChildBlocks(const LoopRV& loop_rv) {
   Array<BlockRV> result;
   TVM_TIR_SCHEDULE_BEGIN();
-  result = CreateRV<BlockRV>(tir::GetChildBlocks(state_, this->GetSRef(loop_rv)));
+  result = CreateRV<BlockRV>(tir::GetChildBlocks(GetState(), this->GetSRef(loop_rv)));
   TVM_TIR_SCHEDULE_END("get-child-blocks", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return result;
 }
 
 Array<BlockRV> ConcreteScheduleNode::GetProducers(const BlockRV& block_rv) {
   TVM_TIR_SCHEDULE_BEGIN();
-  return CreateRV<BlockRV>(tir::GetProducers(state_, this->GetSRef(block_rv)));
+  return CreateRV<BlockRV>(tir::GetProducers(GetState(), this->GetSRef(block_rv)));
   TVM_TIR_SCHEDULE_END("get-producers", this->error_render_level_);
   throw;
 }
 
 Array<BlockRV> ConcreteScheduleNode::GetConsumers(const BlockRV& block_rv) {
   TVM_TIR_SCHEDULE_BEGIN();
-  return CreateRV<BlockRV>(tir::GetConsumers(state_, this->GetSRef(block_rv)));
+  return CreateRV<BlockRV>(tir::GetConsumers(GetState(), this->GetSRef(block_rv)));
   TVM_TIR_SCHEDULE_END("get-consumers", this->error_render_level_);
   throw;
 }
 
 Array<BlockRV> ConcreteScheduleNode::GetOutputBlocks(const BlockRV& scope_block_rv) {
   TVM_TIR_SCHEDULE_BEGIN();
-  return CreateRV<BlockRV>(tir::GetOutputBlocks(state_, this->GetSRef(scope_block_rv)));
+  return CreateRV<BlockRV>(tir::GetOutputBlocks(GetState(), this->GetSRef(scope_block_rv)));
   TVM_TIR_SCHEDULE_END("get-output-blocks", this->error_render_level_);
   throw;
 }
@@ -379,9 +439,9 @@ LoopRV ConcreteScheduleNode::Merge(const Array<LoopRV>& loop_rvs) {
   Array<StmtSRef> loop_srefs = this->GetSRefs(loop_rvs);
   StmtSRef result{nullptr};
   TVM_TIR_SCHEDULE_BEGIN();
-  result = tir::Merge(state_, loop_srefs);
+  result = tir::Merge(GetState(), loop_srefs);
   TVM_TIR_SCHEDULE_END("merge", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return CreateRV<LoopRV>(result);
 }
 
@@ -390,9 +450,9 @@ LoopRV ConcreteScheduleNode::Fuse(const Array<LoopRV>& loop_rvs, bool preserve_u
   Array<StmtSRef> loop_srefs = this->GetSRefs(loop_rvs);
   StmtSRef result{nullptr};
   TVM_TIR_SCHEDULE_BEGIN();
-  result = tir::Fuse(state_, loop_srefs, preserve_unit_iters);
+  result = tir::Fuse(GetState(), loop_srefs, preserve_unit_iters);
   TVM_TIR_SCHEDULE_END("fuse", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return CreateRV<LoopRV>(result);
 }
 
@@ -483,13 +543,13 @@ Array<LoopRV> ConcreteScheduleNode::Split(const LoopRV& loop_rv,
     if (!factor_rvs[i].defined()) {
       factors.push_back(Integer(-1));
       if (infer_index != -1) {
-        throw NotSingleInferFactorError(state_->mod);
+        throw NotSingleInferFactorError(GetState()->mod);
       }
       infer_index = i;
     } else {
       PrimExpr factor = this->Get(factor_rvs[i].value());
       if (is_const_int(factor) && !is_positive_const(factor)) {
-        throw NonPositiveFactorError(state_->mod, factor.as<IntImmNode>()->value, i);
+        throw NonPositiveFactorError(GetState()->mod, factor.as<IntImmNode>()->value, i);
       }
       if (factor.dtype().bits() > loop->extent.dtype().bits()) {
         factor = cast(loop->extent.dtype(), factor);
@@ -502,11 +562,11 @@ Array<LoopRV> ConcreteScheduleNode::Split(const LoopRV& loop_rv,
     factors.Set(infer_index,
                 this->analyzer_->Simplify(floordiv(loop->extent + tot_length - 1, tot_length)));
   } else if (!this->analyzer_->CanProve(tot_length >= loop->extent)) {
-    throw WrongFactorError(state_->mod, GetRef<For>(loop), true);
+    throw WrongFactorError(GetState()->mod, GetRef<For>(loop), true);
   }
-  results = tir::Split(state_, loop_sref, factors, preserve_unit_iters, disable_predication);
+  results = tir::Split(GetState(), loop_sref, factors, preserve_unit_iters, disable_predication);
   TVM_TIR_SCHEDULE_END("split", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return CreateRV<LoopRV>(results);
 }
 
@@ -543,20 +603,20 @@ Array<LoopRV> ConcreteScheduleNode::LoopPartition(const LoopRV& loop_rv,
   Array<StmtSRef> results;
   TVM_TIR_SCHEDULE_BEGIN();
   if (!is_const_number(loop->min) || !is_const_number(loop->extent)) {
-    throw SymbolicShapeError(state_->mod, GetRef<For>(loop));
+    throw SymbolicShapeError(GetState()->mod, GetRef<For>(loop));
   }
   // infer factor if needed and check validity of factors
   for (size_t i = 0; i < factor_rvs.size(); i++) {
     if (!factor_rvs[i].defined()) {
       factors.push_back(Integer(-1));
       if (infer_index != -1) {
-        throw NotSingleInferFactorError(state_->mod);
+        throw NotSingleInferFactorError(GetState()->mod);
       }
       infer_index = i;
     } else {
       PrimExpr factor = this->Get(factor_rvs[i].value());
       if (is_const_int(factor) && !is_positive_const(factor)) {
-        throw NonPositiveFactorError(state_->mod, factor.as<IntImmNode>()->value, i);
+        throw NonPositiveFactorError(GetState()->mod, factor.as<IntImmNode>()->value, i);
       }
       if (factor.dtype().bits() > loop->extent.dtype().bits()) {
         factor = cast(loop->extent.dtype(), factor);
@@ -566,7 +626,7 @@ Array<LoopRV> ConcreteScheduleNode::LoopPartition(const LoopRV& loop_rv,
     }
   }
   if (this->analyzer_->CanProve(tot_length >= loop->extent)) {
-    throw WrongFactorError(state_->mod, GetRef<For>(loop), false);
+    throw WrongFactorError(GetState()->mod, GetRef<For>(loop), false);
   }
   if (infer_index != -1) {
     // if there is a 'None' in the factor list, 'None' becomes the difference between the extent and
@@ -579,42 +639,42 @@ Array<LoopRV> ConcreteScheduleNode::LoopPartition(const LoopRV& loop_rv,
   if (infer_index == -1) {
     factors.push_back(loop->extent);
   }
-  results = tir::LoopPartition(state_, loop_sref, factors, preserve_unit_iters);
+  results = tir::LoopPartition(GetState(), loop_sref, factors, preserve_unit_iters);
   TVM_TIR_SCHEDULE_END("loop_partition", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return CreateRV<LoopRV>(results);
 }
 
 void ConcreteScheduleNode::Reorder(const Array<LoopRV>& ordered_loop_rvs) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::Reorder(state_, GetSRefs(ordered_loop_rvs));
+  tir::Reorder(GetState(), GetSRefs(ordered_loop_rvs));
   TVM_TIR_SCHEDULE_END("reorder", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
 }
 
 void ConcreteScheduleNode::ReorderBlockIterVar(const BlockRV& block_rv,
                                                const Array<Integer> new_order) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::ReorderBlockIterVar(state_, GetSRef(block_rv), new_order);
+  tir::ReorderBlockIterVar(GetState(), GetSRef(block_rv), new_order);
   TVM_TIR_SCHEDULE_END("reorder_block_iter_var", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
 }
 
 LoopRV ConcreteScheduleNode::AddUnitLoop(const BlockRV& block_rv) {
   LoopRV result{nullptr};
   TVM_TIR_SCHEDULE_BEGIN();
-  result = CreateRV<LoopRV>(tir::AddUnitLoop(state_, GetSRef(block_rv)));
+  result = CreateRV<LoopRV>(tir::AddUnitLoop(GetState(), GetSRef(block_rv)));
   TVM_TIR_SCHEDULE_END("add-unit-loop", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return result;
 }
 
 LoopRV ConcreteScheduleNode::AddUnitLoop(const LoopRV& loop_rv) {
   LoopRV result{nullptr};
   TVM_TIR_SCHEDULE_BEGIN();
-  result = CreateRV<LoopRV>(tir::AddUnitLoop(state_, GetSRef(loop_rv)));
+  result = CreateRV<LoopRV>(tir::AddUnitLoop(GetState(), GetSRef(loop_rv)));
   TVM_TIR_SCHEDULE_END("add-unit-loop", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return result;
 }
 
@@ -622,15 +682,15 @@ LoopRV ConcreteScheduleNode::AddUnitLoop(const LoopRV& loop_rv) {
 
 void ConcreteScheduleNode::Parallel(const LoopRV& loop_rv) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::Parallel(state_, this->GetSRef(loop_rv));
-  this->state_->DebugVerify();
+  tir::Parallel(GetState(), this->GetSRef(loop_rv));
+  this->GetState()->DebugVerify();
   TVM_TIR_SCHEDULE_END("parallel", this->error_render_level_);
 }
 
 void ConcreteScheduleNode::Vectorize(const LoopRV& loop_rv) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::Vectorize(state_, this->GetSRef(loop_rv));
-  this->state_->DebugVerify();
+  tir::Vectorize(GetState(), this->GetSRef(loop_rv));
+  this->GetState()->DebugVerify();
   TVM_TIR_SCHEDULE_END("vectorize", this->error_render_level_);
 }
 
@@ -640,15 +700,15 @@ void ConcreteScheduleNode::Bind(const LoopRV& loop_rv, const String& thread_axis
                     "`vthread.x`, `vthread.y` and `vthread.z` instead";
   }
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::Bind(state_, this->GetSRef(loop_rv), thread_axis);
-  this->state_->DebugVerify();
+  tir::Bind(GetState(), this->GetSRef(loop_rv), thread_axis);
+  this->GetState()->DebugVerify();
   TVM_TIR_SCHEDULE_END("bind", this->error_render_level_);
 }
 
 void ConcreteScheduleNode::Unroll(const LoopRV& loop_rv) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::Unroll(state_, this->GetSRef(loop_rv));
-  this->state_->DebugVerify();
+  tir::Unroll(GetState(), this->GetSRef(loop_rv));
+  this->GetState()->DebugVerify();
   TVM_TIR_SCHEDULE_END("unroll", this->error_render_level_);
 }
 
@@ -664,10 +724,10 @@ BlockRV ConcreteScheduleNode::CacheRead(const BlockRV& block_rv, int read_buffer
     consumer_block_refs.push_back(this->GetSRef(block));
   }
   TVM_TIR_SCHEDULE_BEGIN();
-  result = tir::CacheRead(state_, this->GetSRef(block_rv), read_buffer_index, storage_scope,
+  result = tir::CacheRead(GetState(), this->GetSRef(block_rv), read_buffer_index, storage_scope,
                           consumer_block_refs);
   TVM_TIR_SCHEDULE_END("cache-read", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return CreateRV<BlockRV>(result);
 }
 
@@ -681,10 +741,10 @@ BlockRV ConcreteScheduleNode::CacheWrite(const BlockRV& block_rv, int write_buff
     consumer_block_refs.push_back(this->GetSRef(block));
   }
   TVM_TIR_SCHEDULE_BEGIN();
-  result = tir::CacheWrite(state_, this->GetSRef(block_rv), write_buffer_index, storage_scope,
+  result = tir::CacheWrite(GetState(), this->GetSRef(block_rv), write_buffer_index, storage_scope,
                            consumer_block_refs);
   TVM_TIR_SCHEDULE_END("cache-write", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return CreateRV<BlockRV>(result);
 }
 
@@ -693,10 +753,10 @@ BlockRV ConcreteScheduleNode::ReindexCacheRead(const BlockRV& block_rv, int read
                                                const IndexMap& index_map) {
   StmtSRef result{nullptr};
   TVM_TIR_SCHEDULE_BEGIN();
-  result = tir::ReindexCacheRead(state_, this->GetSRef(block_rv), read_buffer_index, storage_scope,
-                                 index_map);
+  result = tir::ReindexCacheRead(GetState(), this->GetSRef(block_rv), read_buffer_index,
+                                 storage_scope, index_map);
   TVM_TIR_SCHEDULE_END("reverse-cache-read", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return CreateRV<BlockRV>(result);
 }
 
@@ -705,10 +765,10 @@ BlockRV ConcreteScheduleNode::ReindexCacheWrite(const BlockRV& block_rv, int wri
                                                 const IndexMap& index_map) {
   StmtSRef result{nullptr};
   TVM_TIR_SCHEDULE_BEGIN();
-  result = tir::ReindexCacheWrite(state_, this->GetSRef(block_rv), write_buffer_index,
+  result = tir::ReindexCacheWrite(GetState(), this->GetSRef(block_rv), write_buffer_index,
                                   storage_scope, index_map);
   TVM_TIR_SCHEDULE_END("reverse-cache-write", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return CreateRV<BlockRV>(result);
 }
 
@@ -716,9 +776,10 @@ Array<BlockRV> ConcreteScheduleNode::CacheInplace(const BlockRV& block_rv, int w
                                                   const String& storage_scope) {
   Array<StmtSRef> results;
   TVM_TIR_SCHEDULE_BEGIN();
-  results = tir::CacheInplace(state_, this->GetSRef(block_rv), write_buffer_index, storage_scope);
+  results =
+      tir::CacheInplace(GetState(), this->GetSRef(block_rv), write_buffer_index, storage_scope);
   TVM_TIR_SCHEDULE_END("cache-buffer", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   Array<BlockRV> return_blocks;
   return_blocks.push_back(CreateRV<BlockRV>(results[0]));
   return_blocks.push_back(CreateRV<BlockRV>(results[1]));
@@ -729,9 +790,9 @@ Array<BlockRV> ConcreteScheduleNode::CacheIndex(const BlockRV& block_rv,
                                                 const String& storage_scope, int cse_thresh) {
   Array<StmtSRef> result;
   TVM_TIR_SCHEDULE_BEGIN();
-  result = tir::CacheIndex(state_, this->GetSRef(block_rv), storage_scope, cse_thresh);
+  result = tir::CacheIndex(GetState(), this->GetSRef(block_rv), storage_scope, cse_thresh);
   TVM_TIR_SCHEDULE_END("cache-index", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   Array<BlockRV> return_blocks;
   for (const StmtSRef& blockrv : result) {
     return_blocks.push_back(CreateRV<BlockRV>(blockrv));
@@ -743,9 +804,9 @@ BlockRV ConcreteScheduleNode::ReIndex(const BlockRV& block_rv, int buffer_index,
                                       BufferIndexType buffer_index_type) {
   StmtSRef result{nullptr};
   TVM_TIR_SCHEDULE_BEGIN();
-  result = tir::ReIndex(state_, this->GetSRef(block_rv), buffer_index, buffer_index_type);
+  result = tir::ReIndex(GetState(), this->GetSRef(block_rv), buffer_index, buffer_index_type);
   TVM_TIR_SCHEDULE_END("reindex", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return CreateRV<BlockRV>(result);
 }
 
@@ -755,10 +816,10 @@ BlockRV ConcreteScheduleNode::ReadAt(const LoopRV& loop_rv, const BlockRV& block
                                      int read_buffer_index, const String& storage_scope) {
   StmtSRef result{nullptr};
   TVM_TIR_SCHEDULE_BEGIN();
-  result = tir::ReadAt(state_, this->GetSRef(loop_rv), this->GetSRef(block_rv), read_buffer_index,
-                       storage_scope);
+  result = tir::ReadAt(GetState(), this->GetSRef(loop_rv), this->GetSRef(block_rv),
+                       read_buffer_index, storage_scope);
   TVM_TIR_SCHEDULE_END("read-at", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return CreateRV<BlockRV>(result);
 }
 
@@ -766,10 +827,10 @@ BlockRV ConcreteScheduleNode::WriteAt(const LoopRV& loop_rv, const BlockRV& bloc
                                       int write_buffer_index, const String& storage_scope) {
   StmtSRef result{nullptr};
   TVM_TIR_SCHEDULE_BEGIN();
-  result = tir::WriteAt(state_, this->GetSRef(loop_rv), this->GetSRef(block_rv), write_buffer_index,
-                        storage_scope);
+  result = tir::WriteAt(GetState(), this->GetSRef(loop_rv), this->GetSRef(block_rv),
+                        write_buffer_index, storage_scope);
   TVM_TIR_SCHEDULE_END("write-at", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return CreateRV<BlockRV>(result);
 }
 
@@ -784,14 +845,14 @@ void ConcreteScheduleNode::ComputeAt(const BlockRV& block_rv, const LoopRV& loop
     // do nothing
   } else if (loop_sref.same_as(inline_mark)) {
     TVM_TIR_SCHEDULE_BEGIN();
-    tir::ComputeInline(state_, this->GetSRef(block_rv));
+    tir::ComputeInline(GetState(), this->GetSRef(block_rv));
     TVM_TIR_SCHEDULE_END("compute-at", this->error_render_level_);
   } else {
     TVM_TIR_SCHEDULE_BEGIN();
-    tir::ComputeAt(state_, this->GetSRef(block_rv), loop_sref, preserve_unit_loops, index);
+    tir::ComputeAt(GetState(), this->GetSRef(block_rv), loop_sref, preserve_unit_loops, index);
     TVM_TIR_SCHEDULE_END("compute-at", this->error_render_level_);
   }
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
 }
 
 void ConcreteScheduleNode::ReverseComputeAt(const BlockRV& block_rv, const LoopRV& loop_rv,
@@ -803,28 +864,29 @@ void ConcreteScheduleNode::ReverseComputeAt(const BlockRV& block_rv, const LoopR
     // do nothing
   } else if (loop_sref.same_as(inline_mark)) {
     TVM_TIR_SCHEDULE_BEGIN();
-    tir::ReverseComputeInline(state_, this->GetSRef(block_rv));
+    tir::ReverseComputeInline(GetState(), this->GetSRef(block_rv));
     TVM_TIR_SCHEDULE_END("reverse-compute-at", this->error_render_level_);
   } else {
     TVM_TIR_SCHEDULE_BEGIN();
-    tir::ReverseComputeAt(state_, this->GetSRef(block_rv), loop_sref, preserve_unit_loops, index);
+    tir::ReverseComputeAt(GetState(), this->GetSRef(block_rv), loop_sref, preserve_unit_loops,
+                          index);
     TVM_TIR_SCHEDULE_END("reverse-compute-at", this->error_render_level_);
   }
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
 }
 
 void ConcreteScheduleNode::ComputeInline(const BlockRV& block_rv) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::ComputeInline(state_, this->GetSRef(block_rv));
+  tir::ComputeInline(GetState(), this->GetSRef(block_rv));
   TVM_TIR_SCHEDULE_END("compute-inline", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
 }
 
 void ConcreteScheduleNode::ReverseComputeInline(const BlockRV& block_rv) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::ReverseComputeInline(state_, this->GetSRef(block_rv));
+  tir::ReverseComputeInline(GetState(), this->GetSRef(block_rv));
   TVM_TIR_SCHEDULE_END("reverse-compute-inline", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
 }
 
 /******** Schedule: Block Annotation ********/
@@ -832,25 +894,25 @@ void ConcreteScheduleNode::ReverseComputeInline(const BlockRV& block_rv) {
 void ConcreteScheduleNode::StorageAlign(const BlockRV& block_rv, int buffer_index, int axis,
                                         int factor, int offset) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::StorageAlign(state_, this->GetSRef(block_rv), buffer_index, axis, factor, offset);
+  tir::StorageAlign(GetState(), this->GetSRef(block_rv), buffer_index, axis, factor, offset);
   TVM_TIR_SCHEDULE_END("storage-align", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
 }
 
 void ConcreteScheduleNode::SetScope(const BlockRV& block_rv, int buffer_index,
                                     const String& storage_scope) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::SetScope(state_, this->GetSRef(block_rv), buffer_index, storage_scope);
+  tir::SetScope(GetState(), this->GetSRef(block_rv), buffer_index, storage_scope);
   TVM_TIR_SCHEDULE_END("set-scope", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
 }
 
 void ConcreteScheduleNode::UnsafeSetDType(const BlockRV& block_rv, int buffer_index,
                                           const String& dtype) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::UnsafeSetDType(state_, this->GetSRef(block_rv), buffer_index, dtype);
+  tir::UnsafeSetDType(GetState(), this->GetSRef(block_rv), buffer_index, dtype);
   TVM_TIR_SCHEDULE_END("set-dtype", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
 }
 
 /******** Schedule: Reduction ********/
@@ -858,18 +920,18 @@ void ConcreteScheduleNode::UnsafeSetDType(const BlockRV& block_rv, int buffer_in
 BlockRV ConcreteScheduleNode::DecomposeReduction(const BlockRV& block_rv, const LoopRV& loop_rv) {
   StmtSRef result{nullptr};
   TVM_TIR_SCHEDULE_BEGIN();
-  result = tir::DecomposeReduction(state_, this->GetSRef(block_rv), this->GetSRef(loop_rv));
+  result = tir::DecomposeReduction(GetState(), this->GetSRef(block_rv), this->GetSRef(loop_rv));
   TVM_TIR_SCHEDULE_END("decompose-reduction", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return CreateRV<BlockRV>(result);
 }
 
 BlockRV ConcreteScheduleNode::RFactor(const LoopRV& loop_rv, int factor_axis) {
   StmtSRef result{nullptr};
   TVM_TIR_SCHEDULE_BEGIN();
-  result = tir::RFactor(state_, this->GetSRef(loop_rv), factor_axis);
+  result = tir::RFactor(GetState(), this->GetSRef(loop_rv), factor_axis);
   TVM_TIR_SCHEDULE_END("rfactor", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return CreateRV<BlockRV>(result);
 }
 
@@ -877,8 +939,8 @@ BlockRV ConcreteScheduleNode::RFactor(const LoopRV& loop_rv, int factor_axis) {
 BlockRV ConcreteScheduleNode::Blockize(const LoopRV& loop_rv, bool preserve_unit_iters) {
   StmtSRef result{nullptr};
   TVM_TIR_SCHEDULE_BEGIN();
-  result = tir::Blockize(state_, this->GetSRef(loop_rv), preserve_unit_iters);
-  this->state_->DebugVerify();
+  result = tir::Blockize(GetState(), this->GetSRef(loop_rv), preserve_unit_iters);
+  this->GetState()->DebugVerify();
   TVM_TIR_SCHEDULE_END("blockize", this->error_render_level_);
   return CreateRV<BlockRV>(result);
 }
@@ -886,8 +948,8 @@ BlockRV ConcreteScheduleNode::Blockize(const LoopRV& loop_rv, bool preserve_unit
 BlockRV ConcreteScheduleNode::Blockize(const Array<BlockRV>& blocks, bool preserve_unit_iters) {
   StmtSRef result{nullptr};
   TVM_TIR_SCHEDULE_BEGIN();
-  result = tir::Blockize(state_, this->GetSRefs(blocks), preserve_unit_iters);
-  this->state_->DebugVerify();
+  result = tir::Blockize(GetState(), this->GetSRefs(blocks), preserve_unit_iters);
+  this->GetState()->DebugVerify();
   TVM_TIR_SCHEDULE_END("blockize", this->error_render_level_);
   return CreateRV<BlockRV>(result);
 }
@@ -895,18 +957,18 @@ BlockRV ConcreteScheduleNode::Blockize(const Array<BlockRV>& blocks, bool preser
 void ConcreteScheduleNode::Tensorize(const LoopRV& loop_rv, const String& intrin,
                                      bool preserve_unit_iters) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::Tensorize(state_, this->GetSRef(loop_rv), tir::TensorIntrin::Get(intrin).value(),
+  tir::Tensorize(GetState(), this->GetSRef(loop_rv), tir::TensorIntrin::Get(intrin).value(),
                  preserve_unit_iters);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   TVM_TIR_SCHEDULE_END("tensorize", this->error_render_level_);
 }
 
 void ConcreteScheduleNode::Tensorize(const BlockRV& block_rv, const String& intrin,
                                      bool preserve_unit_iters) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::Tensorize(state_, this->GetSRef(block_rv), tir::TensorIntrin::Get(intrin).value(),
+  tir::Tensorize(GetState(), this->GetSRef(block_rv), tir::TensorIntrin::Get(intrin).value(),
                  preserve_unit_iters);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   TVM_TIR_SCHEDULE_END("tensorize", this->error_render_level_);
 }
 
@@ -972,31 +1034,32 @@ Any ConcreteScheduleNode::CheckAndGetAnnotationValue(const ffi::Any& ann_val) {
 void ConcreteScheduleNode::Annotate(const LoopRV& loop_rv, const String& ann_key,
                                     const Any& ann_val) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::Annotate(state_, this->GetSRef(loop_rv), ann_key, this->CheckAndGetAnnotationValue(ann_val));
-  this->state_->DebugVerify();
+  tir::Annotate(GetState(), this->GetSRef(loop_rv), ann_key,
+                this->CheckAndGetAnnotationValue(ann_val));
+  this->GetState()->DebugVerify();
   TVM_TIR_SCHEDULE_END("annotate", this->error_render_level_);
 }
 
 void ConcreteScheduleNode::Unannotate(const LoopRV& loop_rv, const String& ann_key) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::Unannotate(state_, this->GetSRef(loop_rv), ann_key);
-  this->state_->DebugVerify();
+  tir::Unannotate(GetState(), this->GetSRef(loop_rv), ann_key);
+  this->GetState()->DebugVerify();
   TVM_TIR_SCHEDULE_END("unannotate", this->error_render_level_);
 }
 
 void ConcreteScheduleNode::Annotate(const BlockRV& block_rv, const String& ann_key,
                                     const Any& ann_val) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::Annotate(state_, this->GetSRef(block_rv), ann_key,
+  tir::Annotate(GetState(), this->GetSRef(block_rv), ann_key,
                 this->CheckAndGetAnnotationValue(ann_val));
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   TVM_TIR_SCHEDULE_END("annotate", this->error_render_level_);
 }
 
 void ConcreteScheduleNode::Unannotate(const BlockRV& block_rv, const String& ann_key) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::Unannotate(state_, this->GetSRef(block_rv), ann_key);
-  this->state_->DebugVerify();
+  tir::Unannotate(GetState(), this->GetSRef(block_rv), ann_key);
+  this->GetState()->DebugVerify();
   TVM_TIR_SCHEDULE_END("unannotate", this->error_render_level_);
 }
 
@@ -1008,24 +1071,24 @@ void ConcreteScheduleNode::TransformLayout(const BlockRV& block_rv, int buffer_i
                                            bool assume_injective_transform) {
   TVM_TIR_SCHEDULE_BEGIN();
   auto f_subst = [&](const Var& var) -> Optional<PrimExpr> {
-    if (auto opt_expr = symbol_table_.Get(var)) {
+    if (auto opt_expr = GetSymbolTable().Get(var)) {
       return Downcast<PrimExpr>(opt_expr.value());
     } else {
       return std::nullopt;
     }
   };
   auto new_index_map = Substitute(index_map, f_subst);
-  tir::TransformLayout(state_, this->GetSRef(block_rv), buffer_index, buffer_index_type,
+  tir::TransformLayout(GetState(), this->GetSRef(block_rv), buffer_index, buffer_index_type,
                        new_index_map, pad_value, assume_injective_transform);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   TVM_TIR_SCHEDULE_END("transform_layout", this->error_render_level_);
 }
 
 void ConcreteScheduleNode::TransformBlockLayout(const BlockRV& block_rv,
                                                 const IndexMap& index_map) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::TransformBlockLayout(state_, this->GetSRef(block_rv), index_map);
-  this->state_->DebugVerify();
+  tir::TransformBlockLayout(GetState(), this->GetSRef(block_rv), index_map);
+  this->GetState()->DebugVerify();
   TVM_TIR_SCHEDULE_END("transform_block_layout", this->error_render_level_);
 }
 
@@ -1033,10 +1096,10 @@ void ConcreteScheduleNode::SetAxisSeparator(const BlockRV& block_rv, int buffer_
                                             BufferIndexType buffer_index_type,
                                             const Array<IntImm>& axis_separators) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::SetAxisSeparator(state_, this->GetSRef(block_rv), buffer_index, buffer_index_type,
+  tir::SetAxisSeparator(GetState(), this->GetSRef(block_rv), buffer_index, buffer_index_type,
                         axis_separators);
   TVM_TIR_SCHEDULE_END("set-axis-separator", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
 }
 
 /******** Schedule: Padding ********/
@@ -1044,26 +1107,26 @@ void ConcreteScheduleNode::SetAxisSeparator(const BlockRV& block_rv, int buffer_
 BlockRV ConcreteScheduleNode::DecomposePadding(const BlockRV& block_rv, const LoopRV& loop_rv) {
   StmtSRef result{nullptr};
   TVM_TIR_SCHEDULE_BEGIN();
-  result = tir::DecomposePadding(state_, this->GetSRef(block_rv), this->GetSRef(loop_rv));
+  result = tir::DecomposePadding(GetState(), this->GetSRef(block_rv), this->GetSRef(loop_rv));
   TVM_TIR_SCHEDULE_END("decompose-padding", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
   return CreateRV<BlockRV>(result);
 }
 
 void ConcreteScheduleNode::PadEinsum(const BlockRV& block_rv, const Array<Integer>& padding) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::PadEinsum(state_, this->GetSRef(block_rv), padding);
+  tir::PadEinsum(GetState(), this->GetSRef(block_rv), padding);
   TVM_TIR_SCHEDULE_END("pad-einsum", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
 }
 
 /******** Schedule: Buffer Transformation ********/
 
 void ConcreteScheduleNode::RollingBuffer(const BlockRV& block_rv, int write_buffer_index) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::RollingBuffer(state_, this->GetSRef(block_rv), write_buffer_index);
+  tir::RollingBuffer(GetState(), this->GetSRef(block_rv), write_buffer_index);
   TVM_TIR_SCHEDULE_END("rolling-buffer", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
 }
 
 /******** Schedule: Misc ********/
@@ -1071,19 +1134,19 @@ void ConcreteScheduleNode::RollingBuffer(const BlockRV& block_rv, int write_buff
 void ConcreteScheduleNode::UnsafeHideBufferAccess(const BlockRV& block_rv, const String& buf_type,
                                                   const Array<IntImm>& buf_index_array) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::UnsafeHideBufferAccess(state_, this->GetSRef(block_rv), buf_type, buf_index_array);
+  tir::UnsafeHideBufferAccess(GetState(), this->GetSRef(block_rv), buf_type, buf_index_array);
   TVM_TIR_SCHEDULE_END("hide-buffer-access", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
 }
 
 void ConcreteScheduleNode::AnnotateBufferAccess(const BlockRV& block_rv, int buffer_index,
                                                 BufferIndexType buffer_index_type,
                                                 const IndexMap& index_map) {
   TVM_TIR_SCHEDULE_BEGIN();
-  tir::AnnotateBufferAccess(state_, this->GetSRef(block_rv), buffer_index, buffer_index_type,
+  tir::AnnotateBufferAccess(GetState(), this->GetSRef(block_rv), buffer_index, buffer_index_type,
                             index_map);
   TVM_TIR_SCHEDULE_END("annotate-buffer-access", this->error_render_level_);
-  this->state_->DebugVerify();
+  this->GetState()->DebugVerify();
 }
 
 }  // namespace tir
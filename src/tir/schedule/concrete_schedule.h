@@ -20,6 +20,7 @@
 #define TVM_TIR_SCHEDULE_CONCRETE_SCHEDULE_H_
 
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -36,14 +37,41 @@ class ConcreteScheduleNode : public ScheduleNode {
   using TSymbolTable = Map<ObjectRef, ObjectRef>;
 
  protected:
-  /*! \brief The internal state of scheduling */
-  ScheduleState state_;
+  /*!
+   * \brief The data shared between a schedule and the copies forked from it, which are not
+   * materialized yet. The copies are materialized from `source` if it is still alive and
+   * unchanged, or otherwise from the snapshot of `state` and `symbol_table`.
+   */
+  struct SharedData {
+    /*! \brief The mutex guarding the fields below, as well as the data of `source` */
+    std::mutex mutex;
+    /*! \brief The schedule that the copies are forked from, or nullptr if it has detached */
+    const ConcreteScheduleNode* source = nullptr;
+    /*! \brief The snapshot of the state of `source` when it detached */
+    ScheduleState state;
+    /*! \brief The snapshot of the symbol table of `source` when it detached */
+    TSymbolTable symbol_table;
+  };
+
+  /*!
+   * \brief The internal state of scheduling.
+   * \note It is lazily materialized for copies, and should be accessed via `GetState()`. A copy
+   * forked while the state is referenced outside the schedule is materialized eagerly.
+   */
+  mutable ScheduleState state_;
   /*! \brief The function to be worked on. */
   Optional<GlobalVar> func_working_on_;
   /*! \brief The level of error rendering */
   ScheduleErrorRenderLevel error_render_level_;
-  /*! \brief A symbol table that maps random variables to concrete StmtSRef/Integers */
-  TSymbolTable symbol_table_;
+  /*!
+   * \brief A symbol table that maps random variables to concrete StmtSRef/Integers.
+   * \note It is lazily materialized for copies, and should be accessed via `GetSymbolTable()`.
+   */
+  mutable TSymbolTable symbol_table_;
+  /*! \brief The data shared with the pending copies forked from this schedule */
+  mutable std::shared_ptr<SharedData> copies_data_;
+  /*! \brief The data to materialize this schedule from, if it is a pending copy */
+  mutable std::shared_ptr<SharedData> source_data_;
   /*! \brief A persistent stateless arithmetic analyzer. */
   std::unique_ptr<arith::Analyzer> analyzer_;
   /*! \brief The value of random state for sampling. */
@@ -54,10 +82,10 @@ class ConcreteScheduleNode : public ScheduleNode {
     // No fields to register as they are not visited
   }
 
-  virtual ~ConcreteScheduleNode() = default;
+  virtual ~ConcreteScheduleNode();
 
  public:
-  ScheduleState state() const final { return state_; }
+  ScheduleState state() const final { return GetState(); }
   Optional<Trace> trace() const override { return std::nullopt; }
   Optional<GlobalVar> func_working_on() const final { return func_working_on_; }
   void WorkOn(const String& func_name) final;
@@ -183,11 +211,30 @@ class ConcreteScheduleNode : public ScheduleNode {
  protected:
   /******** Utility functions ********/
   /*!
-   * \brief Copy the schedule state, as well as the symbol table
-   * \param new_state The ScheduleState copied
-   * \param new_symbol_table The symbol table copied
+   * \brief Fork the schedule state, as well as the symbol table, into a copy in O(1). The copy
+   * shares the data with this schedule until either of them accesses the data for the first time,
+   * when the data is deep copied only if both of them are still alive.
+   * \param copy The copy whose state and symbol table are to be set
    */
-  void Copy(ScheduleState* new_state, TSymbolTable* new_symbol_table) const;
+  void ForkDataInto(ConcreteScheduleNode* copy) const;
+  /*! \brief The schedule state, which is materialized first if the schedule is a pending copy */
+  ScheduleState& GetState() const {
+    PrepareData();
+    return state_;
+  }
+  /*! \brief The symbol table, which is materialized first if the schedule is a pending copy */
+  TSymbolTable& GetSymbolTable() const {
+    PrepareData();
+    return symbol_table_;
+  }
+  /*! \brief Make the state and the symbol table exclusively owned by this schedule */
+  void PrepareData() const {
+    if (copies_data_ != nullptr || source_data_ != nullptr) {
+      PrepareDataSlow();
+    }
+  }
+  /*! \brief The slow path of `PrepareData`, which detaches from the shared data */
+  void PrepareDataSlow() const;
   /*!
    * \brief Add srefs as random variables into the symbol table
    * \tparam T The type of the random variables
@@ -248,8 +295,8 @@ inline For ConcreteScheduleNode::Get(const LoopRV& loop_rv) const {
 
 inline PrimExpr ConcreteScheduleNode::Get(const ExprRV& expr_rv) const {
   PrimExpr transformed = Substitute(expr_rv, [this](const Var& var) -> Optional<PrimExpr> {
-    auto it = this->symbol_table_.find(var);
-    if (it == this->symbol_table_.end()) {
+    auto it = this->GetSymbolTable().find(var);
+    if (it == this->GetSymbolTable().end()) {
       LOG(FATAL) << "IndexError: Cannot find corresponding ExprRV: " << var;
     }
     const ObjectRef& obj = (*it).second;
@@ -260,8 +307,8 @@ inline PrimExpr ConcreteScheduleNode::Get(const ExprRV& expr_rv) const {
 }
 
 inline bool ConcreteScheduleNode::HasBlock(const BlockRV& block_rv) const {
-  auto it = this->symbol_table_.find(block_rv);
-  if (it == this->symbol_table_.end()) {
+  auto it = this->GetSymbolTable().find(block_rv);
+  if (it == this->GetSymbolTable().end()) {
     return false;
   }
   const ObjectRef& obj = (*it).second;
@@ -273,8 +320,8 @@ inline bool ConcreteScheduleNode::HasBlock(const BlockRV& block_rv) const {
 }
 
 inline StmtSRef ConcreteScheduleNode::GetSRef(const BlockRV& block_rv) const {
-  auto it = this->symbol_table_.find(block_rv);
-  if (it == this->symbol_table_.end()) {
+  auto it = this->GetSymbolTable().find(block_rv);
+  if (it == this->GetSymbolTable().end()) {
     LOG(FATAL) << "IndexError: Cannot find corresponding BlockRV: " << block_rv;
   }
   const ObjectRef& obj = (*it).second;
@@ -292,8 +339,8 @@ inline StmtSRef ConcreteScheduleNode::GetSRef(const BlockRV& block_rv) const {
 inline StmtSRef ConcreteScheduleNode::GetSRef(const LoopRV& loop_rv) const {
   static StmtSRef inline_mark = StmtSRef::InlineMark();
   static StmtSRef root_mark = StmtSRef::RootMark();
-  auto it = this->symbol_table_.find(loop_rv);
-  if (it == this->symbol_table_.end()) {
+  auto it = this->GetSymbolTable().find(loop_rv);
+  if (it == this->GetSymbolTable().end()) {
     LOG(FATAL) << "IndexError: Cannot find corresponding LoopRV: " << loop_rv;
   }
   const ObjectRef& obj = (*it).second;
@@ -340,7 +387,7 @@ inline Array<T> ConcreteScheduleNode::CreateRV(const Array<StmtSRef>& srefs) {
   result.reserve(srefs.size());
   for (const StmtSRef& sref : srefs) {
     T rv;
-    this->symbol_table_.Set(rv, sref);
+    this->GetSymbolTable().Set(rv, sref);
     result.push_back(rv);
   }
   return result;
@@ -349,13 +396,13 @@ inline Array<T> ConcreteScheduleNode::CreateRV(const Array<StmtSRef>& srefs) {
 template <class T>
 inline T ConcreteScheduleNode::CreateRV(const StmtSRef& sref) {
   T rv;
-  this->symbol_table_.Set(rv, sref);
+  this->GetSymbolTable().Set(rv, sref);
   return rv;
 }
 
 inline ExprRV ConcreteScheduleNode::CreateRV(int64_t value) {
-  Var rv("v" + std::to_string(this->symbol_table_.size() + 1), DataType::Int(32));
-  this->symbol_table_.Set(rv, Integer(static_cast<int32_t>(value)));
+  Var rv("v" + std::to_string(this->GetSymbolTable().size() + 1), DataType::Int(32));
+  this->GetSymbolTable().Set(rv, Integer(static_cast<int32_t>(value)));
   return rv;
 }
 
@@ -374,9 +421,9 @@ inline Array<ExprRV> ConcreteScheduleNode::CreateRV(const std::vector<int64_t>&
 }
 
 inline void ConcreteScheduleNode::RemoveFromSymbolTable(const ObjectRef& obj) {
-  auto it = this->symbol_table_.find(obj);
-  if (it != this->symbol_table_.end()) {
-    this->symbol_table_.erase(obj);
+  auto it = this->GetSymbolTable().find(obj);
+  if (it != this->GetSymbolTable().end()) {
+    this->GetSymbolTable().erase(obj);
   } else {
     LOG(FATAL) << "IndexError: Cannot find the object in the symbol table: " << obj;
     throw;
@@ -17,6 +17,7 @@
  * under the License.
  */
 
+#include <algorithm>
 #include <random>
 
 #include "../utils.h"
@@ -314,8 +315,16 @@ std::vector<int64_t> SamplePerfectTile(
   const int64_t* extent = GetLoopIntExtent(loop);
   std::vector<int64_t> result;
   if (extent == nullptr) {
-    // Case 1. Handle loops with non-constant length
+    // Case 1. Handle loops with non-constant length. The inner tiles of a previous decision, e.g.
+    // the one tuned for a static shape, are kept, and the outermost tile is inferred. A decision
+    // with a non-positive inner tile is ignored.
     result = std::vector<int64_t>(n_splits, 1);
+    if (decision->defined() && static_cast<int>(decision->value().size()) == n_splits) {
+      std::vector<int64_t> prev = support::AsVector<Integer, int64_t>(decision->value());
+      if (std::all_of(prev.begin() + 1, prev.end(), [](int64_t l) { return l >= 1; })) {
+        result = std::move(prev);
+      }
+    }
     result[0] = -1;
   } else if (decision->defined()) {
     // Case 2. Use previous decision
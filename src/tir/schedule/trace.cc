@@ -318,6 +318,33 @@ void TraceNode::ApplyToSchedule(
   }
 }
 
+void TraceNode::ApplyRangeToSchedule(Schedule sch, int begin, int end) const {
+  Optional<Trace> applied = sch->trace();
+  ICHECK(applied.defined()) << "ValueError: The schedule is not traced";
+  ICHECK(0 <= begin && begin <= end && end <= static_cast<int>(this->insts.size()))
+      << "IndexError: Invalid instruction range [" << begin << ", " << end << ") of a trace with "
+      << this->insts.size() << " instructions";
+  ICHECK_GE(applied.value()->insts.size(), begin)
+      << "ValueError: Only " << applied.value()->insts.size()
+      << " instructions have been applied to the schedule, but the range begins at " << begin;
+  std::unordered_map<const Object*, const Object*> rv_map;
+  for (int i = 0; i < begin; ++i) {
+    const Instruction& inst = this->insts[i];
+    const Instruction& applied_inst = applied.value()->insts[i];
+    ICHECK(inst->kind.same_as(applied_inst->kind))
+        << "ValueError: The instruction " << i << " of the schedule's trace is "
+        << applied_inst->kind->name << ", but expects " << inst->kind->name;
+    TranslateAddOutputRVs(inst->outputs, applied_inst->outputs, &rv_map);
+  }
+  for (int i = begin; i < end; ++i) {
+    const Instruction& inst = this->insts[i];
+    Array<Any> inputs = TranslateInputRVs(inst->inputs, rv_map);
+    Array<Any> outputs =
+        inst->kind->f_apply_to_schedule(sch, inputs, inst->attrs, this->GetDecision(inst));
+    TranslateAddOutputRVs(inst->outputs, outputs, &rv_map);
+  }
+}
+
 ObjectRef TraceNode::AsJSON(bool remove_postproc) const {
   std::unordered_map<ObjectRef, String, ObjectPtrHash, ObjectPtrEqual> rv_names;
   Array<ffi::Any> json_insts;
@@ -584,6 +611,7 @@ TVM_FFI_STATIC_INIT_BLOCK({
            })
       .def_method("tir.schedule.TracePop", &TraceNode::Pop)
       .def_method("tir.schedule.TraceApplyToSchedule", &TraceNode::ApplyToSchedule)
+      .def_method("tir.schedule.TraceApplyRangeToSchedule", &TraceNode::ApplyRangeToSchedule)
       .def_method("tir.schedule.TraceAsJSON", &TraceNode::AsJSON)
       .def_method("tir.schedule.TraceAsPython", &TraceNode::AsPython)
       .def_method("tir.schedule.TraceWithDecision", &TraceNode::WithDecision)
@@ -43,7 +43,7 @@ Schedule Schedule::Traced(IRModule mod, support::LinearCongruentialEngine::TRand
 Schedule TracedScheduleNode::Copy() {
   ObjectPtr<TracedScheduleNode> n = make_object<TracedScheduleNode>();
   n->error_render_level_ = this->error_render_level_;
-  ConcreteScheduleNode::Copy(&n->state_, &n->symbol_table_);
+  ForkDataInto(n.get());
   n->func_working_on_ = this->func_working_on_;
   n->analyzer_ = std::make_unique<arith::Analyzer>();  // new analyzer needed because it is stateful
   n->rand_state_ = ForkSeed();
@@ -102,8 +102,11 @@ Array<ExprRV> TracedScheduleNode::SamplePartitionedTile(const LoopRV& loop_rv, i
 
 LoopRV TracedScheduleNode::SampleComputeLocation(const BlockRV& block_rv,
                                                  Optional<Integer> decision) {
-  LoopRV result = CreateRV<LoopRV>(tir::SampleComputeLocation(this->state_, &this->rand_state_,
-                                                              this->GetSRef(block_rv), &decision));
+  // The state is prepared before the sref is looked up, as a pending copy materializes it then.
+  ScheduleState& state = this->GetState();
+  StmtSRef block_sref = this->GetSRef(block_rv);
+  LoopRV result = CreateRV<LoopRV>(
+      tir::SampleComputeLocation(state, &this->rand_state_, block_sref, &decision));
 
   static const InstructionKind& kind = InstructionKind::Get("SampleComputeLocation");
   trace_->Append(/*inst=*/Instruction(/*kind=*/kind,  //
@@ -119,7 +122,7 @@ LoopRV TracedScheduleNode::SampleComputeLocation(const BlockRV& block_rv,
 BlockRV TracedScheduleNode::GetBlock(const String& name, const Optional<String>& func_name) {
   GlobalVar gv = NullValue<GlobalVar>();
   if (func_name.has_value()) {
-    gv = state_->mod->GetGlobalVar(func_name.value());
+    gv = GetState()->mod->GetGlobalVar(func_name.value());
   } else if (func_working_on_.defined()) {
     gv = this->func_working_on_.value();
   } else {
@@ -33,6 +33,7 @@
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
 #include <map>
 #include <unordered_map>
 #include <unordered_set>
@@ -368,6 +369,29 @@ class InplaceOpVerifier : public StmtExprVisitor {
   const BufferStoreNode* store_{nullptr};
 };
 
+// Collects the buffer variables that are used other than through buffer
+// accesses or tvm_access_ptr, e.g. passed to an extern call or bound in a
+// LetStmt.  Such a buffer cannot be placed at a non-zero offset of another
+// allocation, because the use of its address cannot be rewritten.
+class BufferAddressEscapeFinder : public StmtExprVisitor {
+ public:
+  void VisitExpr_(const VarNode* op) final { escaped_.insert(op); }
+
+  void VisitExpr_(const CallNode* op) final {
+    if (op->op.same_as(builtin::tvm_access_ptr())) {
+      ICHECK_EQ(op->args.size(), 5U);
+      // args[1] is the buffer variable, whose offset is rewritten with the access.
+      for (size_t i = 2; i < op->args.size(); ++i) {
+        this->VisitExpr(op->args[i]);
+      }
+    } else {
+      StmtExprVisitor::VisitExpr_(op);
+    }
+  }
+
+  std::unordered_set<const VarNode*> escaped_;
+};
+
 /* \brief Rewrite and merge memory allocation.
  *
  * Using LinearAccessPatternFinder, determines which buffers could share an
@@ -382,14 +406,23 @@ class StoragePlanRewriter : public StmtExprMutator {
   using AllocEntry = LinearAccessPatternFinder::AllocEntry;
 
   Stmt Rewrite(Stmt stmt, bool detect_inplace, bool enable_reuse,
-               bool reuse_require_exact_matched_dtype) {
+               bool reuse_require_exact_matched_dtype, bool plan_offsets) {
     detect_inplace_ = detect_inplace;
+    plan_offsets_ = plan_offsets && enable_reuse;
+    if (plan_offsets_) {
+      BufferAddressEscapeFinder escape_finder;
+      escape_finder(stmt);
+      escaped_buffer_vars_ = std::move(escape_finder.escaped_);
+    }
     // plan the rewrite
     LinearAccessPatternFinder finder;
     finder(stmt);
     this->LivenessAnalysis(finder.linear_seq_);
     this->PlanMemory(finder.linear_seq_, finder.alloc_info_, enable_reuse,
                      reuse_require_exact_matched_dtype);
+    if (plan_offsets_) {
+      this->PlanOffsets(reuse_require_exact_matched_dtype);
+    }
     all_buffers_accessed_ = finder.all_buffers_accessed_;
     this->PrepareNewAlloc();
     // start rewrite
@@ -400,6 +433,18 @@ class StoragePlanRewriter : public StmtExprMutator {
     return stmt;
   }
 
+  /*!
+   * \brief The total size in bytes of the buffers handled by the
+   *  interference-graph planner, if each had its own allocation.
+   */
+  uint64_t naive_bytes() const { return naive_bits_ / 8; }
+
+  /*!
+   * \brief The total size in bytes of the allocations produced by the
+   *  interference-graph planner.
+   */
+  uint64_t planned_bytes() const { return planned_bits_ / 8; }
+
   template <typename Node>
   Node VisitBufferAccess(Node node) {
     auto it = alloc_map_.find(node->buffer->data.get());
@@ -569,6 +614,15 @@ class StoragePlanRewriter : public StmtExprMutator {
     // This allows effective sharing among different types as long as their alignment
     // requirement fits into the max_simd_bits.
     uint64_t bits_offset{0};
+    // Whether this entry is placed by the interference-graph planner
+    // instead of the linear free-list reuse.
+    bool offset_planned{false};
+    // Positions in the linear access sequence where the entry becomes live
+    // and dies.  Only tracked for entries placed by the planner.
+    size_t live_begin{0};
+    size_t live_end{0};
+    // The planned entry whose allocation holds this entry at bits_offset.
+    StorageEntry* planned_parent{nullptr};
   };
 
   // Checks whether the storage_scope is especially tagged for a specific memory.
@@ -627,7 +681,11 @@ class StoragePlanRewriter : public StmtExprMutator {
       for (size_t i = 0; i < vec.size(); ++i) {
         StorageEntry* e = vec[i];
         // already merged
-        if (e->bits_offset != 0) continue;
+        if (e->bits_offset != 0 || e->planned_parent != nullptr) continue;
+        if (e->offset_planned && e->merged_children.size() != 0) {
+          NewAllocOffsetPlanned(e);
+          continue;
+        }
         if (e->merged_children.size() != 0) {
           NewAllocTagMerged(e);
           continue;
@@ -766,6 +824,16 @@ class StoragePlanRewriter : public StmtExprMutator {
           << "Allocation exceed bound of memory tag " << e->scope.to_string();
     }
   }
+  // New allocation for entries placed by the interference-graph planner.
+  // The children already carry their offsets, const_nbits holds the planned size.
+  void NewAllocOffsetPlanned(StorageEntry* e) {
+    ICHECK_NE(e->const_nbits, 0U);
+    uint64_t type_bits = e->elem_type.bits() * e->elem_type.lanes();
+    PrimExpr alloc_size = make_const(e->allocs[0]->extents[0].dtype(),
+                                     (e->const_nbits + type_bits - 1) / type_bits);
+    e->alloc_nest.push_back(
+        Allocate(e->alloc_var, e->elem_type, {alloc_size}, const_true(), Evaluate(0)));
+  }
   // Liveness analysis to find gen and kill point of each variable.
   void LivenessAnalysis(const std::vector<StmtEntry>& seq) {
     // find kill point, do a reverse linear scan.
@@ -866,6 +934,16 @@ class StoragePlanRewriter : public StmtExprMutator {
               }
             }
           }
+          if (dst_entry == nullptr && plan_offsets_ &&
+              IsOffsetPlannable(alloc, storage_scope, entry.num_physical_dimensions)) {
+            // Defer placement to PlanOffsets, only record the live range.
+            uint64_t const_nbits = static_cast<uint64_t>(alloc->ConstantAllocationSize()) *
+                                   alloc->dtype.bits() * alloc->dtype.lanes();
+            dst_entry = NewAlloc(alloc, thread_scope_, storage_scope, const_nbits);
+            dst_entry->offset_planned = true;
+            dst_entry->live_begin = i;
+            dst_entry->live_end = seq.size();
+          }
           if (dst_entry == nullptr) {
             dst_entry =
                 FindAlloc(alloc, thread_scope_, storage_scope, entry.num_physical_dimensions,
@@ -900,12 +978,122 @@ class StoragePlanRewriter : public StmtExprMutator {
         for (const VarNode* var : it->second.kill) {
           // skip space which are already replaced by inplace
           if (!inplace_flag.count(var)) {
-            this->Free(var);
+            StorageEntry* e = alloc_map_.at(var);
+            if (e->offset_planned) {
+              e->live_end = i;
+            } else {
+              this->Free(var);
+            }
           }
         }
       }
     }
   }
+  // Whether the allocation can be placed at an arbitrary offset of a shared
+  // allocation by the interference-graph planner.
+  bool IsOffsetPlannable(const AllocateNode* op, const StorageScope& scope,
+                         size_t num_physical_dimensions) const {
+    if (num_physical_dimensions != 1 || scope.tag.length() != 0 ||
+        scope.rank >= StorageRank::kWarp || op->dtype.is_handle()) {
+      return false;
+    }
+    // Offsets are aligned to kPlanAlignBits, which must be a multiple of the element size.
+    uint64_t elem_bits = op->dtype.bits() * op->dtype.lanes();
+    if (elem_bits == 0 || (elem_bits & (elem_bits - 1)) != 0 || elem_bits > kPlanAlignBits) {
+      return false;
+    }
+    // Small arrays are left to the register allocator, as in FindAlloc.
+    uint64_t const_nbits = static_cast<uint64_t>(op->ConstantAllocationSize()) * elem_bits;
+    if (const_nbits <= 32) return false;
+    return !escaped_buffer_vars_.count(op->buffer_var.get());
+  }
+
+  // Place the entries collected during PlanMemory into shared allocations.
+  // Entries that may share an allocation (same attach scope and storage
+  // scope) are planned together as one group.
+  void PlanOffsets(bool reuse_require_exact_matched_dtype) {
+    std::vector<std::vector<StorageEntry*>> groups;
+    for (const auto& entry : alloc_vec_) {
+      StorageEntry* e = entry.get();
+      if (!e->offset_planned) continue;
+      auto it = std::find_if(groups.begin(), groups.end(), [&](const auto& group) {
+        const StorageEntry* first = group[0];
+        return first->attach_scope_ == e->attach_scope_ && first->scope == e->scope &&
+               (!reuse_require_exact_matched_dtype || first->elem_type == e->elem_type);
+      });
+      if (it == groups.end()) {
+        groups.push_back({e});
+      } else {
+        it->push_back(e);
+      }
+    }
+    for (std::vector<StorageEntry*>& group : groups) {
+      PlanGroupOffsets(&group);
+    }
+  }
+
+  // Offset assignment for one group, greedy by size over the interference
+  // graph: entries are placed from the largest to the smallest, each at the
+  // lowest offset that does not overlap an already placed entry whose live
+  // range intersects its own.
+  void PlanGroupOffsets(std::vector<StorageEntry*>* group) {
+    auto aligned_nbits = [](const StorageEntry* e) {
+      return (e->const_nbits + kPlanAlignBits - 1) / kPlanAlignBits * kPlanAlignBits;
+    };
+    std::stable_sort(group->begin(), group->end(),
+                     [](const StorageEntry* a, const StorageEntry* b) {
+                       return a->const_nbits > b->const_nbits;
+                     });
+    size_t num_entries = group->size();
+    std::vector<std::vector<size_t>> interference(num_entries);
+    for (size_t i = 0; i < num_entries; ++i) {
+      for (size_t j = i + 1; j < num_entries; ++j) {
+        const StorageEntry* a = (*group)[i];
+        const StorageEntry* b = (*group)[j];
+        if (a->live_begin <= b->live_end && b->live_begin <= a->live_end) {
+          interference[i].push_back(j);
+          interference[j].push_back(i);
+        }
+      }
+    }
+
+    std::vector<uint64_t> offsets(num_entries, 0);
+    std::vector<bool> placed(num_entries, false);
+    uint64_t total_bits = 0;
+    for (size_t i = 0; i < num_entries; ++i) {
+      uint64_t nbits = aligned_nbits((*group)[i]);
+      std::vector<std::pair<uint64_t, uint64_t>> occupied;
+      for (size_t j : interference[i]) {
+        if (placed[j]) {
+          occupied.emplace_back(offsets[j], offsets[j] + aligned_nbits((*group)[j]));
+        }
+      }
+      std::sort(occupied.begin(), occupied.end());
+      uint64_t offset = 0;
+      for (const auto& range : occupied) {
+        if (offset + nbits <= range.first) break;
+        offset = std::max(offset, range.second);
+      }
+      offsets[i] = offset;
+      placed[i] = true;
+      total_bits = std::max(total_bits, offset + nbits);
+      naive_bits_ += (*group)[i]->const_nbits;
+    }
+    planned_bits_ += total_bits;
+
+    // The largest entry is placed first, at offset zero, and owns the allocation.
+    StorageEntry* parent = (*group)[0];
+    parent->alloc_var = parent->allocs[0]->buffer_var;
+    parent->const_nbits = total_bits;
+    for (size_t i = 1; i < num_entries; ++i) {
+      StorageEntry* child = (*group)[i];
+      child->planned_parent = parent;
+      child->alloc_var = parent->alloc_var;
+      child->bits_offset = offsets[i];
+      parent->merged_children.push_back(child);
+    }
+  }
+
   // Allocate new storage entry.
   StorageEntry* NewAlloc(const AllocateNode* op, const Object* attach_scope,
                          const StorageScope& scope, size_t const_nbits) {
@@ -1022,6 +1210,16 @@ class StoragePlanRewriter : public StmtExprMutator {
   const Object* thread_scope_{nullptr};
   // whether enable inplace detection.
   bool detect_inplace_{false};
+  // whether to place reusable buffers with the interference-graph planner.
+  bool plan_offsets_{false};
+  // Alignment in bits of the offsets assigned by the planner.
+  static constexpr uint64_t kPlanAlignBits = 512;
+  // Buffer variables whose address is used directly, see BufferAddressEscapeFinder.
+  std::unordered_set<const VarNode*> escaped_buffer_vars_;
+  // Total bits of the planned buffers, if each were allocated separately.
+  uint64_t naive_bits_{0};
+  // Total bits of the allocations produced by the planner.
+  uint64_t planned_bits_{0};
   // Locations of free ops.
   std::unordered_map<const Object*, EventEntry> event_map_;
   // constant size free map.
@@ -1748,9 +1946,16 @@ Pass StorageRewrite() {
       // Require exactly same-dtype matching in smem reuse for Vulkan and WebGPU
       reuse_require_exact_matched_dtype = true;
     }
+    bool plan_offsets =
+        ctx->GetConfig<Bool>("tir.storage_rewrite_interference_planning", Bool(false)).value();
     auto* n = f.CopyOnWrite();
-    n->body = StoragePlanRewriter().Rewrite(std::move(n->body), true, enable_reuse,
-                                            reuse_require_exact_matched_dtype);
+    StoragePlanRewriter rewriter;
+    n->body = rewriter.Rewrite(std::move(n->body), true, enable_reuse,
+                               reuse_require_exact_matched_dtype, plan_offsets);
+    if (plan_offsets && enable_reuse) {
+      VLOG(1) << "StorageRewrite: interference-graph planner placed " << rewriter.naive_bytes()
+              << " bytes of buffers into " << rewriter.planned_bytes() << " bytes of allocations";
+    }
     // Parameters may not be rewritten, but internal allocations may.
     // Vectorization of AllocateConst is currently disabled, as it has
     // indexing issues for types that include padding (e.g. int8x3
@@ -25,11 +25,16 @@
 #include <tvm/arith/analyzer.h>
 #include <tvm/ffi/function.h>
 #include <tvm/ffi/reflection/registry.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
+#include <tvm/target/target.h>
+#include <tvm/tir/analysis.h>
 #include <tvm/tir/expr.h>
 #include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -46,6 +51,10 @@ struct UnrollLoopConfigNode : public AttrsNodeReflAdapter<UnrollLoopConfigNode>
   int auto_max_extent;
   int explicit_unroll;
   int unroll_local_access;
+  int auto_unroll_cost_model;
+  int max_unrolled_instructions;
+  int register_budget;
+  int max_interleave;
 
   static void RegisterReflection() {
     namespace refl = tvm::ffi::reflection;
@@ -62,7 +71,23 @@ struct UnrollLoopConfigNode : public AttrsNodeReflAdapter<UnrollLoopConfigNode>
                 "Whether to explicitly unroll the loop instead of setting a pragma",
                 refl::DefaultValue(true))
         .def_ro("unroll_local_access", &UnrollLoopConfigNode::unroll_local_access,
-                "Whether to always unroll local access", refl::DefaultValue(false));
+                "Whether to always unroll local access", refl::DefaultValue(false))
+        .def_ro("auto_unroll_cost_model", &UnrollLoopConfigNode::auto_unroll_cost_model,
+                "Whether to pick unroll and accumulator interleave factors of innermost loops "
+                "from an estimate of the loop body cost",
+                refl::DefaultValue(false))
+        .def_ro("max_unrolled_instructions", &UnrollLoopConfigNode::max_unrolled_instructions,
+                "The maximum estimated number of instructions in an unrolled loop body, "
+                "used by the cost model",
+                refl::DefaultValue(64))
+        .def_ro("register_budget", &UnrollLoopConfigNode::register_budget,
+                "The number of registers the unrolled loop body may keep live, "
+                "used by the cost model",
+                refl::DefaultValue(16))
+        .def_ro("max_interleave", &UnrollLoopConfigNode::max_interleave,
+                "The maximum number of independent accumulators a reduction loop is split into "
+                "on CPU targets, used by the cost model",
+                refl::DefaultValue(4));
   }
 
   static constexpr const char* _type_key = "tir.transform.UnrollLoopConfig";
@@ -268,9 +293,257 @@ class LoopUnroller : public StmtExprMutator {
   arith::Analyzer analyzer_;
 };
 
-Stmt UnrollLoop(Stmt stmt, UnrollLoopConfig cfg) {
-  Stmt ret = LoopUnroller(cfg->auto_max_step, cfg->auto_max_depth, cfg->auto_max_extent,
-                          cfg->explicit_unroll, cfg->unroll_local_access)(stmt);
+/*!
+ * \brief Per-iteration cost of an innermost loop body, used by the cost-driven unroller.
+ */
+struct LoopBodyCost {
+  /*! \brief Estimated number of instructions executed by one iteration. */
+  double instructions{0};
+  /*! \brief Estimated number of values one iteration keeps live in registers. */
+  int64_t live_values{0};
+};
+
+class LoopBodyCostEstimator : public StmtExprVisitor {
+ public:
+  /*!
+   * \brief Estimate the cost of one iteration of a loop body.
+   * \param body The loop body.
+   * \return The cost, or std::nullopt if the body contains a nested loop.
+   */
+  static std::optional<LoopBodyCost> Estimate(const Stmt& body) {
+    LoopBodyCostEstimator estimator;
+    estimator(body);
+    if (estimator.has_loop_) return std::nullopt;
+    LoopBodyCost cost;
+    // Arithmetic (including index computation) comes from the FLOP estimator,
+    // every load and store adds one memory instruction on top of it.
+    cost.instructions =
+        std::max(1.0, EstimateTIRFlops(body) + static_cast<double>(estimator.num_memory_ops_));
+    // Each distinct loaded value and each stored result occupies a register.
+    cost.live_values =
+        std::max<int64_t>(1, static_cast<int64_t>(estimator.loads_.size()) + estimator.num_stores_);
+    return cost;
+  }
+
+ private:
+  void VisitStmt_(const ForNode* op) final { has_loop_ = true; }
+  void VisitStmt_(const WhileNode* op) final { has_loop_ = true; }
+
+  void VisitStmt_(const BufferStoreNode* op) final {
+    ++num_memory_ops_;
+    ++num_stores_;
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const BufferLoadNode* op) final {
+    ++num_memory_ops_;
+    loads_.insert(GetRef<PrimExpr>(op));
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  bool has_loop_{false};
+  int64_t num_memory_ops_{0};
+  int64_t num_stores_{0};
+  std::unordered_set<PrimExpr, StructuralHash, StructuralEqual> loads_;
+};
+
+/*!
+ * \brief Unroll innermost serial loops by factors picked from the estimated body cost.
+ *
+ *  Each innermost serial loop with a constant extent is unrolled by the largest divisor
+ *  of its extent for which the unrolled body stays within both the instruction and the
+ *  register budget. Loops that fit completely are marked as unrolled, the others are
+ *  split into an outer serial loop and an inner unrolled loop.
+ *
+ *  When interleaving is enabled (CPU targets), a reduction loop of the form
+ *  C[i] = C[i] + f(k), whose store indices do not depend on k, is instead rewritten to
+ *  accumulate into several local accumulators, so consecutive iterations no longer form
+ *  a single dependency chain. The partial sums are added to C[i] after the loop. This
+ *  re-associates the reduction, which is one of the reasons the mode is opt-in.
+ */
+class CostDrivenLoopUnroller : public StmtMutator {
+ public:
+  explicit CostDrivenLoopUnroller(int max_unrolled_instructions, int register_budget,
+                                  int max_interleave, bool interleave_reductions)
+      : max_unrolled_instructions_(max_unrolled_instructions),
+        register_budget_(register_budget),
+        max_interleave_(max_interleave),
+        interleave_reductions_(interleave_reductions) {}
+
+  Stmt VisitStmt_(const ForNode* op) final {
+    // Post order, so that only loops without a nested loop are considered.
+    Stmt stmt = StmtMutator::VisitStmt_(op);
+    op = stmt.as<ForNode>();
+    if (op->kind != ForKind::kSerial || !op->annotations.empty()) return stmt;
+    const auto* extent = analyzer_.Simplify(op->extent).as<IntImmNode>();
+    if (extent == nullptr || extent->value <= 1 ||
+        extent->value > std::numeric_limits<int>::max()) {
+      return stmt;
+    }
+    std::optional<LoopBodyCost> cost = LoopBodyCostEstimator::Estimate(op->body);
+    if (!cost.has_value()) return stmt;
+
+    if (interleave_reductions_) {
+      if (std::optional<Reduction> reduction = MatchReduction(op)) {
+        int factor = PickFactor(extent->value, cost.value(), max_interleave_);
+        if (factor > 1) {
+          return InterleaveReduction(op, reduction.value(), extent->value, factor);
+        }
+      }
+    }
+
+    int factor = PickFactor(extent->value, cost.value(), std::numeric_limits<int>::max());
+    if (factor <= 1) {
+      return stmt;
+    } else if (factor == extent->value) {
+      return For(op->loop_var, op->min, op->extent, ForKind::kUnrolled, op->body,
+                 op->thread_binding, op->annotations);
+    } else {
+      return SplitLoop(op, extent->value, factor);
+    }
+  }
+
+ private:
+  /*! \brief A reduction C[i] = C[i] + update over the loop variable. */
+  struct Reduction {
+    BufferStore store;
+    PrimExpr update;
+  };
+
+  // Returns the largest divisor of the extent, no larger than max_factor,
+  // for which the unrolled body fits the instruction and register budgets.
+  int PickFactor(int64_t extent, const LoopBodyCost& cost, int max_factor) const {
+    int best = 1;
+    for (int64_t factor = 2; factor <= extent && factor <= max_factor; ++factor) {
+      if (factor * cost.instructions > max_unrolled_instructions_ ||
+          factor * cost.live_values > register_budget_) {
+        break;
+      }
+      if (extent % factor == 0) {
+        best = static_cast<int>(factor);
+      }
+    }
+    return best;
+  }
+
+  std::optional<Reduction> MatchReduction(const ForNode* loop) const {
+    const auto* store = loop->body.as<BufferStoreNode>();
+    if (store == nullptr || store->predicate.defined()) return std::nullopt;
+    DataType dtype = store->value.dtype();
+    if (!dtype.is_float() && !dtype.is_int() && !dtype.is_uint()) return std::nullopt;
+    const auto* add = store->value.as<AddNode>();
+    if (add == nullptr) return std::nullopt;
+
+    auto is_self_load = [store](const PrimExpr& expr) {
+      const auto* load = expr.as<BufferLoadNode>();
+      return load != nullptr && !load->predicate.defined() &&
+             load->buffer->data.same_as(store->buffer->data) &&
+             StructuralEqual()(load->indices, store->indices);
+    };
+    PrimExpr update;
+    if (is_self_load(add->a)) {
+      update = add->b;
+    } else if (is_self_load(add->b)) {
+      update = add->a;
+    } else {
+      return std::nullopt;
+    }
+
+    const VarNode* loop_var = loop->loop_var.get();
+    const VarNode* buffer_var = store->buffer->data.get();
+    for (const PrimExpr& index : store->indices) {
+      if (UsesVar(index, [loop_var](const VarNode* var) { return var == loop_var; })) {
+        return std::nullopt;
+      }
+    }
+    if (UsesVar(update, [buffer_var](const VarNode* var) { return var == buffer_var; }) ||
+        !UsesVar(update, [loop_var](const VarNode* var) { return var == loop_var; })) {
+      return std::nullopt;
+    }
+    return Reduction{GetRef<BufferStore>(store), update};
+  }
+
+  Stmt InterleaveReduction(const ForNode* loop, const Reduction& reduction, int64_t extent,
+                           int factor) {
+    DataType dtype = reduction.store->value.dtype();
+    DataType index_dtype = loop->loop_var.dtype();
+    const std::string& name = loop->loop_var->name_hint;
+    Buffer acc = decl_buffer({make_const(index_dtype, factor)}, dtype,
+                             reduction.store->buffer->name + "_acc", "local");
+
+    Var init_var(name + "_init", index_dtype);
+    Stmt init = For(init_var, make_zero(index_dtype), make_const(index_dtype, factor),
+                    ForKind::kUnrolled, BufferStore(acc, make_zero(dtype), {init_var}));
+
+    Var outer(name + "_outer", index_dtype);
+    Var inner(name + "_inner", index_dtype);
+    PrimExpr update = Substitute(
+        reduction.update,
+        Map<Var, PrimExpr>{
+            {loop->loop_var, loop->min + outer * make_const(index_dtype, factor) + inner}});
+    Stmt accumulate = BufferStore(acc, BufferLoad(acc, {inner}) + update, {inner});
+    accumulate = For(inner, make_zero(index_dtype), make_const(index_dtype, factor),
+                     ForKind::kUnrolled, accumulate);
+    accumulate = For(outer, make_zero(index_dtype), make_const(index_dtype, extent / factor),
+                     ForKind::kSerial, accumulate);
+
+    PrimExpr total = BufferLoad(acc, {make_zero(index_dtype)});
+    for (int i = 1; i < factor; ++i) {
+      total = total + BufferLoad(acc, {make_const(index_dtype, i)});
+    }
+    const BufferStore& store = reduction.store;
+    Stmt finalize =
+        BufferStore(store->buffer, BufferLoad(store->buffer, store->indices) + total,
+                    store->indices);
+
+    Stmt body = DeclBuffer(acc, SeqStmt({init, accumulate, finalize}));
+    return Allocate(acc->data, dtype, acc->shape, const_true(), body);
+  }
+
+  Stmt SplitLoop(const ForNode* loop, int64_t extent, int factor) {
+    DataType index_dtype = loop->loop_var.dtype();
+    const std::string& name = loop->loop_var->name_hint;
+    Var outer(name + "_outer", index_dtype);
+    Var inner(name + "_inner", index_dtype);
+    Stmt body = Substitute(
+        loop->body,
+        Map<Var, PrimExpr>{
+            {loop->loop_var, loop->min + outer * make_const(index_dtype, factor) + inner}});
+    body = For(inner, make_zero(index_dtype), make_const(index_dtype, factor), ForKind::kUnrolled,
+               body);
+    return For(outer, make_zero(index_dtype), make_const(index_dtype, extent / factor),
+               ForKind::kSerial, body);
+  }
+
+  // maximum estimated instructions in an unrolled body
+  int max_unrolled_instructions_;
+  // maximum number of values an unrolled body may keep live
+  int register_budget_;
+  // maximum number of accumulators a reduction is split into
+  int max_interleave_;
+  // whether reductions may be re-associated into several accumulators
+  bool interleave_reductions_;
+  // analyzer
+  arith::Analyzer analyzer_;
+};
+
+// Whether the function is compiled for a CPU target.
+bool IsCPUTarget(const PrimFunc& func) {
+  Optional<Target> target = func->GetAttr<Target>(tvm::attr::kTarget);
+  if (!target.defined()) {
+    target = Target::Current(/*allow_not_defined=*/true);
+  }
+  return target.defined() && target.value()->GetTargetDeviceType() == kDLCPU;
+}
+
+Stmt UnrollLoop(Stmt stmt, UnrollLoopConfig cfg, bool is_cpu_target) {
+  Stmt ret = stmt;
+  if (cfg->auto_unroll_cost_model) {
+    ret = CostDrivenLoopUnroller(cfg->max_unrolled_instructions, cfg->register_budget,
+                                 cfg->max_interleave, is_cpu_target)(ret);
+  }
+  ret = LoopUnroller(cfg->auto_max_step, cfg->auto_max_depth, cfg->auto_max_extent,
+                     cfg->explicit_unroll, cfg->unroll_local_access)(ret);
   if (!ret.same_as(stmt)) {
     return ConvertSSA(ret);
   } else {
@@ -287,7 +560,8 @@ Pass UnrollLoop() {
     if (!cfg.defined()) {
       cfg = AttrsWithDefaultValues<UnrollLoopConfig>();
     }
-    n->body = UnrollLoop(std::move(f->body), cfg.value());
+    bool is_cpu_target = IsCPUTarget(f);
+    n->body = UnrollLoop(std::move(f->body), cfg.value(), is_cpu_target);
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tir.UnrollLoop", {});
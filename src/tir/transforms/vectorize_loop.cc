@@ -85,6 +85,11 @@ bool EnableBufferLevelPredication(Target target) {
   return arith::TargetHasVLA(target);
 }
 
+bool EnableVectorizePredicatedTail() {
+  transform::PassContext pass_ctx = transform::PassContext::Current();
+  return pass_ctx->GetConfig<Bool>("tir.vectorize_predicated_tail", Bool(false)).value();
+}
+
 /*!
  * \brief A pass that tries to rewrite buffer accesses (loads and stores) with a
  * predicate expression where possible.
@@ -108,7 +113,14 @@ bool EnableBufferLevelPredication(Target target) {
  */
 class TryPredicateBufferAccesses : public StmtExprMutator {
  public:
-  TryPredicateBufferAccesses() {}
+  /*!
+   * \param allow_offset_access Whether contiguous accesses whose base differs from
+   * the base of the predicate can be predicated as well. This is sound because the
+   * lane mask only depends on the lane index, but is only enabled for the predicated
+   * tail mode to keep the default output unchanged.
+   */
+  explicit TryPredicateBufferAccesses(bool allow_offset_access = false)
+      : allow_offset_access_(allow_offset_access) {}
 
   /*!
    * \brief Run the pass to try to exact predicates.
@@ -132,9 +144,14 @@ class TryPredicateBufferAccesses : public StmtExprMutator {
     if (!lt->a->IsInstance<RampNode>() || !lt->b->IsInstance<BroadcastNode>()) {
       return {false, stmt};
     }
+    // The lane mask is only equivalent to the condition for unit stride
+    if (!is_one(Downcast<Ramp>(lt->a)->stride)) {
+      return {false, stmt};
+    }
 
     base_ = Downcast<Ramp>(lt->a)->base;
     limit_ = Downcast<Broadcast>(lt->b)->value;
+    lanes_dtype_ = lt->a->dtype;
 
     // Now we can try to predicate
     Stmt predicated_stmt = StmtExprMutator::operator()(std::move(stmt));
@@ -167,7 +184,11 @@ class TryPredicateBufferAccesses : public StmtExprMutator {
     Ramp ramp = Downcast<Ramp>(node->indices[0]);
 
     // The vectorized access pattern must match the base of the predicate
-    if (!tvm::StructuralEqual()(ramp->base, base_)) {
+    if (allow_offset_access_) {
+      if (!is_one(ramp->stride) || ramp->dtype != lanes_dtype_) {
+        return node;
+      }
+    } else if (!tvm::StructuralEqual()(ramp->base, base_)) {
       return node;
     }
 
@@ -187,6 +208,10 @@ class TryPredicateBufferAccesses : public StmtExprMutator {
   /*! \brief The limit of the predicate. The expr specifies the upper bound of the base's
    * evaluated value. */
   PrimExpr limit_;
+  /*! \brief The dtype of the ramp in the predicate. */
+  DataType lanes_dtype_;
+  /*! \brief Whether accesses with a base different from the predicate can be predicated. */
+  bool allow_offset_access_;
   /*! \brief The number of buffer accesses in the stmt we will analyze. */
   size_t num_accesses_analyzed_ = 0;
   /*! \brief The number of buffer accesses rewritten with predicates. */
@@ -774,6 +799,13 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     if (op->else_case) {
       else_case = this->VisitStmt(op->else_case.value());
     }
+    // Split into an unpredicated vector body and a predicated tail
+    if (!cond_need_scalarize && condition.dtype().is_fixed_length_vector() &&
+        !else_case.defined() && EnableVectorizePredicatedTail()) {
+      if (Optional<Stmt> split = SplitPredicatedTail(condition, then_case, op)) {
+        return split.value();
+      }
+    }
     // Check if we can rewrite the condition with predicated buffers
     if (EnableBufferLevelPredication(target_) &&
         condition.dtype().is_scalable_or_fixed_length_vector() && !else_case.defined()) {
@@ -862,6 +894,49 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     return Allocate(op->buffer_var, op->dtype, extents, condition, body);
   }
 
+  /*!
+   * \brief Rewrite a vectorized guard `Ramp(base, 1, lanes) < Broadcast(limit)` as
+   *
+   * \code
+   *   if base + lanes - 1 < limit:
+   *     then_case                      # all lanes active, no masking
+   *   else:
+   *     then_case with masked accesses # or the scalarized guard if masking fails
+   * \endcode
+   *
+   * so that all but the last iteration of the enclosing loop run the plain
+   * vector body. Works for symbolic limits as well.
+   */
+  Optional<Stmt> SplitPredicatedTail(const PrimExpr& condition, const Stmt& then_case,
+                                     const IfThenElseNode* op) {
+    const LTNode* lt = condition.as<LTNode>();
+    if (lt == nullptr) return std::nullopt;
+    const RampNode* ramp = lt->a.as<RampNode>();
+    const BroadcastNode* limit = lt->b.as<BroadcastNode>();
+    if (ramp == nullptr || limit == nullptr || !is_one(ramp->stride)) return std::nullopt;
+    // The vector body must not have fallen back to scalar code.
+    if (!CheckContains::StmtContains(then_case, [](const PrimExpr& e) {
+          return e.dtype().is_fixed_length_vector();
+        })) {
+      return std::nullopt;
+    }
+
+    int lanes = ramp->dtype.lanes();
+    PrimExpr last_lane = ramp->base + make_const(ramp->base.dtype(), lanes - 1);
+    PrimExpr all_active = analyzer_.Simplify(last_lane < limit->value);
+    if (is_one(all_active)) {
+      return then_case;
+    }
+
+    std::pair<bool, Stmt> predicated =
+        TryPredicateBufferAccesses(/*allow_offset_access=*/true).Run(then_case, condition);
+    Stmt tail = predicated.first ? predicated.second : Scalarize(GetRef<Stmt>(op));
+    if (is_zero(all_active)) {
+      return tail;
+    }
+    return IfThenElse(all_active, then_case, tail);
+  }
+
   // scalarize the statment
   Stmt Scalarize(Stmt stmt) {
     Var idx(var_->name_hint + ".s", var_->dtype);
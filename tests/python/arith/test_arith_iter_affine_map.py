@@ -516,6 +516,31 @@ def test_predicate():
     )
 
 
+def test_detect_iter_map_batch():
+    x = tvm.tir.Var("x", "int32")
+    y = tvm.tir.Var("y", "int32")
+    dom_map = var_dom([(x, 13), (y, 10)])
+    predicate = x * 10 + y < 128
+    indices_batch = [
+        [x * 10 + y],
+        [floordiv(x * 10 + y, 4), floormod(x * 10 + y, 4)],
+        [x * 10 + y],
+        [x + y],
+        [y],
+    ]
+    # The batch matches the detection of each tuple, also when the predicate is not parsable
+    for pred in [predicate, x * y < 3]:
+        results = tvm.arith.detect_iter_map_batch(indices_batch, dom_map, pred)
+        assert len(results) == len(indices_batch)
+        for indices, result in zip(indices_batch, results):
+            expected = tvm.arith.detect_iter_map(indices, dom_map, pred)
+            tvm.ir.assert_structural_equal(result.indices, expected.indices)
+            assert len(result.errors) == len(expected.errors)
+    results = tvm.arith.detect_iter_map_batch(indices_batch, dom_map, predicate)
+    assert len(results[0].indices) == 1
+    assert len(results[1].indices) == 2
+
+
 def convert_division(divisions):
     if divisions is None or len(divisions) == 0:
         return []
@@ -144,5 +144,46 @@ def test_simplify_floor_mod_with_linear_offset():
     assert ana.can_prove_equal(tvm.tir.floormod(expr1, divisor2), 0)
 
 
+def test_simplify_memo_respects_context():
+    memo = tvm.arith.SimplifyMemo()
+    x = tir.Var("x", "int32")
+    with tvm.transform.PassContext(config={"arith.simplify_memo": memo}):
+        ana = tvm.arith.Analyzer()
+        tvm.ir.assert_structural_equal(ana.rewrite_simplify(x < 10), x < 10)
+        with ana.constraint_scope(x < 5):
+            tvm.ir.assert_structural_equal(ana.rewrite_simplify(x < 10), tir.const(True))
+        tvm.ir.assert_structural_equal(ana.rewrite_simplify(x < 10), x < 10)
+
+        bound_ana = tvm.arith.Analyzer()
+        bound_ana.bind(x, tvm.ir.Range(0, 4))
+        tvm.ir.assert_structural_equal(bound_ana.rewrite_simplify(x < 10), tir.const(True))
+
+        num_hits = memo.num_hits
+        tvm.ir.assert_structural_equal(tvm.arith.Analyzer().rewrite_simplify(x < 10), x < 10)
+        assert memo.num_hits == num_hits + 1
+    assert len(memo) > 0
+
+
+def test_simplify_memo_shared_across_passes():
+    @T.prim_func(private=True)
+    def func(A: T.Buffer((16,), "float32"), n: T.int32):
+        for i in range(16):
+            if i // 4 * 4 + i % 4 < 16 and n - n < 1:
+                A[(i * 2 + 2) // 2 - 1] = T.float32(0)
+
+    mod = tvm.IRModule.from_expr(func)
+    expected = tvm.tir.transform.Simplify()(mod)
+
+    memo = tvm.arith.SimplifyMemo()
+    with tvm.transform.PassContext(config={"arith.simplify_memo": memo}):
+        first = tvm.tir.transform.Simplify()(mod)
+        num_hits = memo.num_hits
+        second = tvm.tir.transform.Simplify()(mod)
+    tvm.ir.assert_structural_equal(first, expected)
+    tvm.ir.assert_structural_equal(second, expected)
+    assert memo.num_hits > num_hits
+    assert 0.0 < memo.hit_rate <= 1.0
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -16,6 +16,8 @@
 # under the License.
 # pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
 """Test Meta Schedule Database"""
+import json
+import multiprocessing
 import os.path as osp
 import tempfile
 from typing import Callable, List, Optional
@@ -24,7 +26,7 @@ import pytest
 import tvm
 import tvm.testing
 from tvm import meta_schedule as ms
-from tvm import tir
+from tvm import te, tir
 from tvm.ir.module import IRModule
 from tvm.meta_schedule.database import TuningRecord, Workload
 from tvm.script import tir as T
@@ -582,6 +584,174 @@ def test_json_database_get_top_k(k, expected):
     assert result == expected
 
 
+def _create_matmul(n: int, name: str = "matmul") -> IRModule:
+    A = te.placeholder((n, n), name="A")  # pylint: disable=invalid-name
+    B = te.placeholder((n, n), name="B")  # pylint: disable=invalid-name
+    k = te.reduce_axis((0, n), name="k")
+    C = te.compute(  # pylint: disable=invalid-name
+        (n, n), lambda i, j: te.sum(A[i, k] * B[k, j], axis=[k]), name=name
+    )
+    return IRModule({"main": te.create_prim_func([A, B, C])})
+
+
+def _schedule_matmul_sampled(sch: Schedule):
+    block = sch.get_block("matmul")
+    for loop in sch.get_loops(block=block):
+        sch.split(loop, factors=sch.sample_perfect_tile(loop, n=2))
+
+
+def test_meta_schedule_database_query_nearest_tuning_records():
+    target = tvm.target.Target("llvm")
+    database = ms.database.MemoryDatabase()
+    for mod, sch_fn, run_sec in [
+        (_create_matmul(128), _schedule_matmul_sampled, 1.0),
+        (_create_matmul(1024), _schedule_matmul_sampled, 2.0),
+        (_create_matmul(256, name="add"), lambda sch: None, 3.0),
+    ]:
+        database.commit_tuning_record(
+            TuningRecord(
+                _create_schedule(mod, sch_fn).trace,
+                workload=database.commit_workload(mod),
+                run_secs=[run_sec],
+                target=target,
+                args_info=ms.arg_info.ArgInfo.from_prim_func(func=mod["main"]),
+            )
+        )
+    mod = _create_matmul(256)
+    # The workload with another kind of anchor block is not comparable
+    records = database.query_nearest_tuning_records(mod, target, top_k=3)
+    assert [record.run_secs[0].value for record in records] == [1.0, 2.0]
+    (record,) = database.query_nearest_tuning_records(mod, target, top_k=1)
+    assert record.run_secs[0].value == 1.0
+    # The workload itself is excluded
+    records = database.query_nearest_tuning_records(_create_matmul(128), target, top_k=3)
+    assert [record.run_secs[0].value for record in records] == [2.0]
+    # The trace is retargeted to the new shape
+    sch = Schedule(mod)
+    ms.trace_apply.schedule_using_anchor_trace(sch, record.trace, target)
+    loops = sch.get_loops(sch.get_block("matmul"))
+    assert len(loops) == 6
+    extents = [sch.get(loop).extent.value for loop in loops]
+    assert [extents[i] * extents[i + 1] for i in [0, 2, 4]] == [256, 256, 256]
+
+
+def test_meta_schedule_database_run_secs_statistics():
+    mod: IRModule = Matmul
+    target = tvm.target.Target("llvm")
+    database = ms.database.MemoryDatabase()
+    workload = database.commit_workload(mod)
+    trace_a = _create_schedule(mod, _schedule_matmul).trace
+    trace_b = _create_schedule(mod, _schedule_matmul_sampled).trace
+
+    def commit_record(trace, run_secs):  # pylint: disable=invalid-name
+        record = TuningRecord(
+            trace,
+            workload=workload,
+            run_secs=run_secs,
+            target=target,
+            args_info=ms.arg_info.ArgInfo.from_prim_func(func=mod["main"]),
+        )
+        database.commit_tuning_record(record)
+        return record
+
+    stats = commit_record(trace_a, [1.0, 1.0, 10.0]).run_secs_statistics()
+    assert stats["count"] == 3
+    assert stats["median"] == 1.0
+    assert stats["p10"] == 1.0
+    assert abs(stats["p90"] - 8.2) < 1e-6
+    assert abs(stats["variance"] - 27.0) < 1e-6
+    commit_record(trace_b, [2.0])
+    # The outlier does not demote the schedule ranked by the median
+    (record,) = database.get_top_k(workload, 1)
+    assert [run_sec.value for run_sec in record.run_secs] == [1.0, 1.0, 10.0]
+    # The samples of the same schedule are pooled when querying the best record
+    commit_record(trace_a, [3.0, 3.0, 3.0])
+    record = database.query_tuning_record(mod, target, workload_name="main")
+    assert [run_sec.value for run_sec in record.run_secs] == [2.0]
+    commit_record(trace_b, [4.0, 4.0])
+    record = database.query_tuning_record(mod, target, workload_name="main")
+    assert sorted(run_sec.value for run_sec in record.run_secs) == [1.0, 1.0, 3.0, 3.0, 3.0, 10.0]
+
+
+def test_meta_schedule_database_shared():
+    mod: IRModule = Matmul
+    target = tvm.target.Target("llvm")
+    arg_info = ms.arg_info.ArgInfo.from_prim_func(func=mod["main"])
+    trace = _create_schedule(mod, _schedule_matmul).trace
+    with tempfile.TemporaryDirectory() as tmpdir:
+        # Each database stands for a tuning process sharing the files
+        db_1 = ms.database.SharedDatabase(work_dir=tmpdir, num_shards=2)
+        db_2 = ms.database.SharedDatabase(work_dir=tmpdir, num_shards=3)
+        workload_1 = db_1.commit_workload(mod)
+        assert db_2.has_workload(mod)
+        workload_2 = db_2.commit_workload(mod)
+        for db, workload, run_sec in [(db_1, workload_1, 2.0), (db_2, workload_2, 1.0)]:
+            db.commit_tuning_record(
+                TuningRecord(
+                    trace, workload=workload, run_secs=[run_sec], target=target, args_info=arg_info
+                )
+            )
+        for db, workload in [(db_1, workload_1), (db_2, workload_2)]:
+            assert len(db) == 2
+            records = db.get_top_k(workload, 2)
+            assert [record.run_secs[0].value for record in records] == [1.0, 2.0]
+        # The files are compatible with JSONDatabase
+        db_3 = ms.database.JSONDatabase(work_dir=tmpdir)
+        assert len(db_3) == 2
+        with open(osp.join(tmpdir, "database_workload.json"), encoding="utf-8") as file:
+            assert len(file.readlines()) == 1
+
+
+def _shared_database_worker(work_dir: str, worker_id: int, num_records: int, barrier) -> None:
+    mod: IRModule = Matmul
+    target = tvm.target.Target("llvm")
+    arg_info = ms.arg_info.ArgInfo.from_prim_func(func=mod["main"])
+    trace = _create_schedule(mod, _schedule_matmul).trace
+    db = ms.database.SharedDatabase(work_dir=work_dir, num_shards=2)
+    workload = db.commit_workload(mod)
+    for i in range(num_records):
+        run_sec = float(worker_id * num_records + i + 1)
+        db.commit_tuning_record(
+            TuningRecord(
+                trace, workload=workload, run_secs=[run_sec], target=target, args_info=arg_info
+            )
+        )
+    # Wait until all the processes have committed their records
+    barrier.wait(timeout=120)
+    records = db.get_top_k(workload, 2 * num_records)
+    expected = [float(i + 1) for i in range(2 * num_records)]
+    assert [record.run_secs[0].value for record in records] == expected
+
+
+def test_meta_schedule_database_shared_multiprocess():
+    num_records = 20
+    ctx = multiprocessing.get_context("spawn")
+    with tempfile.TemporaryDirectory() as tmpdir:
+        barrier = ctx.Barrier(2)
+        procs = [
+            ctx.Process(
+                target=_shared_database_worker, args=(tmpdir, worker_id, num_records, barrier)
+            )
+            for worker_id in range(2)
+        ]
+        for proc in procs:
+            proc.start()
+        for proc in procs:
+            proc.join(timeout=300)
+            assert proc.exitcode == 0
+        # The workload is written once, and no line is interleaved with another
+        with open(osp.join(tmpdir, "database_workload.json"), encoding="utf-8") as file:
+            workload_lines = file.readlines()
+        assert len(workload_lines) == 1
+        json.loads(workload_lines[0])
+        with open(osp.join(tmpdir, "database_tuning_record.json"), encoding="utf-8") as file:
+            record_lines = file.readlines()
+        assert len(record_lines) == 2 * num_records
+        for line in record_lines:
+            workload_index, _ = json.loads(line)
+            assert workload_index == 0
+
+
 def MatmulPrimFunc() -> IRModule:
     return Matmul
 
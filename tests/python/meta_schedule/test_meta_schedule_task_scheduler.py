@@ -436,6 +436,61 @@ def test_meta_schedule_task_scheduler_gradient_based_with_null_search_strategy()
     assert len(database.get_top_k(database.commit_workload(MatmulReluModule), 100)) == 10
 
 
+def test_meta_schedule_task_scheduler_gradient_based_plateau():
+    @ms.derived_object
+    class ConstantRunnerFuture(ms.runner.PyRunnerFuture):
+        def done(self) -> bool:
+            return True
+
+        def result(self) -> ms.runner.RunnerResult:
+            return ms.runner.RunnerResult([1.0], None)
+
+    @ms.derived_object
+    class ConstantRunner(ms.runner.PyRunner):
+        def run(self, runner_inputs):
+            return [ConstantRunnerFuture() for _ in runner_inputs]
+
+    plateau_rounds = 2
+    num_trials_per_iter = 6
+    tasks = [
+        ms.TuneContext(
+            MatmulModule,
+            target=tvm.target.Target("llvm"),
+            space_generator=_schedule_matmul,
+            search_strategy=ms.search_strategy.ReplayTrace(),
+            task_name="Matmul",
+            rand_state=42,
+        ),
+        ms.TuneContext(
+            BatchMatmulModule,
+            target=tvm.target.Target("llvm"),
+            space_generator=_schedule_batch_matmul,
+            search_strategy=ms.search_strategy.ReplayTrace(),
+            task_name="BatchMatmul",
+            rand_state=0x114514,
+        ),
+    ]
+    database = ms.database.MemoryDatabase()
+    gradient_based = ms.task_scheduler.GradientBased(plateau_rounds=plateau_rounds)
+    gradient_based.tune(
+        tasks,
+        task_weights=[1.0, 1.0],
+        builder=DummyBuilder(),
+        runner=ConstantRunner(),
+        database=database,
+        measure_callbacks=[ms.measure_callback.AddToDatabase()],
+        max_trials_global=1000,
+        max_trials_per_task=500,
+        num_trials_per_iter=num_trials_per_iter,
+        cost_model=None,
+    )
+    # The latency never improves, so each task stops once it plateaus
+    for task in tasks:
+        assert len(database.get_top_k(database.commit_workload(task.mod), 1000)) == (
+            (plateau_rounds + 1) * num_trials_per_iter
+        )
+
+
 if __name__ == "__main__":
     test_meta_schedule_task_scheduler_single()
     test_meta_schedule_task_scheduler_multiple()
@@ -444,3 +499,4 @@ if __name__ == "__main__":
     test_meta_schedule_task_scheduler_override_next_task_id_only()
     test_meta_schedule_task_scheduler_multiple_gradient_based()
     test_meta_schedule_task_scheduler_gradient_based_with_null_search_strategy()
+    test_meta_schedule_task_scheduler_gradient_based_plateau()
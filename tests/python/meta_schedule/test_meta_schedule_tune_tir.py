@@ -183,6 +183,60 @@ def test_tune_block_cpu():
         sch.trace.show()
 
 
+@T.prim_func
+def dynamic_matmul(a: T.handle, b: T.handle, c: T.handle) -> None:
+    n = T.int64()
+    A = T.match_buffer(a, [n, 64])
+    B = T.match_buffer(b, [64, 64])
+    C = T.match_buffer(c, [n, 64])
+    for i, j, k in T.grid(n, 64, 64):
+        with T.block("update"):
+            vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+            with T.init():
+                C[vi, vj] = 0.0
+            C[vi, vj] = C[vi, vj] + A[vi, vk] * B[vj, vk]
+
+
+def test_shape_buckets():
+    assert ms.tir_integration.shape_buckets(3, 20) == [4, 8, 16, 32]
+    assert ms.tir_integration.shape_buckets(1, 1) == [1]
+
+
+@tvm.testing.requires_llvm
+def test_compile_tir_buckets():
+    target = Target("llvm")
+    database = ms.database.MemoryDatabase()
+    n = dynamic_matmul.buffer_map[dynamic_matmul.params[0]].shape[0]
+    buckets = [4, 16]
+    for value in buckets:
+        # Stands for the schedule tuned for the bucket by `tune_tir_buckets`
+        func = ms.tir_integration._specialize_bucket(dynamic_matmul, n, value)
+        mod = ms.tune_context._normalize_mod(func)
+        sch = Schedule(mod)
+        i, _, _ = sch.get_loops(sch.get_block("update"))
+        sch.split(i, factors=sch.sample_perfect_tile(i, n=2, decision=[value // 4, 4]))
+        database.commit_tuning_record(
+            ms.database.TuningRecord(
+                sch.trace,
+                workload=database.commit_workload(mod),
+                run_secs=[1.0],
+                target=target,
+                args_info=ms.arg_info.ArgInfo.from_prim_func(mod["main"]),
+            )
+        )
+    func = ms.tir_integration.compile_tir_buckets(database, dynamic_matmul, "n", buckets, target)
+    assert func.attrs["tir.is_scheduled"]
+    lib = tvm.compile(func, target=target)
+    dev = tvm.cpu()
+    # Within the buckets, on the buckets and beyond the largest bucket
+    for value in [3, 4, 10, 16, 40]:
+        a_np = np.random.uniform(size=(value, 64)).astype("float32")
+        b_np = np.random.uniform(size=(64, 64)).astype("float32")
+        c = tvm.nd.array(np.zeros((value, 64), dtype="float32"), dev)
+        lib(tvm.nd.array(a_np, dev), tvm.nd.array(b_np, dev), c)
+        tvm.testing.assert_allclose(c.numpy(), a_np @ b_np.T, rtol=1e-4, atol=1e-4)
+
+
 if __name__ == """__main__""":
     test_tune_matmul_cpu()
     test_tune_matmul_cuda()
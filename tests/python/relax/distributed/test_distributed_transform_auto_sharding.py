@@ -0,0 +1,145 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+#  type: ignore
+
+from tvm.script.parser import ir as I
+from tvm.script.parser import relax as R
+import tvm
+from tvm import relax
+from tvm.ir import assert_structural_equal
+import tvm.testing
+
+
+def test_mlp_data_parallel():
+    @I.ir_module
+    class MLP:
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x: R.Tensor((128, 128), "float32"),
+            weight1: R.Tensor((128, 128), "float32"),
+            weight2: R.Tensor((128, 128), "float32"),
+        ) -> R.Tensor((128, 128), "float32"):
+            lv0 = R.matmul(x, weight1)
+            lv1 = R.nn.gelu(lv0)
+            lv2 = R.matmul(lv1, weight2)
+            return lv2
+
+    @I.ir_module
+    class Annotated:
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x: R.Tensor((128, 128), "float32"),
+            weight1: R.Tensor((128, 128), "float32"),
+            weight2: R.Tensor((128, 128), "float32"),
+        ) -> R.Tensor((128, 128), "float32"):
+            lv0 = R.matmul(x, weight1)
+            lv0_sharded = R.dist.annotate_sharding(lv0, device_mesh="mesh[0]", placement="S[0]")
+            lv1 = R.nn.gelu(lv0_sharded)
+            lv2 = R.matmul(lv1, weight2)
+            return lv2
+
+    @I.ir_module
+    class Sharded:
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x: R.DTensor((128, 128), "float32", "mesh[0]", "S[0]"),
+            weight1: R.DTensor((128, 128), "float32", "mesh[0]", "R"),
+            weight2: R.DTensor((128, 128), "float32", "mesh[0]", "R"),
+        ) -> R.DTensor((128, 128), "float32", "mesh[0]", "S[0]"):
+            lv0: R.DTensor((128, 128), "float32", "mesh[0]", "S[0]") = R.matmul(
+                x, weight1, out_dtype="void"
+            )
+            lv1: R.DTensor((128, 128), "float32", "mesh[0]", "S[0]") = R.nn.gelu(lv0)
+            lv2: R.DTensor((128, 128), "float32", "mesh[0]", "S[0]") = R.matmul(
+                lv1, weight2, out_dtype="void"
+            )
+            return lv2
+
+    # Without memory pressure, splitting the rows needs no communication.
+    mesh = MLP.global_infos["mesh"][0]
+    after = relax.distributed.transform.AutoSharding(mesh)(MLP)
+    assert_structural_equal(after, Annotated)
+    after = relax.distributed.transform.PropagateSharding()(after)
+    assert_structural_equal(after, Sharded)
+
+
+def test_mlp_memory_limit():
+    @I.ir_module
+    class MLP:
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x: R.Tensor((16, 128), "float32"),
+            weight1: R.Tensor((128, 1024), "float32"),
+            weight2: R.Tensor((1024, 128), "float32"),
+        ) -> R.Tensor((16, 128), "float32"):
+            lv0 = R.matmul(x, weight1)
+            lv1 = R.nn.gelu(lv0)
+            lv2 = R.matmul(lv1, weight2)
+            return lv2
+
+    @I.ir_module
+    class Annotated:
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x: R.Tensor((16, 128), "float32"),
+            weight1: R.Tensor((128, 1024), "float32"),
+            weight2: R.Tensor((1024, 128), "float32"),
+        ) -> R.Tensor((16, 128), "float32"):
+            lv0 = R.matmul(x, weight1)
+            lv0_sharded = R.dist.annotate_sharding(lv0, device_mesh="mesh[0]", placement="S[1]")
+            lv1 = R.nn.gelu(lv0_sharded)
+            lv2 = R.matmul(lv1, weight2)
+            return lv2
+
+    # Replicated weights take 1MB per device, so the weights have to be split.
+    mesh = MLP.global_infos["mesh"][0]
+    after = relax.distributed.transform.AutoSharding(mesh, memory_limit=700 * 1024)(MLP)
+    assert_structural_equal(after, Annotated)
+
+
+def test_annotated_function_unchanged():
+    @I.ir_module
+    class MLP:
+        I.module_global_infos({"mesh": [R.device_mesh((2,), I.Range(0, 2))]})
+
+        @R.function
+        def foo(
+            x: R.Tensor((128, 128), "float32"),
+            weight1: R.Tensor((128, 128), "float32"),
+        ) -> R.Tensor((128, 128), "float32"):
+            lv0 = R.dist.annotate_sharding(x, device_mesh="mesh[0]", placement="R")
+            lv1 = R.matmul(lv0, weight1)
+            return lv1
+
+    mesh = MLP.global_infos["mesh"][0]
+    after = relax.distributed.transform.AutoSharding(mesh)(MLP)
+    assert_structural_equal(after, MLP)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -176,6 +176,11 @@ def test_extracting_tasks():
             module_equality=module_equality,
         )
         assert len(extracted_tasks) == count
+        # Each of the three called functions is dispatched from exactly one task
+        assert sum(len(task.dispatched) for task in extracted_tasks) == 3
+        assert sum(task.weight for task in extracted_tasks) == 3
+        for task in extracted_tasks:
+            tvm.ir.assert_structural_equal(task.mod, task.dispatched[0])
 
 
 @pytest.mark.parametrize("module_equality", ["structural", "ignore-ndarray", "anchor-block"])
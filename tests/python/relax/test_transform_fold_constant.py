@@ -440,5 +440,115 @@ def test_fold_shape_computation():
     tvm.ir.assert_structural_equal(after, expected)
 
 
+@tvm.ir.instrument.pass_instrument
+class _CountPrimFuncBuilds:
+    """Count the PrimFunc builds, each of which runs MakePackedAPI once"""
+
+    def __init__(self):
+        self.num_builds = 0
+
+    def run_before_pass(self, mod, info):
+        if info.name == "tir.MakePackedAPI":
+            self.num_builds += 1
+
+
+@tvm.script.ir_module
+class _TwoPrimFuncModule:
+    @T.prim_func
+    def addone(A: T.Buffer((4, 4), "float32"), B: T.Buffer((4, 4), "float32")) -> None:
+        for i, j in T.grid(4, 4):
+            with T.block("addone"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                B[vi, vj] = A[vi, vj] + T.float32(1)
+
+    @T.prim_func
+    def transpose(A: T.Buffer((4, 4), "float32"), B: T.Buffer((4, 4), "float32")) -> None:
+        for i, j in T.grid(4, 4):
+            with T.block("transpose"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                B[vi, vj] = A[vj, vi]
+
+    @R.function
+    def before(c0: R.Tensor((4, 4), "float32")):
+        cls = _TwoPrimFuncModule
+        lv0 = relax.call_tir(cls.addone, (c0,), R.Tensor((4, 4), dtype="float32"))
+        lv1 = relax.call_tir(cls.transpose, (lv0,), R.Tensor((4, 4), dtype="float32"))
+        return lv1
+
+    @R.function
+    def expected(c1: R.Tensor((4, 4), "float32"), c2: R.Tensor((4, 4), "float32")):
+        return c2
+
+
+def _two_prim_func_before_expected():
+    c0_np = np.arange(4 * 4).astype("float32").reshape(4, 4)
+    c1_np = c0_np + 1
+    c2_np = c1_np.T
+    before = gen_mod(_TwoPrimFuncModule, "before", {"c0": c0_np})
+    expected = gen_mod(_TwoPrimFuncModule, "expected", {"c1": c1_np, "c2": c2_np})
+    return before, expected
+
+
+def test_batch_build_fold():
+    before, expected = _two_prim_func_before_expected()
+
+    relax.transform.FoldConstantClearCache()
+    with tvm.transform.PassContext(config={"relax.fold_constant_batch_build": True}):
+        after = relax.transform.FoldConstant()(before)
+        tvm.ir.assert_structural_equal(after, expected)
+
+        # The builds are cached across invocations of the pass.
+        after = relax.transform.FoldConstant()(before)
+        tvm.ir.assert_structural_equal(after, expected)
+
+    # Without a cache, each PrimFunc is built on its own.
+    with tvm.transform.PassContext(config={"relax.fold_constant_build_cache_size": 0}):
+        after = relax.transform.FoldConstant()(before)
+    tvm.ir.assert_structural_equal(after, expected)
+
+
+def test_build_cache_hit():
+    before, expected = _two_prim_func_before_expected()
+    relax.transform.FoldConstantClearCache()
+
+    counter = _CountPrimFuncBuilds()
+    with tvm.transform.PassContext(instruments=[counter]):
+        after = relax.transform.FoldConstant()(before)
+    tvm.ir.assert_structural_equal(after, expected)
+    assert counter.num_builds == 2
+
+    # Both PrimFuncs are found in the cache.
+    counter = _CountPrimFuncBuilds()
+    with tvm.transform.PassContext(instruments=[counter]):
+        after = relax.transform.FoldConstant()(before)
+    tvm.ir.assert_structural_equal(after, expected)
+    assert counter.num_builds == 0
+
+    # A "tir." option may change how the PrimFuncs are lowered, so they are built again.
+    counter = _CountPrimFuncBuilds()
+    with tvm.transform.PassContext(instruments=[counter], config={"tir.disable_vectorize": True}):
+        after = relax.transform.FoldConstant()(before)
+    tvm.ir.assert_structural_equal(after, expected)
+    assert counter.num_builds == 2
+
+
+def test_build_cache_unhashable_config():
+    before, expected = _two_prim_func_before_expected()
+    relax.transform.FoldConstantClearCache()
+
+    # The added lower passes cannot be hashed, so the builds are not cached.
+    config = {"tir.add_lower_pass": [[1, tvm.tir.transform.Simplify()]]}
+    for _ in range(2):
+        counter = _CountPrimFuncBuilds()
+        with tvm.transform.PassContext(instruments=[counter], config=config):
+            after = relax.transform.FoldConstant()(before)
+        tvm.ir.assert_structural_equal(after, expected)
+        assert counter.num_builds == 2
+
+    with tvm.transform.PassContext(config={**config, "relax.fold_constant_batch_build": True}):
+        after = relax.transform.FoldConstant()(before)
+    tvm.ir.assert_structural_equal(after, expected)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
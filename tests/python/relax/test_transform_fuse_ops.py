@@ -17,7 +17,7 @@
 
 import tvm
 import tvm.testing
-from tvm import relax, topi
+from tvm import relax, te, topi
 from tvm.script import ir as I, relax as R, tir as T
 
 
@@ -1694,5 +1694,48 @@ def test_packed_params():
     _check(Before, Expected)
 
 
+def test_fuse_cost_model():
+    """The cost model keeps an expensive elementwise op out of a full reduction."""
+
+    def elemwise_then_sum(num_mul):
+        def poly(x):
+            def compute(i):
+                y = x[i]
+                for _ in range(num_mul):
+                    y = y * x[i]
+                return y
+
+            return te.compute(x.shape, compute, name="poly")
+
+        bb = relax.BlockBuilder()
+        x = relax.Var("x", R.Tensor([1048576], "float32"))
+        with bb.function("main", [x]):
+            with bb.dataflow():
+                lv0 = bb.emit_te(poly, x)
+                gv = bb.emit_output(bb.call_te(topi.sum, lv0))
+            bb.emit_func_output(gv)
+        return relax.transform.AnnotateTIROpPattern()(bb.get())
+
+    def num_fused(mod):
+        return sum(
+            1
+            for func in mod.functions.values()
+            if isinstance(func, relax.Function)
+            and func.attrs is not None
+            and "Primitive" in func.attrs.keys()
+        )
+
+    heavy = elemwise_then_sum(num_mul=15)
+    cheap = elemwise_then_sum(num_mul=1)
+    assert num_fused(relax.transform.FuseOps()(heavy)) == 1
+    with tvm.target.Target("llvm -num-cores=16"), tvm.transform.PassContext(
+        config={"relax.FuseOps.cost_model": True}
+    ):
+        # Fused into the reduction, the elementwise op would only be parallel over one output.
+        tvm.ir.assert_structural_equal(relax.transform.FuseOps()(heavy), heavy)
+        # Memory-bound ops are still fused.
+        assert num_fused(relax.transform.FuseOps()(cheap)) == 1
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -751,5 +751,89 @@ def test_checkpoint_with_intermediate_require_grads():
     assert_structural_equal(After, Expected)
 
 
+def _auto_checkpoint_module():
+    @I.ir_module
+    class Module:
+        @R.function
+        def main(x: R.Tensor((3, 3), "float32")):
+            with R.dataflow():
+                lv1 = R.power(x, R.const(3, "float32"))
+                lv2 = R.power(lv1, R.const(3, "float32"))
+                lv3 = R.power(lv2, R.const(3, "float32"))
+                lv4 = R.power(lv3, R.const(3, "float32"))
+                gv = R.sum(lv4)
+                R.output(gv)
+            return gv
+
+    return Module
+
+
+def test_auto_checkpoint():
+    # lv1, lv2 and lv3 are used by the backward pass, each taking 36 bytes. Dropping lv1
+    # and lv2 leaves 36 bytes, as recomputing them only needs x.
+    # fmt: off
+    @I.ir_module
+    class Expected:
+        @R.function
+        def main(x: R.Tensor((3, 3), "float32")) -> R.Tensor((), "float32"):
+            with R.dataflow():
+                x_s: R.Tensor((3, 3), "float32") = R.grad.start_checkpoint(x)
+                lv1: R.Tensor((3, 3), "float32") = R.power(x_s, R.const(3, "float32"))
+                lv2: R.Tensor((3, 3), "float32") = R.power(lv1, R.const(3, "float32"))
+                lv2_e: R.Tensor((3, 3), "float32") = R.grad.end_checkpoint(lv2)
+                lv3: R.Tensor((3, 3), "float32") = R.power(lv2_e, R.const(3, "float32"))
+                lv4: R.Tensor((3, 3), "float32") = R.power(lv3, R.const(3, "float32"))
+                gv: R.Tensor((), "float32") = R.sum(lv4, axis=None, keepdims=False)
+                R.output(gv)
+            return gv
+    # fmt: on
+
+    After = relax.transform.AutoCheckpoint("main", memory_budget=40)(_auto_checkpoint_module())
+    assert_structural_equal(After, Expected)
+
+    adjoint = relax.transform.Gradient("main")(After)["main_adjoint"]
+    names = {binding.var.name_hint for binding in adjoint.body.blocks[0].bindings}
+    assert {"lv1_cp", "lv2_cp"} <= names
+    assert "lv3_cp" not in names
+
+
+def test_auto_checkpoint_within_budget():
+    Before = _auto_checkpoint_module()
+    After = relax.transform.AutoCheckpoint("main", memory_budget=108)(Before)
+    assert_structural_equal(After, Before)
+
+
+def _planned_storage_bytes(mod, func_name):
+    """Plan the memory of a function and return the total bytes of its storage allocations"""
+    mod = tvm.transform.Sequential(
+        [
+            relax.transform.LegalizeOps(),
+            relax.transform.ToNonDataflow(),
+            relax.transform.RemovePurityChecking(),
+            relax.transform.CallTIRRewrite(),
+            relax.transform.StaticPlanBlockMemory(),
+        ]
+    )(mod)
+    alloc_storage = tvm.ir.Op.get("relax.memory.alloc_storage")
+    sizes = []
+
+    def fvisit(expr):
+        if isinstance(expr, relax.Call) and expr.op.same_as(alloc_storage):
+            sizes.append(int(expr.args[0].values[0]))
+
+    relax.analysis.post_order_visit(mod[func_name], fvisit)
+    return sum(sizes)
+
+
+def test_auto_checkpoint_planned_storage():
+    # lv1 no longer lives until the backward pass, which recomputes it once lv3 and lv4 are dead.
+    Before = relax.transform.Gradient("main")(_auto_checkpoint_module())
+    After = relax.transform.AutoCheckpoint("main", memory_budget=40)(_auto_checkpoint_module())
+    After = relax.transform.Gradient("main")(After)
+    assert _planned_storage_bytes(After, "main_adjoint") < _planned_storage_bytes(
+        Before, "main_adjoint"
+    )
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -0,0 +1,139 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import meta_schedule as ms
+from tvm import relax, tir, topi
+from tvm.script import relax as R
+
+
+def _get_module(shape):
+    bb = relax.BlockBuilder()
+    x = relax.Var("x", R.Tensor(shape, "float32"))
+    y = relax.Var("y", R.Tensor(shape, "float32"))
+    with bb.function("main", [x, y]):
+        with bb.dataflow():
+            lv0 = bb.emit_te(topi.exp, x)
+            lv1 = bb.emit_te(topi.exp, y)
+            lv2 = bb.emit_te(topi.sum, y)
+            lv3 = bb.emit_te(topi.add, lv0, lv1)
+            gv = bb.emit_output(bb.call_te(topi.multiply, lv3, lv2))
+        bb.emit_func_output(gv)
+    return bb.get()
+
+
+def _count_call_tir(mod):
+    num_calls = 0
+
+    def fvisit(expr):
+        nonlocal num_calls
+        if isinstance(expr, relax.Call) and expr.op == tvm.ir.Op.get("relax.call_tir"):
+            num_calls += 1
+
+    relax.analysis.post_order_visit(mod["main"], fvisit)
+    return num_calls
+
+
+def _run(mod, inputs):
+    with tvm.target.Target("llvm"):
+        mod = relax.transform.HorizontalFuseTIR()(mod)
+    mod = relax.transform.DeadCodeElimination()(mod)
+    exe = tvm.compile(mod, target="llvm")
+    vm = relax.VirtualMachine(exe, tvm.cpu())
+    return mod, vm["main"](*[tvm.nd.array(data) for data in inputs]).numpy()
+
+
+def test_fuse_independent_kernels():
+    shape = (4, 8)
+    mod = _get_module(shape)
+    inputs = [np.random.rand(*shape).astype("float32") for _ in range(2)]
+    expected = (np.exp(inputs[0]) + np.exp(inputs[1])) * np.sum(inputs[1])
+
+    fused_mod, result = _run(mod, inputs)
+    # The two exp and the sum are packed, and the add and the multiply depend on them.
+    assert _count_call_tir(mod) == 5
+    assert _count_call_tir(fused_mod) == 3
+    fused_names = [gv.name_hint for gv in fused_mod.get_global_vars()]
+    assert len([name for name in fused_names if name.startswith("fused_horizontal")]) == 1
+    tvm.testing.assert_allclose(result, expected, rtol=1e-5, atol=1e-5)
+
+
+def test_schedule_fused_kernel():
+    shape = (4, 8)
+    with tvm.target.Target("llvm"):
+        mod = relax.transform.HorizontalFuseTIR()(_get_module(shape))
+    (fused_gv,) = [gv for gv in mod.get_global_vars() if gv.name_hint.startswith("fused")]
+    func = mod[fused_gv]
+
+    # The two exp kernels share a PrimFunc, yet their blocks get distinct names, and the root
+    # blocks of the kernels are merged into the root block of the fused kernel.
+    block_names = []
+    tir.stmt_functor.post_order_visit(
+        func.body,
+        lambda stmt: block_names.append(stmt.name_hint) if isinstance(stmt, tir.Block) else None,
+    )
+    assert len(block_names) == len(set(block_names))
+    assert block_names.count("root") == 1
+
+    # The design spaces of MetaSchedule can be applied to the fused kernel.
+    context = ms.TuneContext(
+        mod=func,
+        target=tvm.target.Target("llvm -num-cores=4"),
+        space_generator="post-order-apply",
+        task_name="fused_horizontal",
+    )
+    spaces = context.generate_design_space()
+    assert len(spaces) > 0
+    for space in spaces:
+        space.trace.apply_to_schedule(tir.Schedule(func), remove_postproc=True)
+
+    sch = tir.Schedule(tvm.IRModule({fused_gv: func}))
+    sch.work_on(fused_gv.name_hint)
+    for name in block_names:
+        if name == "root":
+            continue
+        loops = sch.get_loops(sch.get_block(name))
+        sch.split(loops[-1], factors=[None, 2])
+    mod[fused_gv] = sch.mod[fused_gv]
+    mod = relax.transform.DeadCodeElimination()(mod)
+    vm = relax.VirtualMachine(tvm.compile(mod, target="llvm"), tvm.cpu())
+    inputs = [np.random.rand(*shape).astype("float32") for _ in range(2)]
+    expected = (np.exp(inputs[0]) + np.exp(inputs[1])) * np.sum(inputs[1])
+    result = vm["main"](*[tvm.nd.array(data) for data in inputs]).numpy()
+    tvm.testing.assert_allclose(result, expected, rtol=1e-5, atol=1e-5)
+
+
+def test_skip_large_kernels():
+    mod = _get_module((4, 8))
+    with tvm.target.Target("llvm"):
+        after = relax.transform.HorizontalFuseTIR(max_num_elements=16)(mod)
+    # Only the sum of a single element remains small enough, and it has no partner.
+    tvm.ir.assert_structural_equal(after, mod)
+
+
+def test_skip_gpu_target():
+    mod = _get_module((4, 8))
+    with tvm.target.Target("cuda"):
+        after = relax.transform.HorizontalFuseTIR()(mod)
+    tvm.ir.assert_structural_equal(after, mod)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
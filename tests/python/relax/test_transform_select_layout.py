@@ -0,0 +1,110 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import tvm
+import tvm.testing
+from tvm import meta_schedule as ms
+from tvm import relax, tir
+from tvm.relax.transform import ConvertLayout, Normalize, SelectLayout
+from tvm.script.parser import ir as I, relax as R
+
+target = tvm.target.Target("llvm")
+candidate_layouts = {"relax.nn.conv2d": [["NHWC", "OHWI"]]}
+
+
+@I.ir_module
+class Input:
+    @R.function
+    def main(
+        x: R.Tensor((2, 16, 28, 28), "float32"),
+        w1: R.Tensor((16, 16, 3, 3), "float32"),
+        w2: R.Tensor((16, 16, 3, 3), "float32"),
+    ) -> R.Tensor((2, 16, 28, 28), "float32"):
+        with R.dataflow():
+            lv: R.Tensor((2, 16, 28, 28), "float32") = R.nn.conv2d(
+                x, w1, padding=[1, 1], out_dtype="float32"
+            )
+            lv1: R.Tensor((2, 16, 28, 28), "float32") = R.nn.relu(lv)
+            gv: R.Tensor((2, 16, 28, 28), "float32") = R.nn.conv2d(
+                lv1, w2, padding=[1, 1], out_dtype="float32"
+            )
+            R.output(gv)
+        return gv
+
+
+def _conv2d_workload(data_layout, kernel_layout):
+    bb = relax.BlockBuilder()
+    data_shape = [2, 16, 28, 28] if data_layout == "NCHW" else [2, 28, 28, 16]
+    weight_shape = [16, 16, 3, 3]
+    x = relax.Var("x", R.Tensor(data_shape, "float32"))
+    w = relax.Var("w", R.Tensor(weight_shape, "float32"))
+    with bb.function("main", [x, w]):
+        gv = bb.emit(
+            relax.op.nn.conv2d(
+                x,
+                w,
+                padding=[1, 1],
+                data_layout=data_layout,
+                kernel_layout=kernel_layout,
+                out_dtype="float32",
+            )
+        )
+        bb.emit_func_output(gv)
+    mod = relax.transform.LegalizeOps()(bb.get())
+    (prim_func,) = [func for func in mod.functions.values() if isinstance(func, tir.PrimFunc)]
+    return ms.tune_context._normalize_mod(prim_func)
+
+
+def _database(secs_per_layout):
+    db = ms.database.MemoryDatabase()
+    for (data_layout, kernel_layout), secs in secs_per_layout.items():
+        mod = _conv2d_workload(data_layout, kernel_layout)
+        workload = db.commit_workload(mod)
+        db.commit_tuning_record(
+            ms.database.TuningRecord(tir.Schedule(mod).trace, workload, [secs], target)
+        )
+    return db
+
+
+def test_keep_original_layout_without_records():
+    # Without tuning records, the kernels of both layouts are estimated to take the same
+    # time, so the layout transforms make the conversion unprofitable.
+    mod = SelectLayout(candidate_layouts)(Input)
+    mod = Normalize()(mod)
+    tvm.ir.assert_structural_equal(mod, Input)
+
+
+def test_select_tuned_layout():
+    db = _database({("NCHW", "OIHW"): 1.0, ("NHWC", "OHWI"): 1e-6})
+    with db, target:
+        mod = SelectLayout(candidate_layouts)(Input)
+    mod = Normalize()(mod)
+    # Both convolutions are converted, with no transform in between.
+    expected = Normalize()(ConvertLayout({"relax.nn.conv2d": ["NHWC", "OHWI"]})(Input))
+    tvm.ir.assert_structural_equal(mod, expected)
+
+
+def test_keep_original_layout_with_slower_records():
+    db = _database({("NCHW", "OIHW"): 1e-6, ("NHWC", "OHWI"): 1.0})
+    with db, target:
+        mod = SelectLayout(candidate_layouts)(Input)
+    mod = Normalize()(mod)
+    tvm.ir.assert_structural_equal(mod, Input)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -1545,5 +1545,98 @@ def test_with_dataflow():
     tvm.ir.assert_structural_equal(after, Expected)
 
 
+def test_arena_planning():
+    # fmt: off
+    @I.ir_module
+    class Module:
+        @T.prim_func
+        def exp(A: T.Buffer((T.int64(32),), "float32"), B: T.Buffer((T.int64(32),), "float32")):
+            T.evaluate(0)
+
+        @T.prim_func
+        def cast(A: T.Buffer((T.int64(32),), "float32"), B: T.Buffer((T.int64(32),), "float16")):
+            T.evaluate(0)
+
+        @T.prim_func
+        def tile(A: T.Buffer((T.int64(32),), "float16"), B: T.Buffer((T.int64(64),), "float16")):
+            T.evaluate(0)
+
+        @T.prim_func
+        def reduce(A: T.Buffer((T.int64(64),), "float16"), B: T.Buffer((T.int64(32),), "float32")):
+            T.evaluate(0)
+
+        @T.prim_func
+        def log(A: T.Buffer((T.int64(32),), "float32"), B: T.Buffer((T.int64(32),), "float32")):
+            T.evaluate(0)
+
+        @R.function
+        def main(x: R.Tensor((32,), dtype="float32")) -> R.Tensor((32,), dtype="float32"):
+            R.func_attr({"relax.force_pure": True})
+            cls = Module
+            alloc: R.Tensor((32,), dtype="float32") = R.builtin.alloc_tensor(R.shape([32]), dtype="float32", runtime_device_index=0)
+            _: R.Tuple() = cls.exp(x, alloc)
+            alloc1: R.Tensor((32,), dtype="float16") = R.builtin.alloc_tensor(R.shape([32]), dtype="float16", runtime_device_index=0)
+            _1: R.Tuple() = cls.cast(alloc, alloc1)
+            alloc2: R.Tensor((64,), dtype="float16") = R.builtin.alloc_tensor(R.shape([64]), dtype="float16", runtime_device_index=0)
+            _2: R.Tuple() = cls.tile(alloc1, alloc2)
+            alloc3: R.Tensor((32,), dtype="float32") = R.builtin.alloc_tensor(R.shape([32]), dtype="float32", runtime_device_index=0)
+            _3: R.Tuple() = cls.reduce(alloc2, alloc3)
+            alloc4: R.Tensor((32,), dtype="float32") = R.builtin.alloc_tensor(R.shape([32]), dtype="float32", runtime_device_index=0)
+            _4: R.Tuple() = cls.log(alloc3, alloc4)
+            return alloc4
+
+    @I.ir_module
+    class Expected:
+        @T.prim_func
+        def exp(A: T.Buffer((T.int64(32),), "float32"), B: T.Buffer((T.int64(32),), "float32")):
+            T.evaluate(0)
+
+        @T.prim_func
+        def cast(A: T.Buffer((T.int64(32),), "float32"), B: T.Buffer((T.int64(32),), "float16")):
+            T.evaluate(0)
+
+        @T.prim_func
+        def tile(A: T.Buffer((T.int64(32),), "float16"), B: T.Buffer((T.int64(64),), "float16")):
+            T.evaluate(0)
+
+        @T.prim_func
+        def reduce(A: T.Buffer((T.int64(64),), "float16"), B: T.Buffer((T.int64(32),), "float32")):
+            T.evaluate(0)
+
+        @T.prim_func
+        def log(A: T.Buffer((T.int64(32),), "float32"), B: T.Buffer((T.int64(32),), "float32")):
+            T.evaluate(0)
+
+        @R.function
+        def main(x: R.Tensor((32,), dtype="float32")) -> R.Tensor((32,), dtype="float32"):
+            R.func_attr({"relax.force_pure": True})
+            cls = Expected
+            storage: R.Object = R.memory.alloc_storage(R.shape([256]), virtual_device_index=0, storage_scope="global", dtype="uint8")
+            alloc: R.Tensor((32,), dtype="float32") = R.memory.alloc_tensor(storage, 0, R.shape([32]), dtype="float32")
+            _: R.Tuple() = cls.exp(x, alloc)
+            alloc1: R.Tensor((32,), dtype="float16") = R.memory.alloc_tensor(storage, 128, R.shape([32]), dtype="float16")
+            _1: R.Tuple() = cls.cast(alloc, alloc1)
+            alloc2: R.Tensor((64,), dtype="float16") = R.memory.alloc_tensor(storage, 0, R.shape([64]), dtype="float16")
+            _2: R.Tuple() = cls.tile(alloc1, alloc2)
+            alloc3: R.Tensor((32,), dtype="float32") = R.memory.alloc_tensor(storage, 128, R.shape([32]), dtype="float32")
+            _3: R.Tuple() = cls.reduce(alloc2, alloc3)
+            alloc4: R.Tensor((32,), dtype="float32") = R.builtin.alloc_tensor(R.shape([32]), dtype="float32", runtime_device_index=0)
+            _4: R.Tuple() = cls.log(alloc3, alloc4)
+            return alloc4
+    # fmt: on
+
+    with tvm.transform.PassContext(config={"relax.memory_plan_arena": True}):
+        mod = relax.transform.StaticPlanBlockMemory()(Module)
+
+    # Token reuse cannot share storage across dtypes, so it needs 128 + 64 + 128 bytes.
+    main = mod["main"]
+    assert int(main.attrs["relax.memory_plan_token_bytes"]) == 320
+    assert int(main.attrs["relax.memory_plan_arena_bytes"]) == 256
+    main = main.without_attr("relax.memory_plan_token_bytes")
+    main = main.without_attr("relax.memory_plan_arena_bytes")
+    mod["main"] = main
+    tvm.ir.assert_structural_equal(mod, Expected)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
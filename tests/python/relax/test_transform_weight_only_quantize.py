@@ -0,0 +1,159 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name,missing-docstring
+import numpy as np
+import pytest
+
+import tvm
+import tvm.testing
+from tvm import relax
+from tvm.script import ir as I
+from tvm.script import relax as R
+
+
+def _quantize_ref(w_nk: np.ndarray, bits: int, group_size: int) -> np.ndarray:
+    """Quantize and decode the weight of shape (N, K) with numpy."""
+    n, k = w_nk.shape
+    max_int = 2 ** (bits - 1) - 1
+    groups = w_nk.reshape(n, k // group_size, group_size)
+    max_abs_value = np.abs(groups).max(axis=-1, keepdims=True)
+    scale = np.where(max_abs_value > 0, max_abs_value / np.float32(max_int), np.float32(1))
+    scale = scale.astype(w_nk.dtype)
+    quantized = np.clip(np.round(groups / scale), -max_int - 1, max_int)
+    return (quantized * scale).reshape(n, k).astype(w_nk.dtype)
+
+
+def _run(mod, *args):
+    ex = tvm.compile(mod, target="llvm")
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    return vm["main"](*[tvm.nd.array(arg) for arg in args]).numpy()
+
+
+@pytest.mark.parametrize("bits", [4, 8])
+def test_constant_weight(bits):
+    x_np = np.random.uniform(-1, 1, size=(1, 128)).astype("float32")
+    w_np = np.random.uniform(-1, 1, size=(128, 64)).astype("float32")
+
+    bb = relax.BlockBuilder()
+    x = relax.Var("x", R.Tensor((1, 128), "float32"))
+    with bb.function("main", [x]):
+        with bb.dataflow():
+            out = bb.emit_output(relax.op.matmul(x, relax.const(w_np)))
+        bb.emit_func_output(out)
+    mod = bb.get()
+
+    after = relax.transform.WeightOnlyQuantize(bits=bits, group_size=32)(mod)
+    assert "decode_int%d_NT_matmul" % bits in [gv.name_hint for gv in after.get_global_vars()]
+    after = relax.transform.DeadCodeElimination()(relax.transform.FoldConstant()(after))
+    # The weight is packed into uint32 at compile time.
+    constants = set()
+    relax.analysis.post_order_visit(
+        after["main"],
+        lambda e: (
+            constants.add((e.struct_info.dtype, tuple(int(v) for v in e.struct_info.shape)))
+            if isinstance(e, relax.Constant)
+            else None
+        ),
+    )
+    assert constants == {("uint32", (64, 128 * bits // 32)), ("float32", (64, 4))}
+
+    expected = x_np @ _quantize_ref(w_np.T, bits, 32).T
+    tvm.testing.assert_allclose(_run(after, x_np), expected, rtol=1e-5, atol=1e-5)
+
+
+def test_transposed_param_weight():
+    @I.ir_module
+    class Module:
+        @R.function
+        def main(
+            x: R.Tensor((1, 64), "float32"), w: R.Tensor((96, 64), "float32")
+        ) -> R.Tensor((1, 96), "float32"):
+            R.func_attr({"num_input": 1})
+            with R.dataflow():
+                wT = R.permute_dims(w)
+                out = R.matmul(x, wT)
+                R.output(out)
+            return out
+
+    x_np = np.random.uniform(-1, 1, size=(1, 64)).astype("float32")
+    w_np = np.random.uniform(-1, 1, size=(96, 64)).astype("float32")
+
+    after = relax.transform.WeightOnlyQuantize(bits=4, group_size=16)(Module)
+    after = relax.transform.DeadCodeElimination()(after)
+    expected = x_np @ _quantize_ref(w_np, 4, 16).T
+    tvm.testing.assert_allclose(_run(after, x_np, w_np), expected, rtol=1e-5, atol=1e-5)
+
+    # The encoding only depends on the weight, so it moves out of the inference function.
+    lifted = relax.transform.LiftTransformParams()(after)
+    param_sinfo = [(p.struct_info.dtype, p.struct_info.ndim) for p in lifted["main"].params]
+    assert sorted(param_sinfo[1:]) == [("float32", 2), ("uint32", 2)]
+
+
+def test_shared_weight_encoded_once():
+    @I.ir_module
+    class Module:
+        @R.function
+        def main(
+            x: R.Tensor((1, 64), "float32"),
+            y: R.Tensor((1, 64), "float32"),
+            w: R.Tensor((64, 32), "float32"),
+        ) -> R.Tensor((1, 32), "float32"):
+            R.func_attr({"num_input": 2})
+            with R.dataflow():
+                lv0 = R.matmul(x, w)
+                lv1 = R.matmul(y, w)
+                out = R.add(lv0, lv1)
+                R.output(out)
+            return out
+
+    after = relax.transform.WeightOnlyQuantize(bits=4, group_size=32)(Module)
+    num_encode = 0
+
+    def visit(expr):
+        nonlocal num_encode
+        if isinstance(expr, relax.Call) and expr.op == tvm.ir.Op.get("relax.call_tir"):
+            num_encode += expr.args[0].name_hint == "encode_int4"
+
+    relax.analysis.post_order_visit(after["main"], visit)
+    assert num_encode == 1
+
+    x_np = np.random.uniform(-1, 1, size=(1, 64)).astype("float32")
+    y_np = np.random.uniform(-1, 1, size=(1, 64)).astype("float32")
+    w_np = np.random.uniform(-1, 1, size=(64, 32)).astype("float32")
+    w_ref = _quantize_ref(w_np.T, 4, 32)
+    expected = x_np @ w_ref.T + y_np @ w_ref.T
+    tvm.testing.assert_allclose(_run(after, x_np, y_np, w_np), expected, rtol=1e-5, atol=1e-5)
+
+
+def test_input_not_quantized():
+    @I.ir_module
+    class Module:
+        @R.function
+        def main(
+            x: R.Tensor((1, 64), "float32"), y: R.Tensor((64, 32), "float32")
+        ) -> R.Tensor((1, 32), "float32"):
+            with R.dataflow():
+                out = R.matmul(x, y)
+                R.output(out)
+            return out
+
+    after = relax.transform.WeightOnlyQuantize()(Module)
+    tvm.ir.assert_structural_equal(after, Module)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
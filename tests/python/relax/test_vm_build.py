@@ -1310,5 +1310,61 @@ def test_relax_module_with_multiple_targets(exec_mode):
     tvm.testing.assert_allclose(cuda_output.numpy(), np_C)
 
 
+def test_vm_build_cache():
+    def get_module(activation):
+        bb = relax.BlockBuilder()
+        x = relax.Var("x", R.Tensor((3, 4), "float32"))
+        y = relax.Var("y", R.Tensor((3, 4), "float32"))
+        with bb.function("main", [x, y]):
+            with bb.dataflow():
+                lv0 = bb.emit_te(topi.add, x, y)
+                lv1 = bb.emit_te(activation, lv0)
+                gv = bb.emit_output(bb.call_te(topi.multiply, lv1, y))
+            bb.emit_func_output(gv)
+        return bb.get()
+
+    def check(ex, activation):
+        inp1 = np.random.rand(3, 4).astype(np.float32)
+        inp2 = np.random.rand(3, 4).astype(np.float32)
+        with utils.tempdir() as temp:
+            ex.export_library(temp.relpath("exec.so"))
+            vm = relax.VirtualMachine(tvm.runtime.load_module(temp.relpath("exec.so")), tvm.cpu())
+        res = vm["main"](tvm.nd.array(inp1), tvm.nd.array(inp2))
+        tvm.testing.assert_allclose(res.numpy(), activation(inp1 + inp2) * inp2, rtol=1e-6)
+
+    target = tvm.target.Target("llvm", host="llvm")
+    cache = relax.FunctionBuildCache()
+    check(relax.build(get_module(topi.exp), target, build_cache=cache), np.exp)
+    assert (cache.num_hits, cache.num_misses) == (0, 3)
+    assert len(cache) == 3
+
+    # Rebuilding the same module compiles nothing.
+    check(relax.build(get_module(topi.exp), target, build_cache=cache), np.exp)
+    assert (cache.num_hits, cache.num_misses) == (3, 3)
+
+    # Changing one kernel only compiles the changed one.
+    check(relax.build(get_module(topi.tanh), target, build_cache=cache), np.tanh)
+    assert (cache.num_hits, cache.num_misses) == (5, 4)
+    assert len(cache) == 4
+
+    # The functions compiled with another TIR pipeline setting are not reused.
+    relax.build(get_module(topi.exp), target, tir_pipeline=None, build_cache=cache)
+    assert (cache.num_hits, cache.num_misses) == (5, 7)
+
+    # Neither are the functions compiled with other TIR options.
+    with tvm.transform.PassContext(config={"tir.disable_vectorize": True}):
+        check(relax.build(get_module(topi.exp), target, build_cache=cache), np.exp)
+        assert (cache.num_hits, cache.num_misses) == (5, 10)
+        check(relax.build(get_module(topi.exp), target, build_cache=cache), np.exp)
+        assert (cache.num_hits, cache.num_misses) == (8, 10)
+
+    # The added lower passes cannot be compared, so the cache is skipped.
+    with tvm.transform.PassContext(
+        config={"tir.add_lower_pass": [[1, tvm.tir.transform.Simplify()]]}
+    ):
+        check(relax.build(get_module(topi.exp), target, build_cache=cache), np.exp)
+    assert (cache.num_hits, cache.num_misses) == (8, 10)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
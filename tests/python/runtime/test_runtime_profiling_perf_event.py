@@ -0,0 +1,73 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import sys
+
+import numpy as np
+import pytest
+
+import tvm
+import tvm.testing
+from tvm import te
+from tvm.runtime import profiling
+
+requires_perf_event = pytest.mark.skipif(
+    not sys.platform.startswith("linux")
+    or tvm.get_global_func("runtime.profiling.PerfEventMetricCollector", allow_missing=True)
+    is None,
+    reason="perf_event collector is only built on Linux",
+)
+
+
+def _build_add():
+    A = te.placeholder((1024,), name="A")
+    B = te.compute(A.shape, lambda i: A[i] + 1.0, name="B")
+    return tvm.tir.build(te.create_prim_func([A, B]), target="llvm")
+
+
+@requires_perf_event
+@tvm.testing.requires_llvm
+def test_perf_event_collector():
+    func = _build_add()
+    dev = tvm.cpu()
+    a = tvm.nd.array(np.ones(1024, dtype="float32"), dev)
+    b = tvm.nd.empty((1024,), "float32", dev)
+
+    collector = profiling.PerfEventMetricCollector(["cycles", "instructions", "branch-misses"])
+    prof = profiling.profile_function(func, dev, [collector], warmup_iters=1)
+    counters = prof(a, b)
+    if "cycles" not in counters:
+        pytest.skip("perf_event_open is not permitted on this host")
+    for name in ["cycles", "instructions", "branch-misses", "IPC"]:
+        assert name in counters
+    assert isinstance(counters["instructions"], profiling.Count)
+    assert isinstance(counters["IPC"], profiling.Ratio)
+
+
+@requires_perf_event
+@tvm.testing.requires_llvm
+def test_perf_event_collector_unknown_counter():
+    func = _build_add()
+    collector = profiling.PerfEventMetricCollector(["not-a-counter"])
+    prof = profiling.profile_function(func, tvm.cpu(), [collector], warmup_iters=0)
+    a = tvm.nd.empty((1024,), "float32")
+    b = tvm.nd.empty((1024,), "float32")
+    with pytest.raises(tvm.TVMError):
+        prof(a, b)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -160,6 +160,20 @@ def test_rpc_large_array():
     check_remote()
 
 
+@tvm.testing.requires_rpc
+def test_rpc_pipelined_copy():
+    server = rpc.Server()
+    remote = rpc.connect("127.0.0.1", server.port)
+    dev = remote.cpu(0)
+    a_np = np.random.uniform(size=(1001, 257)).astype("float32")
+
+    # block sizes that do and do not divide the array size
+    for block_bytes, window in [(1 << 16, 4), (12345, 3), (1 << 22, 8), (4096, 1)]:
+        remote.set_copy_pipeline(block_bytes, window)
+        a = tvm.nd.array(a_np, dev)
+        np.testing.assert_equal(a.numpy(), a_np)
+
+
 @tvm.testing.skip_if_32bit(reason="skipping test for i386.")
 @tvm.testing.requires_rpc
 def test_rpc_echo():
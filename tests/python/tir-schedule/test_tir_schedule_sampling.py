@@ -240,5 +240,28 @@ def test_sample_perfect_tile_on_dynamic_loops():
     verify_trace_roundtrip(sch, mod=workload)
 
 
+def test_sample_perfect_tile_on_dynamic_loops_with_decision():
+    """The inner tiles of a decision, e.g. tuned for a static shape, are kept on dynamic loops"""
+
+    @T.prim_func
+    def workload(a: T.handle) -> None:
+        n = T.int32()
+        A = T.match_buffer(a, (n, 1024))
+        for i, j in T.grid(n, 1024):
+            with T.block("B"):
+                vi, vj = T.axis.remap("SS", [i, j])
+                A[vi, vj] = 1.0
+
+    sch = tir.Schedule(workload, debug_mask="all")
+    di, _ = sch.get_loops(sch.get_block("B"))
+    factors = sch.sample_perfect_tile(di, n=3, decision=[2, 4, 8])
+    assert factors[0] is None
+    assert [sch.get(i) for i in factors[1:]] == [4, 8]
+    decision = sch.trace.decisions[sch.trace.insts[-1]]
+    assert [int(x) for x in decision] == [-1, 4, 8]
+    sch.split(di, factors=factors)
+    verify_trace_roundtrip(sch, mod=workload)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
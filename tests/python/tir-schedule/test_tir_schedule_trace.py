@@ -233,6 +233,17 @@ def test_trace_apply_to_schedule():
     assert_structural_equal_ignore_global_symbol(elementwise_inlined, sch.mod["main"])
 
 
+def test_trace_apply_range_to_schedule():
+    sch = tir.Schedule(elementwise, debug_mask="all")
+    _make_trace_2(BlockRV()).apply_range_to_schedule(sch, 0, 1)
+    assert len(sch.trace.insts) == 1
+    # Resume on a copy with another trace of the same prefix, whose random variables differ
+    resumed = sch.copy()
+    _make_trace_2(BlockRV()).apply_range_to_schedule(resumed, 1, 2)
+    assert_structural_equal_ignore_global_symbol(elementwise_inlined, resumed.mod["main"])
+    assert_structural_equal_ignore_global_symbol(elementwise, sch.mod["main"])
+
+
 def test_trace_as_json_1():
     trace = _make_trace_1(BlockRV(), LoopRV(), LoopRV())
     obj = trace.as_json()
@@ -258,6 +258,42 @@ def test_tir_schedule_copy_2():
     verify_trace_roundtrip(sch_copy, mod=matmul)
 
 
+def test_tir_schedule_copy_on_write():
+    # Tests the lazily materialized copies, forked from a schedule or from another pending copy,
+    # while the schedule forked from is changed or released before the copies are accessed
+    sch = tir.Schedule(mod=matmul, debug_mask="all")
+    i, j, _ = sch.get_loops(sch.get_block("update"))
+    forks = [sch.copy() for _ in range(4)]
+    forks.append(forks[0].copy())
+    sch.split(i, factors=[None, 64])
+    forks.append(sch.copy())
+    del sch
+    factors = [2, 4, 8, 16, 32, 64]
+    outer_loops = [fork.split(j, factors=[None, f])[0] for f, fork in zip(factors, forks)]
+    for factor, fork, j_0 in zip(factors, forks, outer_loops):
+        assert fork.get(j_0).extent == 128 // factor
+        num_loops = 5 if fork is forks[-1] else 4
+        assert len(fork.get_loops(fork.get_block("update"))) == num_loops
+        verify_trace_roundtrip(fork, mod=matmul)
+
+
+def test_tir_schedule_copy_with_state_reference():
+    # Tests that a copy forked while the state is referenced elsewhere does not see the changes
+    # made through that reference afterwards
+    sch = tir.Schedule(mod=matmul, debug_mask="all")
+    i, _ = sch.get_loops(sch.get_block("init"))
+    loop = sch.get(i)
+    state = sch.state
+    sch_copy = sch.copy()
+    state.replace(
+        state.get_sref(loop),
+        tir.For(loop.loop_var, loop.min, loop.extent, tir.ForKind.UNROLLED, loop.body),
+    )
+    assert sch.get(i).kind == tir.ForKind.UNROLLED
+    assert sch_copy.get(i).kind == tir.ForKind.SERIAL
+    tvm.ir.assert_structural_equal(sch_copy.mod, tir.Schedule(mod=matmul).mod)
+
+
 def test_tir_schedule_remove_rv():
     # Tests:
     # - Schedule.remove_rv
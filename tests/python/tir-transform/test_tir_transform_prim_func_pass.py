@@ -14,9 +14,12 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import pytest
+
 import tvm
 import tvm.testing
 from tvm import te
+from tvm.script import tir as T
 
 
 def test_prim_func_pass():
@@ -63,6 +66,48 @@ def test_cow_pass():
     assert func_hash == mod["main"].__hash__()
 
 
+def _make_many_funcs_module(num_funcs):
+    funcs = {}
+    for i in range(num_funcs):
+
+        @T.prim_func
+        def func(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+            for j in range(16):
+                if j < 16:
+                    B[j] = A[j] * T.float32(2) + T.float32(0)
+
+        funcs[f"func_{i}"] = func.with_attr("global_symbol", f"func_{i}")
+    return tvm.IRModule(funcs)
+
+
+def test_parallel_prim_func_pass():
+    mod = _make_many_funcs_module(32)
+    seq = tvm.transform.Sequential([tvm.tir.transform.Simplify(), tvm.tir.transform.UnrollLoop()])
+
+    expected = seq(mod)
+    with tvm.transform.PassContext(config={"ir.num_function_pass_threads": 4}):
+        after = seq(mod)
+
+    tvm.ir.assert_structural_equal(after, expected)
+    assert [gv.name_hint for gv in after.get_global_vars()] == [
+        gv.name_hint for gv in expected.get_global_vars()
+    ]
+
+
+def test_parallel_prim_func_pass_error():
+    def fapply(f):
+        if f.attrs["global_symbol"] == "func_3":
+            raise ValueError(f.attrs["global_symbol"])
+        return f
+
+    mod = _make_many_funcs_module(8)
+    with tvm.transform.PassContext(config={"ir.num_function_pass_threads": 4}):
+        with pytest.raises(ValueError, match="func_3"):
+            tvm.tir.transform.Apply(fapply)(mod)
+
+
 if __name__ == "__main__":
     test_cow_pass()
     test_prim_func_pass()
+    test_parallel_prim_func_pass()
+    test_parallel_prim_func_pass_error()
@@ -16,6 +16,7 @@
 # under the License.
 import sys
 
+import numpy as np
 import pytest
 
 import tvm
@@ -614,5 +615,88 @@ class TestNoOrphanedDeclBuffer(BaseCompare):
             D[i] = C[i]
 
 
+class TestLinearReuse(BaseCompare):
+    """Y and Z are live together after X dies
+
+    The linear free-list scan reuses the space of X for Y only, and
+    needs a second allocation for Z.
+    """
+
+    def before(A: T.Buffer(1024, "float32"), D: T.Buffer(512, "float32")):
+        X_data = T.allocate([1024], "float32", "global")
+        X = T.Buffer(1024, data=X_data)
+        for i in range(1024):
+            X[i] = A[i] * T.float32(2)
+        for i in range(1024):
+            A[i] = X[i] + T.float32(1)
+        Y_data = T.allocate([512], "float32", "global")
+        Y = T.Buffer(512, data=Y_data)
+        for i in range(512):
+            Y[i] = A[i]
+        Z_data = T.allocate([512], "float32", "global")
+        Z = T.Buffer(512, data=Z_data)
+        for i in range(512):
+            Z[i] = A[i + 512]
+        for i in range(512):
+            D[i] = Y[i] - Z[i]
+
+    def expected(A: T.Buffer(1024, "float32"), D: T.Buffer(512, "float32")):
+        X_data = T.allocate([1024], "float32", "global")
+        Z_data = T.allocate([512], "float32", "global")
+        X = T.Buffer(1024, data=X_data)
+        for i in range(1024):
+            X[i] = A[i] * T.float32(2)
+        for i in range(1024):
+            A[i] = X[i] + T.float32(1)
+        Y = T.Buffer(512, data=X_data)
+        for i in range(512):
+            Y[i] = A[i]
+        Z = T.Buffer(512, data=Z_data)
+        for i in range(512):
+            Z[i] = A[i + 512]
+        for i in range(512):
+            D[i] = Y[i] - Z[i]
+
+
+class TestInterferencePlanning(TestLinearReuse):
+    """The interference-graph planner places both Y and Z into the space of X"""
+
+    def transform(self):
+        def inner(mod):
+            config = {"tir.storage_rewrite_interference_planning": True}
+            with tvm.transform.PassContext(config=config):
+                return tvm.tir.transform.StorageRewrite()(mod)
+
+        return inner
+
+    def expected(A: T.Buffer(1024, "float32"), D: T.Buffer(512, "float32")):
+        X_data = T.allocate([1024], "float32", "global")
+        X = T.Buffer(1024, data=X_data)
+        for i in range(1024):
+            X[i] = A[i] * T.float32(2)
+        for i in range(1024):
+            A[i] = X[i] + T.float32(1)
+        Y = T.Buffer(512, data=X_data)
+        for i in range(512):
+            Y[i] = A[i]
+        Z = T.Buffer(512, data=X_data)
+        for i in range(512):
+            Z[512 + i] = A[i + 512]
+        for i in range(512):
+            D[i] = Y[i] - Z[512 + i]
+
+    @tvm.testing.requires_llvm
+    def test_numeric(self, before):
+        with tvm.transform.PassContext(config={"tir.storage_rewrite_interference_planning": True}):
+            lib = tvm.compile(before.with_attr("global_symbol", "main"), target="llvm")
+
+        a_np = np.random.uniform(size=(1024,)).astype("float32")
+        a = tvm.nd.array(a_np)
+        d = tvm.nd.array(np.zeros((512,), "float32"))
+        lib(a, d)
+        expected = a_np * 2 + 1
+        tvm.testing.assert_allclose(d.numpy(), expected[:512] - expected[512:], rtol=1e-5)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -14,7 +14,10 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import numpy as np
+
 import tvm
+import tvm.testing
 from tvm import te
 from tvm.script import tir as T
 import os
@@ -158,8 +161,108 @@ def test_unroll_local_access():
     tvm.ir.assert_structural_equal(after, Expected)
 
 
+def _collect_loops(stmt):
+    loops = []
+    tvm.tir.stmt_functor.post_order_visit(
+        stmt, lambda node: loops.append(node) if isinstance(node, tvm.tir.For) else None
+    )
+    return loops
+
+
+def test_unroll_cost_model_split():
+    @T.prim_func
+    def before(A: T.Buffer((64,), "float32"), B: T.Buffer((64,), "float32")):
+        for i in T.serial(64):
+            B[i] = A[i] * T.float32(2)
+
+    config = {"tir.UnrollLoop": {"auto_unroll_cost_model": True, "register_budget": 8}}
+    with tvm.transform.PassContext(config=config):
+        after = tvm.tir.transform.UnrollLoop()(tvm.IRModule.from_expr(before))["main"]
+
+    # Two live values per iteration fit four copies into the register budget.
+    loops = _collect_loops(after.body)
+    assert len(loops) == 1
+    assert loops[0].extent.value == 16
+    assert isinstance(loops[0].body, tvm.tir.SeqStmt)
+    assert len(loops[0].body) == 4
+
+
+def test_unroll_cost_model_disabled_by_default():
+    @T.prim_func
+    def before(A: T.Buffer((64,), "float32"), B: T.Buffer((64,), "float32")):
+        for i in T.serial(64):
+            B[i] = A[i] * T.float32(2)
+
+    after = tvm.tir.transform.UnrollLoop()(tvm.IRModule.from_expr(before))["main"]
+    tvm.ir.assert_structural_equal(after, before)
+
+
+def test_unroll_cost_model_interleave_reduction():
+    @T.prim_func
+    def before(A: T.Buffer((64,), "float32"), B: T.Buffer((1,), "float32")):
+        T.func_attr({"target": T.target("llvm")})
+        for k in T.serial(64):
+            B[0] = B[0] + A[k]
+
+    config = {"tir.UnrollLoop": {"auto_unroll_cost_model": True, "max_interleave": 4}}
+    with tvm.transform.PassContext(config=config):
+        after = tvm.tir.transform.UnrollLoop()(tvm.IRModule.from_expr(before))["main"]
+
+    allocs = []
+    tvm.tir.stmt_functor.post_order_visit(
+        after.body, lambda node: allocs.append(node) if isinstance(node, tvm.tir.Allocate) else None
+    )
+    assert len(allocs) == 1
+    assert allocs[0].extents[0].value == 4
+    loops = _collect_loops(after.body)
+    assert len(loops) == 1
+    assert loops[0].extent.value == 16
+    assert len(loops[0].body) == 4
+
+
+def test_unroll_cost_model_no_interleave_without_cpu_target():
+    @T.prim_func
+    def before(A: T.Buffer((64,), "float32"), B: T.Buffer((1,), "float32")):
+        for k in T.serial(64):
+            B[0] = B[0] + A[k]
+
+    config = {"tir.UnrollLoop": {"auto_unroll_cost_model": True}}
+    with tvm.transform.PassContext(config=config):
+        after = tvm.tir.transform.UnrollLoop()(tvm.IRModule.from_expr(before))["main"]
+
+    allocs = []
+    tvm.tir.stmt_functor.post_order_visit(
+        after.body, lambda node: allocs.append(node) if isinstance(node, tvm.tir.Allocate) else None
+    )
+    assert not allocs
+
+
+@tvm.testing.requires_llvm
+def test_unroll_cost_model_interleave_reduction_numeric():
+    @T.prim_func
+    def func(A: T.Buffer((128,), "float32"), B: T.Buffer((1,), "float32")):
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for k in T.serial(128):
+            B[0] = B[0] + A[k]
+
+    config = {"tir.UnrollLoop": {"auto_unroll_cost_model": True}}
+    with tvm.transform.PassContext(config=config):
+        lib = tvm.compile(func, target="llvm")
+
+    a_np = np.random.uniform(size=(128,)).astype("float32")
+    a = tvm.nd.array(a_np)
+    b = tvm.nd.array(np.ones((1,), "float32"))
+    lib(a, b)
+    tvm.testing.assert_allclose(b.numpy(), [1 + a_np.sum()], rtol=1e-5)
+
+
 if __name__ == "__main__":
     test_unroll_local_access()
     test_unroll_loop()
     test_unroll_fake_loop()
     test_unroll_allocations()
+    test_unroll_cost_model_split()
+    test_unroll_cost_model_disabled_by_default()
+    test_unroll_cost_model_interleave_reduction()
+    test_unroll_cost_model_no_interleave_without_cpu_target()
+    test_unroll_cost_model_interleave_reduction_numeric()
@@ -14,6 +14,7 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import numpy as np
 import pytest
 
 import tvm
@@ -829,5 +830,116 @@ def test_vectorize_llvm_pure_intrin_fail(extent, vec_str, target):
     assert "Intrinsic does not support vectors" in e_info.value.args[0]
 
 
+def _collect_predicated_tail(func):
+    """Return (num_if_then_else, num_predicated_accesses) in func."""
+    counts = {"if": 0, "predicated": 0}
+
+    def fvisit(node):
+        if isinstance(node, tvm.tir.IfThenElse):
+            counts["if"] += 1
+        elif isinstance(node, (tvm.tir.BufferLoad, tvm.tir.BufferStore)):
+            if node.predicate is not None:
+                counts["predicated"] += 1
+
+    tvm.tir.stmt_functor.post_order_visit(func.body, fvisit)
+    return counts["if"], counts["predicated"]
+
+
+def test_vectorize_predicated_tail():
+    @T.prim_func
+    def before(a: T.handle, b: T.handle):
+        A = T.match_buffer(a, (16,), "float32")
+        B = T.match_buffer(b, (16,), "float32")
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i_0 in T.serial(T.ceildiv(14, 4)):
+            for i_1 in T.vectorized(4):
+                if i_0 * 4 + i_1 < 14:
+                    B[i_0 * 4 + i_1] = A[i_0 * 4 + i_1 + 1] + 1.0
+
+    mod = tvm.IRModule.from_expr(before)
+    with tvm.transform.PassContext(config={"tir.vectorize_predicated_tail": True}):
+        with simple_target:
+            after = tvm.tir.transform.VectorizeLoop()(mod)["main"]
+
+    # Unmasked main body plus a masked tail guarded by a scalar condition.
+    num_if, num_predicated = _collect_predicated_tail(after)
+    assert num_if == 1
+    assert num_predicated == 2
+    branch = after.body.body
+    assert isinstance(branch, tvm.tir.IfThenElse)
+    assert branch.condition.dtype == "bool"
+    assert branch.then_case.predicate is None
+    assert branch.else_case.predicate is not None
+
+
+def test_vectorize_predicated_tail_scalar_fallback():
+    # A[i_0] cannot be masked, so only the tail is scalarized.
+    @T.prim_func
+    def before(a: T.handle, b: T.handle):
+        A = T.match_buffer(a, (16,), "float32")
+        B = T.match_buffer(b, (16,), "float32")
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i_0 in T.serial(T.ceildiv(14, 4)):
+            for i_1 in T.vectorized(4):
+                if i_0 * 4 + i_1 < 14:
+                    B[i_0 * 4 + i_1] = A[i_0] + 1.0
+
+    mod = tvm.IRModule.from_expr(before)
+    with tvm.transform.PassContext(config={"tir.vectorize_predicated_tail": True}):
+        with simple_target:
+            after = tvm.tir.transform.VectorizeLoop()(mod)["main"]
+
+    branch = after.body.body
+    assert isinstance(branch, tvm.tir.IfThenElse)
+    assert branch.then_case.value.dtype == "float32x4"
+    assert isinstance(branch.else_case, tvm.tir.For)
+    assert branch.else_case.kind == tvm.tir.ForKind.SERIAL
+
+
+@tvm.testing.requires_llvm
+@pytest.mark.parametrize("n", [1, 7, 14, 16, 29])
+def test_vectorize_predicated_tail_dynamic_shape(n):
+    @T.prim_func
+    def elemwise(a: T.handle, b: T.handle):
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        m = T.int32()
+        A = T.match_buffer(a, (m + 1,), "float32")
+        B = T.match_buffer(b, (m,), "float32")
+        for i_0 in T.serial(T.ceildiv(m, 8)):
+            for i_1 in T.vectorized(8):
+                if i_0 * 8 + i_1 < m:
+                    B[i_0 * 8 + i_1] = A[i_0 * 8 + i_1] + A[i_0 * 8 + i_1 + 1]
+
+    @T.prim_func
+    def row_sum(a: T.handle, b: T.handle):
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        m = T.int32()
+        A = T.match_buffer(a, (m, 5), "float32")
+        B = T.match_buffer(b, (m,), "float32")
+        for i_0 in T.serial(T.ceildiv(m, 4)):
+            for i_1 in T.vectorized(4):
+                if i_0 * 4 + i_1 < m:
+                    B[i_0 * 4 + i_1] = T.float32(0)
+            for k in range(5):
+                for i_1 in T.vectorized(4):
+                    if i_0 * 4 + i_1 < m:
+                        B[i_0 * 4 + i_1] = B[i_0 * 4 + i_1] + A[i_0 * 4 + i_1, k]
+
+    dev = tvm.cpu()
+    with tvm.transform.PassContext(config={"tir.vectorize_predicated_tail": True}):
+        f_elemwise = tvm.compile(elemwise, target="llvm")
+        f_row_sum = tvm.compile(row_sum, target="llvm")
+
+    a_np = np.random.uniform(size=(n + 1,)).astype("float32")
+    b = tvm.nd.empty((n,), "float32", dev)
+    f_elemwise(tvm.nd.array(a_np, dev), b)
+    tvm.testing.assert_allclose(b.numpy(), a_np[:-1] + a_np[1:], rtol=1e-6)
+
+    a_np = np.random.uniform(size=(n, 5)).astype("float32")
+    b = tvm.nd.empty((n,), "float32", dev)
+    f_row_sum(tvm.nd.array(a_np, dev), b)
+    tvm.testing.assert_allclose(b.numpy(), a_np.sum(axis=1), rtol=1e-5)
+
+
 if __name__ == "__main__":
     tvm.testing.main()